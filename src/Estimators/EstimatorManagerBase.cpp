@@ -55,18 +55,18 @@ enum {COLLECT=0,
 //initialize the name of the primary estimator
 EstimatorManagerBase::EstimatorManagerBase(Communicate* c)
   : RecordCount(0),h_file(-1), FieldWidth(20)
-  , MainEstimatorName("LocalEnergy"), Archive(0), DebugArchive(0)
+  , MainEstimatorName("LocalEnergy"), Archive(0), DebugArchive(0), Writer(0)
   , myComm(0), MainEstimator(0), Collectables(0)
-  , max4ascii(8)
+  , max4ascii(8), ReducePending(false)
 {
   setCommunicator(c);
 }
 
 EstimatorManagerBase::EstimatorManagerBase(EstimatorManagerBase& em)
   : RecordCount(0),h_file(-1), FieldWidth(20)
-  , MainEstimatorName(em.MainEstimatorName), Options(em.Options), Archive(0), DebugArchive(0)
+  , MainEstimatorName(em.MainEstimatorName), Options(em.Options), Archive(0), DebugArchive(0), Writer(0)
   , myComm(0), MainEstimator(0), Collectables(0)
-  , EstimatorMap(em.EstimatorMap), max4ascii(em.max4ascii)
+  , EstimatorMap(em.EstimatorMap), max4ascii(em.max4ascii), ReducePending(false)
 {
   //inherit communicator
   setCommunicator(em.myComm);
@@ -79,6 +79,7 @@ EstimatorManagerBase::EstimatorManagerBase(EstimatorManagerBase& em)
 
 EstimatorManagerBase::~EstimatorManagerBase()
 {
+  delete Writer;
   delete_iter(Estimators.begin(), Estimators.end());
   delete_iter(RemoteData.begin(), RemoteData.end());
   delete_iter(h5desc.begin(), h5desc.end());
@@ -190,6 +191,10 @@ void EstimatorManagerBase::start(int blocks, bool record)
   Options.set(RECORD,record&&Options[MANAGE]);
   if(Options[RECORD])
   {
+    if(Writer)
+      Writer->flush();
+    else
+      Writer = new AsyncTaskQueue;
     if(Archive)
       delete Archive;
     std::string fname(myComm->getName());
@@ -242,6 +247,10 @@ void EstimatorManagerBase::stop(const std::vector<EstimatorManagerBase*> est)
  */
 void EstimatorManagerBase::stop()
 {
+  flushBlockAverages();
+  //complete the writes before closing the files
+  delete Writer;
+  Writer=0;
   //close any open files
   if(Archive)
   {
@@ -282,78 +291,142 @@ void EstimatorManagerBase::stopBlock(RealType accept, bool collectall)
     collectBlockAverages(1);
 }
 
+/** take statistics of a block collected by the threads
+ * @param est estimator managers of the threads
+ *
+ * The caches of the threads are summed directly into the message buffer,
+ * which is reduced over the ranks while the next block runs.
+ */
 void EstimatorManagerBase::stopBlock(const std::vector<EstimatorManagerBase*>& est)
 {
-  //normalized it by the thread
+  //the buffer is in use until the reduction of the previous block completes
+  flushBlockAverages();
   int num_threads=est.size();
   RealType tnorm=1.0/num_threads;
-  AverageCache=est[0]->AverageCache;
-  for(int i=1; i<num_threads; i++)
-    AverageCache +=est[i]->AverageCache;
-  AverageCache *= tnorm;
-  SquaredAverageCache=est[0]->SquaredAverageCache;
-  for(int i=1; i<num_threads; i++)
-    SquaredAverageCache +=est[i]->SquaredAverageCache;
-  SquaredAverageCache *= tnorm;
-  PropertyCache=est[0]->PropertyCache;
-  for(int i=1; i<num_threads; i++)
-    PropertyCache+=est[i]->PropertyCache;
-  for(int i=1; i<PropertyCache.size(); i++)
-    PropertyCache[i] *= tnorm;
-  //for(int i=0; i<num_threads; ++i)
-  //varAccumulator(est[i]->varAccumulator.mean());
-  collectBlockAverages(num_threads);
+  int n1=AverageCache.size();
+  int n2=n1+AverageCache.size();
+  int n3=n2+PropertyCache.size();
+  RealType* restrict buf=RemoteData[0]->data();
+  std::fill(buf,buf+n3,RealType(0));
+  for(int ip=0; ip<num_threads; ip++)
+  {
+    const RealType* restrict avg=est[ip]->AverageCache.data();
+    const RealType* restrict sq=est[ip]->SquaredAverageCache.data();
+    const RealType* restrict prop=est[ip]->PropertyCache.data();
+    for(int i=0; i<n1; i++)
+      buf[i]+=avg[i];
+    for(int i=0; i<n1; i++)
+      buf[n1+i]+=sq[i];
+    for(int i=0; i<n3-n2; i++)
+      buf[n2+i]+=prop[i];
+  }
+  //do not weight weightInd
+  for(int i=0; i<n3; i++)
+    if(i!=n2+weightInd)
+      buf[i]*=tnorm;
+  postBlockAverages();
 }
 
 
 void EstimatorManagerBase::collectBlockAverages(int num_threads)
+{
+  flushBlockAverages();
+  int n1=AverageCache.size();
+  int n2=n1+AverageCache.size();
+  BufferType::iterator cur(RemoteData[0]->begin());
+  copy(AverageCache.begin(),AverageCache.end(),cur);
+  copy(SquaredAverageCache.begin(),SquaredAverageCache.end(),cur+n1);
+  copy(PropertyCache.begin(),PropertyCache.end(),cur+n2);
+  postBlockAverages();
+}
+
+/** start the collection of a block
+ *
+ * With COLLECT, a non-blocking reduction of RemoteData[0] to RemoteData[1] is
+ * posted and the block is recorded by flushBlockAverages, at the latest when
+ * the next block is stopped. The ranks are not synchronized at every block.
+ */
+void EstimatorManagerBase::postBlockAverages()
 {
   if(Options[COLLECT])
   {
-    //copy cached data to RemoteData[0]
-    int n1=AverageCache.size();
-    int n2=n1+AverageCache.size();
-    int n3=n2+PropertyCache.size();
-    {
-      BufferType::iterator cur(RemoteData[0]->begin());
-      copy(AverageCache.begin(),AverageCache.end(),cur);
-      copy(SquaredAverageCache.begin(),SquaredAverageCache.end(),cur+n1);
-      copy(PropertyCache.begin(),PropertyCache.end(),cur+n2);
-    }
-    myComm->reduce(*RemoteData[0]);
-    if(Options[MANAGE])
-    {
-      BufferType::iterator cur(RemoteData[0]->begin());
-      copy(cur,cur+n1, AverageCache.begin());
-      copy(cur+n1,cur+n2, SquaredAverageCache.begin());
-      copy(cur+n2,cur+n3, PropertyCache.begin());
-      RealType nth=1.0/static_cast<RealType>(myComm->size());
-      AverageCache *= nth;
-      SquaredAverageCache *= nth;
-      //do not weight weightInd
-      for(int i=1; i<PropertyCache.size(); i++)
-        PropertyCache[i] *= nth;
-    }
+    ReduceRequest=myComm->ireduce(*RemoteData[0],*RemoteData[1]);
+    ReducePending=true;
   }
+  else
+    recordBlockAverages(*RemoteData[0]);
+}
+
+void EstimatorManagerBase::flushBlockAverages()
+{
+  if(!ReducePending)
+    return;
+  wait_all(1,&ReduceRequest);
+  ReducePending=false;
+  if(Options[MANAGE])
+  {
+    BufferType& buf(*RemoteData[1]);
+    int n2=2*AverageCache.size();
+    RealType nth=1.0/static_cast<RealType>(myComm->size());
+    //do not weight weightInd
+    for(int i=0; i<buf.size(); i++)
+      if(i!=n2+weightInd)
+        buf[i]*=nth;
+    recordBlockAverages(buf);
+  }
+  else
+    recordBlockAverages(*RemoteData[0]);
+}
+
+/** record a block
+ * @param buf packed block averages
+ *
+ * The files are written by Writer so that a slow file system does not
+ * stall the run at every block. The queue of Writer is bounded and holds
+ * copies of buf. HDF5 is called from the thread only if the library is
+ * thread-safe.
+ */
+void EstimatorManagerBase::recordBlockAverages(const BufferType& buf)
+{
+  int n1=AverageCache.size();
   //add the block average to summarize
-  energyAccumulator(AverageCache[0]);
-  varAccumulator(SquaredAverageCache[0]-AverageCache[0]*AverageCache[0]);
+  energyAccumulator(buf[0]);
+  varAccumulator(buf[n1]-buf[0]*buf[0]);
   if(Archive)
   {
-    *Archive << std::setw(10) << RecordCount;
-    int maxobjs=std::min(BlockAverages.size(),max4ascii);
-    for(int j=0; j<maxobjs; j++)
-      *Archive << std::setw(FieldWidth) << AverageCache[j];
-    for(int j=0; j<PropertyCache.size(); j++)
-      *Archive << std::setw(FieldWidth) << PropertyCache[j];
-    *Archive << std::endl;
-    for(int o=0; o<h5desc.size(); ++o)
-      h5desc[o]->write(AverageCache.data(),SquaredAverageCache.data());
-    H5Fflush(h_file,H5F_SCOPE_LOCAL);
+    int record=RecordCount;
+#if defined(H5_HAVE_THREADSAFE)
+    Writer->push([this,record,buf] { writeScalars(record,buf); writeObservables(buf); });
+#else
+    writeObservables(buf);
+    Writer->push([this,record,buf] { writeScalars(record,buf); });
+#endif
   }
   RecordCount++;
 }
 
+void EstimatorManagerBase::writeScalars(int record, const BufferType& buf)
+{
+  const RealType* avg=buf.data();
+  const RealType* prop=avg+2*AverageCache.size();
+  *Archive << std::setw(10) << record;
+  int maxobjs=std::min(BlockAverages.size(),max4ascii);
+  for(int j=0; j<maxobjs; j++)
+    *Archive << std::setw(FieldWidth) << avg[j];
+  for(int j=0; j<PropertyCache.size(); j++)
+    *Archive << std::setw(FieldWidth) << prop[j];
+  *Archive << std::endl;
+}
+
+void EstimatorManagerBase::writeObservables(const BufferType& buf)
+{
+  const RealType* avg=buf.data();
+  const RealType* sq=avg+AverageCache.size();
+  for(int o=0; o<h5desc.size(); ++o)
+    h5desc[o]->write(avg,sq);
+  H5Fflush(h_file,H5F_SCOPE_LOCAL);
+}
+
 /** accumulate Local energies and collectables
  * @param W ensemble
  */
@@ -380,6 +453,7 @@ void EstimatorManagerBase::accumulate(MCWalkerConfiguration& W
 
 void EstimatorManagerBase::getEnergyAndWeight(RealType& e, RealType& w, RealType& var)
 {
+  flushBlockAverages();
   if(Options[COLLECT])//need to broadcast the value
   {
     RealType tmp[3];
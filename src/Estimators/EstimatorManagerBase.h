@@ -26,6 +26,7 @@
 #include "Configuration.h"
 #include "Utilities/Timer.h"
 #include "Utilities/PooledData.h"
+#include "Utilities/AsyncTaskQueue.h"
 #include "Message/Communicate.h"
 #include "Estimators/ScalarEstimatorBase.h"
 #include "OhmmsPETE/OhmmsVector.h"
@@ -257,6 +258,8 @@ protected:
   std::ofstream* Archive;
   ///file handler to write data for debugging
   std::ofstream* DebugArchive;
+  ///thread writing Archive and h5desc while recording
+  AsyncTaskQueue* Writer;
   ///communicator to handle communication
   Communicate* myComm;
   /** pointer to the primary ScalarEstimatorBase
@@ -303,10 +306,29 @@ protected:
 private:
   ///number of maximum data for a scalar.dat
   int max4ascii;
-  //Data for communication
+  /** data for communication
+   *
+   * RemoteData[0] holds the block averages of this rank packed as
+   * [AverageCache|SquaredAverageCache|PropertyCache] and RemoteData[1]
+   * receives their sum over the ranks.
+   */
   std::vector<BufferType*> RemoteData;
-  ///collect data and write
+  ///request of the reduction in flight
+  Communicate::request ReduceRequest;
+  ///true if the reduction of the previous block has not been recorded
+  bool ReducePending;
+  ///pack the caches into RemoteData[0] and collect
   void collectBlockAverages(int num_threads);
+  ///start the reduction of RemoteData[0] or record it when not collecting
+  void postBlockAverages();
+  ///complete the pending reduction and record it
+  void flushBlockAverages();
+  ///update the accumulators and queue the writes of the packed block averages buf
+  void recordBlockAverages(const BufferType& buf);
+  ///write a line of scalar.dat
+  void writeScalars(int record, const BufferType& buf);
+  ///write the observables to stat.h5
+  void writeObservables(const BufferType& buf);
   ///add header to an std::ostream
   void addHeader(std::ostream& o);
   size_t FieldWidth;
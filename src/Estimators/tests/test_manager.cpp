@@ -18,10 +18,13 @@
 #include "QMCHamiltonians/QMCHamiltonian.h"
 #include "Estimators/EstimatorManagerBase.h"
 #include "Estimators/ScalarEstimatorBase.h"
+#include "Estimators/LocalEnergyOnlyEstimator.h"
 
 
 #include <stdio.h>
 #include <sstream>
+#include <fstream>
+#include <cstdio>
 
 namespace qmcplusplus
 {
@@ -70,4 +73,79 @@ TEST_CASE("EstimatorManagerBase", "[estimators]")
 
 }
 
+/// manager of a thread with settable block averages
+class FakeEstimatorManager : public EstimatorManagerBase
+{
+public:
+  FakeEstimatorManager(Communicate* c) : EstimatorManagerBase(c) {}
+  FakeEstimatorManager(FakeEstimatorManager& em) : EstimatorManagerBase(em) {}
+
+  void setBlock(RealType e, RealType e2, RealType w)
+  {
+    AverageCache[0]=e;
+    SquaredAverageCache[0]=e2;
+    PropertyCache[weightInd]=w;
+  }
+};
+
+TEST_CASE("EstimatorManagerBase threads", "[estimators]")
+{
+  OHMMS::Controller->initialize(0, NULL);
+  Communicate *c = OHMMS::Controller;
+  typedef EstimatorManagerBase::RealType RealType;
+
+  const std::string name(c->getName());
+  c->setName("manager_threads");
+  FakeEstimatorManager em(c);
+  em.add(new LocalEnergyOnlyEstimator(), "LocalEnergy");
+  em.start(2, true);
+
+  std::vector<FakeEstimatorManager*> fakes;
+  std::vector<EstimatorManagerBase*> threads;
+  for(int ip=0; ip<2; ip++)
+  {
+    fakes.push_back(new FakeEstimatorManager(em));
+    fakes[ip]->start(2, false);
+    threads.push_back(fakes[ip]);
+  }
+
+  // the blocks are the averages over the threads, the weights are summed
+  fakes[0]->setBlock(1.0, 2.0, 10.0);
+  fakes[1]->setBlock(3.0, 10.0, 20.0);
+  em.stopBlock(threads);
+  fakes[0]->setBlock(5.0, 26.0, 10.0);
+  fakes[1]->setBlock(7.0, 50.0, 20.0);
+  em.stopBlock(threads);
+
+  RealType e, w, var;
+  em.getEnergyAndWeight(e, w, var);
+  // sum of the block energies 2 and 6 over two blocks, each of variance 2
+  REQUIRE(e == Approx(8.0));
+  REQUIRE(w == Approx(2.0));
+  REQUIRE(var == Approx(2.0));
+
+  // the blocks written by the output thread are complete after stop
+  em.stop();
+  for(int ip=0; ip<2; ip++)
+    delete fakes[ip];
+  std::ifstream fin("manager_threads.scalar.dat");
+  std::string header;
+  std::getline(fin, header);
+  REQUIRE(header[0] == '#');
+  for(int ib=0; ib<2; ib++)
+  {
+    int index;
+    RealType energy;
+    fin >> index >> energy;
+    std::getline(fin, header);
+    REQUIRE(index == ib);
+    REQUIRE(energy == Approx(2.0+4.0*ib));
+  }
+  REQUIRE(fin.good());
+  fin.close();
+  std::remove("manager_threads.scalar.dat");
+  std::remove("manager_threads.stat.h5");
+  c->setName(name);
+}
+
 }
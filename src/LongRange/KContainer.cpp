@@ -18,11 +18,36 @@
 #include "Message/Communicate.h"
 #include "LongRange/KContainer.h"
 #include <qmc_common.h>
-#include <map>
+#include <unordered_map>
+#include <algorithm>
 
 namespace qmcplusplus
 {
 
+namespace
+{
+/** integer range [first,last] of x containing every |p+x g|^2 <= kc2
+ *
+ * The range is padded by one on each side and clamped to [-m,m], the vectors
+ * are tested exactly by the caller.
+ * @return false if the line p+x g does not enter the sphere
+ */
+template<typename PT, typename T>
+inline bool sphereRange(const PT& p, const PT& g, T kc2, int m, int& first, int& last)
+{
+  const T a=dot(g,g);
+  const T b=dot(p,g);
+  const T c=dot(p,p)-kc2;
+  T disc=b*b-a*c;
+  if(disc < -1e-8*(b*b+std::abs(a*c)))
+    return false;
+  disc=std::sqrt(std::max(disc,T(0)));
+  first=std::max(-m,static_cast<int>(std::floor((-b-disc)/a))-1);
+  last=std::min(m,static_cast<int>(std::ceil((-b+disc)/a))+1);
+  return first<=last;
+}
+}
+
 void
 KContainer::UpdateKLists(ParticleLayout_t& lattice, RealType kc, bool useSphere)
 {
@@ -114,17 +139,34 @@ KContainer::BuildKLists(ParticleLayout_t& lattice, bool useSphere)
   SContainer_t ksq_tmp;
   // reserve the space for memory efficiency
 #if OHMMS_DIM ==3
-  int numGuess=(2*mmax[0]+1)*(2*mmax[1]+1)*(2*mmax[2]+1);
   if(useSphere)
   {
-    //Loop over guesses for valid k-points.
+    //Generate the vectors in the sphere line by line, the range of the third
+    //index is solved for each (i,j) and the range of j for each i, so that
+    //the cost scales with the number of vectors rather than the box of mmax.
+    PosType g[3];
+    for(int idim=0; idim<3; idim++)
+    {
+      kvec=0;
+      kvec[idim]=1;
+      g[idim]=lattice.k_cart(kvec);
+    }
+    //components orthogonal to g[2] to find the range of j
+    const PosType g1perp=g[1]-(dot(g[1],g[2])/dot(g[2],g[2]))*g[2];
+    int jfirst, jlast, kfirst, klast;
     for(int i=-mmax[0]; i<=mmax[0]; i++)
     {
       kvec[0] = i;
-      for(int j=-mmax[1]; j<=mmax[1]; j++)
+      const PosType pi=static_cast<RealType>(i)*g[0];
+      const PosType piperp=pi-(dot(pi,g[2])/dot(g[2],g[2]))*g[2];
+      if(!sphereRange(piperp,g1perp,kcut2,mmax[1],jfirst,jlast))
+        continue;
+      for(int j=jfirst; j<=jlast; j++)
       {
         kvec[1] = j;
-        for(int k=-mmax[2]; k<=mmax[2]; k++)
+        if(!sphereRange(PosType(pi+static_cast<RealType>(j)*g[1]),g[2],kcut2,mmax[2],kfirst,klast))
+          continue;
+        for(int k=kfirst; k<=klast; k++)
         {
           kvec[2] = k;
           //Do not include k=0 in evaluations.
@@ -188,14 +230,23 @@ KContainer::BuildKLists(ParticleLayout_t& lattice, bool useSphere)
     TempActualMax[2] = mmax[2];
   }
 #elif OHMMS_DIM == 2
-  int numGuess=(2*mmax[0]+1)*(2*mmax[1]+1);
   if(useSphere)
   {
-    //Loop over guesses for valid k-points.
+    //Generate the vectors in the disk line by line, see the 3D case.
+    PosType g[2];
+    for(int idim=0; idim<2; idim++)
+    {
+      kvec=0;
+      kvec[idim]=1;
+      g[idim]=lattice.k_cart(kvec);
+    }
+    int jfirst, jlast;
     for(int i=-mmax[0]; i<=mmax[0]; i++)
     {
       kvec[0] = i;
-      for(int j=-mmax[1]; j<=mmax[1]; j++)
+      if(!sphereRange(PosType(static_cast<RealType>(i)*g[0]),g[1],kcut2,mmax[1],jfirst,jlast))
+        continue;
+      for(int j=jfirst; j<=jlast; j++)
       {
         kvec[1] = j;
         //Do not include k=0 in evaluations.
@@ -212,7 +263,7 @@ KContainer::BuildKLists(ParticleLayout_t& lattice, bool useSphere)
         kpts_cart_tmp.push_back(kvec_cart);
         ksq_tmp.push_back(modk2);
         //Update record of the allowed maximum translation.
-        for(int idim=0; idim<3; idim++)
+        for(int idim=0; idim<2; idim++)
           if(std::abs(kvec[idim]) > TempActualMax[idim])
             TempActualMax[idim] = std::abs(kvec[idim]);
       }
@@ -256,52 +307,26 @@ KContainer::BuildKLists(ParticleLayout_t& lattice, bool useSphere)
 #endif
   //Update a record of the number of k vectors
   numk = kpts_tmp.size();
-  std::map<int,std::vector<int>*>  kpts_sorted;
-//create the map: use simple integer with resolution of 0.001 in ksq
+  //Sort the vectors into shells: use simple integer with resolution of 0.001 in ksq,
+  //the vectors of a shell are kept in the order they are generated.
+  std::vector<std::pair<int,int> > kpts_sorted(numk);
   for(int ik=0; ik<numk; ik++)
-  {
-    int k_ind=static_cast<int>(ksq_tmp[ik]*1000);
-    std::map<int,std::vector<int>*>::iterator it(kpts_sorted.find(k_ind));
-    if(it == kpts_sorted.end())
-    {
-      std::vector<int>* newSet=new std::vector<int>;
-      kpts_sorted[k_ind]=newSet;
-      newSet->push_back(ik);
-    }
-    else
-    {
-      (*it).second->push_back(ik);
-    }
-  }
-  std::map<int,std::vector<int>*>::iterator it(kpts_sorted.begin());
+    kpts_sorted[ik]=std::make_pair(static_cast<int>(ksq_tmp[ik]*1000),ik);
+  std::sort(kpts_sorted.begin(),kpts_sorted.end());
   kpts.resize(numk);
   kpts_cart.resize(numk);
   ksq.resize(numk);
-  kshell.resize(kpts_sorted.size()+1,0);
-  int ok=0, ish=0;
-  while(it != kpts_sorted.end())
-  {
-    std::vector<int>::iterator vit((*it).second->begin());
-    while(vit != (*it).second->end())
-    {
-      int ik=(*vit);
-      kpts[ok]=kpts_tmp[ik];
-      kpts_cart[ok]=kpts_cart_tmp[ik];
-      ksq[ok]=ksq_tmp[ik];
-      ++vit;
-      ++ok;
-    }
-    kshell[ish+1]=kshell[ish]+(*it).second->size();
-    ++it;
-    ++ish;
-  }
-  it=kpts_sorted.begin();
-  std::map<int,std::vector<int>*>::iterator e_it(kpts_sorted.end());
-  while(it != e_it)
+  kshell.clear();
+  for(int ok=0; ok<numk; ok++)
   {
-    delete it->second;
-    it++;
+    if(ok==0 || kpts_sorted[ok].first!=kpts_sorted[ok-1].first)
+      kshell.push_back(ok);
+    const int ik=kpts_sorted[ok].second;
+    kpts[ok]=kpts_tmp[ik];
+    kpts_cart[ok]=kpts_cart_tmp[ik];
+    ksq[ok]=ksq_tmp[ik];
   }
+  kshell.push_back(numk);
   //Finished searching k-points. Copy list of maximum translations.
   mmax[DIM] = 0;
   for(int idim=0; idim<DIM; idim++)
@@ -313,7 +338,7 @@ KContainer::BuildKLists(ParticleLayout_t& lattice, bool useSphere)
   //Now fill the array that returns the index of -k when given the index of k.
   minusk.resize(numk);
   // Create a map from the hash value for each k vector to the index
-  std::map<int, int> hashToIndex;
+  std::unordered_map<long, int> hashToIndex(numk);
   for (int ki=0; ki<numk; ki++)
   {
     hashToIndex[GetHashOfVec(kpts[ki], numk)] = ki;
@@ -42,6 +42,18 @@ struct LRBreakup
   //We do this because the number of vectors is much larger than we'd
   //use elsewhere.
   void AddKToList(mRealType k, mRealType degeneracy=1.0);
+  /** add k to the list in increasing order
+   *
+   * Same as AddKToList but only the last entry is checked, k must not be
+   * smaller than the last |k| of the list.
+   */
+  inline void AppendKToList(mRealType k, mRealType degeneracy)
+  {
+    if(KList.size() && std::abs(k-KList.back()[0]) <= 1.0e-12)
+      KList.back()[1] += degeneracy;
+    else
+      KList.push_back(TinyVector<mRealType,2>(k,degeneracy));
+  }
 
   ///The basis to be used for breakup.
   BreakupBasis& Basis;
@@ -357,7 +369,7 @@ LRBreakup<BreakupBasis>::SetupKVecs(mRealType kc, mRealType kcont, mRealType kma
   size_t maxkshell=ks;
   size_t numk =kexact.numk-kexact.kshell[ks];
   for(; ks<kexact.kshell.size()-1; ks++)
-    AddKToList(std::sqrt(kexact.ksq[kexact.kshell[ks]]), kexact.kshell[ks+1]-kexact.kshell[ks]);
+    AppendKToList(std::sqrt(kexact.ksq[kexact.kshell[ks]]), kexact.kshell[ks+1]-kexact.kshell[ks]);
   ////Add these vectors to the internal list
   //int numk=0;
   //mRealType modk2;
@@ -382,7 +394,7 @@ LRBreakup<BreakupBasis>::SetupKVecs(mRealType kc, mRealType kcont, mRealType kma
     mRealType kmid = 0.5*(k1+k2);
     mRealType shellvol = 4.0*M_PI*(k2*k2*k2-k1*k1*k1)/3.0;
     mRealType degeneracy = shellvol/kelemvol;
-    AddKToList(kmid,degeneracy);
+    AppendKToList(kmid,degeneracy);
     numk += static_cast<int>(degeneracy);
   }
 #elif OHMMS_DIM==2
@@ -397,7 +409,7 @@ LRBreakup<BreakupBasis>::SetupKVecs(mRealType kc, mRealType kcont, mRealType kma
     mRealType kmid = 0.5*(k1+k2);
     mRealType shellvol = M_PI*(k2*k2-k1*k1);
     mRealType degeneracy = shellvol/kelemvol;
-    AddKToList(kmid,degeneracy);
+    AppendKToList(kmid,degeneracy);
     numk += static_cast<int>(degeneracy);
   }
 #endif
@@ -0,0 +1,113 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2018 Jeongnim Kim and QMCPACK developers.
+//
+// File developed by: Ye Luo, yeluo@anl.gov, Argonne National Laboratory
+//
+// File created by: Ye Luo, yeluo@anl.gov, Argonne National Laboratory
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "LongRange/LRBreakupCache.h"
+#include "io/hdf_archive.h"
+#include "Message/CommOperators.h"
+#include <qmc_common.h>
+#include <cstdint>
+#include <sstream>
+
+namespace qmcplusplus
+{
+
+namespace
+{
+/// 64-bit FNV-1a hash
+struct BreakupInputHash
+{
+  uint64_t h;
+  BreakupInputHash() : h(14695981039346656037ULL) {}
+  void add(const void* p, size_t n)
+  {
+    const unsigned char* c = static_cast<const unsigned char*>(p);
+    for (size_t i = 0; i < n; i++)
+    {
+      h ^= c[i];
+      h *= 1099511628211ULL;
+    }
+  }
+};
+}
+
+LRBreakupCache::LRBreakupCache(const std::string& name, const ParticleLayout_t& lattice,
+                               const std::vector<mRealType>& inputs)
+  : FileName(qmc_common.lr_breakup_cache)
+{
+  if(!enabled()) return;
+  BreakupInputHash hash;
+  hash.add(name.data(),name.size());
+  for(int i=0; i<OHMMS_DIM; i++)
+    for(int j=0; j<OHMMS_DIM; j++)
+    {
+      const double a=lattice.R(i,j);
+      hash.add(&a,sizeof(double));
+    }
+  hash.add(inputs.data(),inputs.size()*sizeof(mRealType));
+  std::ostringstream o;
+  o << name << "_" << std::hex << hash.h;
+  Key=o.str();
+}
+
+bool LRBreakupCache::get(int& maxkshell, std::vector<mRealType>& data)
+{
+  if(!enabled()) return false;
+  Communicate* comm=OHMMS::Controller;
+  int found=0;
+  if(comm->rank()==0)
+  {
+    hdf_archive h5f;
+    if(h5f.open(FileName,H5F_ACC_RDONLY) && h5f.is_group(Key))
+    {
+      h5f.push(Key,false);
+      std::vector<mRealType> cached;
+      int complete=0;
+      found = h5f.read(complete,"complete") && complete;
+      found = found && h5f.read(maxkshell,"max_kshell");
+      found = found && h5f.read(cached,"coefs") && (cached.size()==data.size());
+      if(found)
+        data=cached;
+    }
+    h5f.close();
+  }
+  comm->bcast(found);
+  if(found)
+  {
+    comm->bcast(maxkshell);
+    comm->bcast(data);
+    app_log() << "  Use the cached breakup " << Key << " in " << FileName << std::endl;
+  }
+  return found;
+}
+
+void LRBreakupCache::put(int maxkshell, std::vector<mRealType>& data)
+{
+  if(!enabled() || OHMMS::Controller->rank()!=0) return;
+  hdf_archive h5f;
+  if(!(h5f.open(FileName,H5F_ACC_RDWR) || h5f.create(FileName)))
+  {
+    app_warning() << "  Cannot write the breakup cache " << FileName << std::endl;
+    return;
+  }
+  if(h5f.is_group(Key))
+    h5f.unlink(Key);
+  h5f.push(Key,true);
+  h5f.write(maxkshell,"max_kshell");
+  h5f.write(data,"coefs");
+  // the flag is written last, an incomplete entry never matches
+  int complete=1;
+  h5f.write(complete,"complete");
+  h5f.close();
+  app_log() << "  Save the breakup " << Key << " in " << FileName << std::endl;
+}
+
+}
@@ -0,0 +1,81 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2018 Jeongnim Kim and QMCPACK developers.
+//
+// File developed by: Ye Luo, yeluo@anl.gov, Argonne National Laboratory
+//
+// File created by: Ye Luo, yeluo@anl.gov, Argonne National Laboratory
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** @file LRBreakupCache.h
+ * @brief HDF5 cache of the optimized breakups
+ */
+#ifndef QMCPLUSPLUS_LRBREAKUP_CACHE_H
+#define QMCPLUSPLUS_LRBREAKUP_CACHE_H
+
+#include "coulomb_types.h"
+#include "Particle/ParticleSet.h"
+#include <string>
+#include <vector>
+
+namespace qmcplusplus
+{
+
+/** cache of the results of LRBreakup in qmc_common.lr_breakup_cache
+ *
+ * Each breakup has its own group in the file, named by a hash of the lattice,
+ * the cutoffs and basis parameters and the function to be broken up sampled on
+ * a few |k|. A group holds the maximum k-shell of the exact k-vectors within kc
+ * and the coefficients, so that a hit skips both the enumeration of the k-shells
+ * and the least-squares solve. The root reads and writes the file and
+ * broadcasts the result, all the ranks must call get and put together.
+ * The cache is disabled when qmc_common.lr_breakup_cache is empty.
+ */
+class LRBreakupCache
+{
+public:
+  DECLARE_COULOMB_TYPES
+  typedef ParticleSet::ParticleLayout_t ParticleLayout_t;
+
+  /** constructor
+   * @param name name of the breakup handler
+   * @param lattice supercell
+   * @param inputs cutoffs, basis parameters and the function on probe |k|
+   */
+  LRBreakupCache(const std::string& name, const ParticleLayout_t& lattice, const std::vector<mRealType>& inputs);
+
+  ///return true if the cache is used
+  inline bool enabled() const
+  {
+    return !FileName.empty();
+  }
+
+  ///return the name of the group of this breakup
+  inline const std::string& key() const
+  {
+    return Key;
+  }
+
+  /** read a cached breakup
+   * @param maxkshell maximum k-shell
+   * @param data coefficients, the size must match the cached ones
+   * @return true if found
+   */
+  bool get(int& maxkshell, std::vector<mRealType>& data);
+
+  /** save a breakup
+   * @param maxkshell maximum k-shell
+   * @param data coefficients
+   */
+  void put(int maxkshell, std::vector<mRealType>& data);
+
+private:
+  std::string FileName;
+  std::string Key;
+};
+
+}
+#endif
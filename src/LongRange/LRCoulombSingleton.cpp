@@ -27,6 +27,9 @@
 #elif OHMMS_DIM==2
 #include "LongRange/TwoDEwaldHandler.h"
 #endif
+#if OHMMS_DIM==3 && defined(HAVE_LIBFFTW)
+#include "LongRange/LRHandlerPME.h"
+#endif
 #include <numeric>
 namespace qmcplusplus
 {
@@ -247,6 +250,25 @@ LRCoulombSingleton::getDerivHandler(ParticleSet& ref)
   }
 }
 
+LRCoulombSingleton::LRHandlerType*
+LRCoulombSingleton::getMeshHandler(ParticleSet& ref)
+{
+#if OHMMS_DIM==3 && defined(HAVE_LIBFFTW)
+  if(ref.SK->SuperCellEnum == SUPERCELL_SLAB)
+    APP_ABORT("LRCoulombSingleton::getMeshHandler the particle-mesh evaluation is not implemented for the slab");
+  //the handler returned by getHandler is a clone except for the first call
+  LRHandlerType* base=getHandler(ref);
+  LRHandlerPME* aLR=new LRHandlerPME(ref,base,8,base!=CoulombHandler);
+  const TinyVector<int,OHMMS_DIM>& mesh=aLR->getMeshSize();
+  app_log() << "  Long-range sums on a " << mesh[0] << "x" << mesh[1] << "x" << mesh[2]
+            << " particle mesh" << std::endl;
+  return aLR;
+#else
+  APP_ABORT("LRCoulombSingleton::getMeshHandler requires FFTW and a 3D build");
+  return 0;
+#endif
+}
+
 template<typename T>
 OneDimCubicSpline<T>*  
 createSpline4RbyVs_temp(LRHandlerBase* aLR, T rcut, LinearGrid<T>* agrid)
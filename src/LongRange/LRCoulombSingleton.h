@@ -25,6 +25,7 @@
 #include <config.h>
 #include "LongRange/LRHandlerTemp.h"
 #include "LongRange/LRHandlerSRCoulomb.h"
+#include "LongRange/SRPotentialTable.h"
 #include "Numerics/OneDimGridBase.h"
 #include "Numerics/OneDimGridFunctor.h"
 #include "Numerics/OneDimCubicSpline.h"
@@ -41,6 +42,7 @@ struct LRCoulombSingleton
   typedef LRHandlerBase                LRHandlerType;
   typedef LinearGrid<pRealType>        GridType;
   typedef OneDimCubicSpline<pRealType> RadFunctorType;
+  typedef SRPotentialTable<pRealType>  SRTableType;
 
   ///Stores the energ optimized LR handler.
   static LRHandlerType* CoulombHandler;
@@ -50,6 +52,12 @@ struct LRCoulombSingleton
   static LRHandlerType* getHandler(ParticleSet& ref);
   ///This returns a force/stress optimized LR handler.  If non existent, it creates one.
   static LRHandlerType* getDerivHandler(ParticleSet& ref);
+  /** return a handler evaluating the long-range sums of getHandler on a particle mesh
+   *
+   * Every call creates a new LRHandlerPME, owned by the caller, see
+   * LRHandlerBase::evaluateMesh.
+   */
+  static LRHandlerType* getMeshHandler(ParticleSet& ref);
 
   //The following two helper functions are provided to spline the short-range component
   //of the coulomb potential and its derivative.  This is much faster than evaluating
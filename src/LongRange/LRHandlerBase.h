@@ -262,6 +262,39 @@ struct LRHandlerBase
     return 0.0;
   };
 
+  ///return true if evaluateMesh is implemented
+  virtual bool onMesh() const
+  {
+    return false;
+  }
+
+  /** work units of the long-range sum of an evaluation
+   * @param kshell k-vector shells of the structure factor
+   * @param num_particles particles of all the particle sets of the sum
+   * @param num_sets number of the particle sets, 1 for A-A and 2 for A-B
+   *
+   * The sum goes over the k-vectors of rhok.
+   */
+  virtual long evaluationWork(const std::vector<int>& kshell, int num_particles, int num_sets) const
+  {
+    return kshell[MaxKshell];
+  }
+
+  /** evaluate \f$\frac{1}{2}\sum_k F_k |\rho_{\bf k}|^2\f$ of the charges Z of P without the structure factor */
+  virtual mRealType evaluateMesh(const ParticleSet& P, const std::vector<pRealType>& Z)
+  {
+    APP_ABORT("Error: evaluateMesh is not implemented in "+ClassName+"\n");
+    return 0.0;
+  }
+
+  /** evaluate \f$\sum_k F_k \rho^A_{\bf k}\rho^B_{-\bf k}\f$ of the charges ZA of A and ZB of B without the structure factors */
+  virtual mRealType evaluateMesh(const ParticleSet& A, const std::vector<pRealType>& ZA,
+                                 const ParticleSet& B, const std::vector<pRealType>& ZB)
+  {
+    APP_ABORT("Error: evaluateMesh is not implemented in "+ClassName+"\n");
+    return 0.0;
+  }
+
   /** make clone */
   virtual LRHandlerBase* makeClone(ParticleSet& ref)=0;
   
@@ -0,0 +1,296 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2018 Jeongnim Kim and QMCPACK developers.
+//
+// File developed by: Ye Luo, yeluo@anl.gov, Argonne National Laboratory
+//
+// File created by: Ye Luo, yeluo@anl.gov, Argonne National Laboratory
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "LongRange/LRHandlerPME.h"
+#include <map>
+#include <cmath>
+
+namespace qmcplusplus
+{
+
+namespace
+{
+///largest order of the B-splines
+const int MaxOrder=12;
+
+///smallest n>=nmin whose prime factors are 2, 3 and 5
+int fftSize(int nmin)
+{
+  for(int n=std::max(nmin,1); ; n++)
+  {
+    int m=n;
+    while(m%2==0) m/=2;
+    while(m%3==0) m/=3;
+    while(m%5==0) m/=5;
+    if(m==1) return n;
+  }
+}
+
+/** cardinal B-spline of order p on p consecutive knots
+ * @param w offset in [0,1)
+ * @param c c[t]=\f$M_p(w+t)\f$ for t=0,...,p-1
+ */
+template<typename T>
+inline void bsplineWeights(int p, T w, T* restrict c)
+{
+  c[0]=w;
+  c[1]=T(1)-w;
+  for(int n=3; n<=p; n++)
+  {
+    const T s=T(1)/(n-1);
+    c[n-1]=(T(1)-w)*c[n-2]*s;
+    for(int t=n-2; t>0; t--)
+      c[t]=((w+t)*c[t]+(n-w-t)*c[t-1])*s;
+    c[0]=w*c[0]*s;
+  }
+}
+}
+
+LRHandlerPME::LRHandlerPME(ParticleSet& ref, LRHandlerBase* base, int order, bool own_base)
+  : LRHandlerBase(base->get_kc()), Base(base), Order(order), MeshSize(0), NumOutput(0)
+{
+  if(own_base)
+    OwnedBase.reset(base);
+  ClassName="LRHandlerPME";
+  allocate();
+  if(Order<4 || Order>MaxOrder || Order%2)
+    APP_ABORT("LRHandlerPME the order of the B-splines must be even and in [4,12]");
+  copyBreakup();
+  setupMesh(ref);
+}
+
+LRHandlerPME::LRHandlerPME(const LRHandlerPME& aLR)
+  : LRHandlerBase(aLR), Base(aLR.Base), Order(aLR.Order), MeshSize(aLR.MeshSize),
+    NumOutput(aLR.NumOutput), MeshIndex(aLR.MeshIndex), MeshWeight(aLR.MeshWeight)
+{
+  allocate();
+}
+
+LRHandlerPME::~LRHandlerPME()
+{
+  release();
+}
+
+LRHandlerBase* LRHandlerPME::makeClone(ParticleSet& ref)
+{
+  LRHandlerPME* aLR=new LRHandlerPME(*this);
+  aLR->Base=Base->makeClone(ref);
+  aLR->OwnedBase.reset(aLR->Base);
+  return aLR;
+}
+
+void LRHandlerPME::initBreakup(ParticleSet& ref)
+{
+  Base->initBreakup(ref);
+  copyBreakup();
+  setupMesh(ref);
+}
+
+void LRHandlerPME::Breakup(ParticleSet& ref, mRealType rs_in)
+{
+  Base->Breakup(ref,rs_in);
+  copyBreakup();
+  setupMesh(ref);
+}
+
+void LRHandlerPME::resetTargetParticleSet(ParticleSet& ref)
+{
+  Base->resetTargetParticleSet(ref);
+  copyBreakup();
+  setupMesh(ref);
+}
+
+void LRHandlerPME::copyBreakup()
+{
+  MaxKshell=Base->MaxKshell;
+  LR_kc=Base->LR_kc;
+  LR_rc=Base->LR_rc;
+  Fk=Base->Fk;
+  Fkg=Base->Fkg;
+  dFk_dstrain=Base->dFk_dstrain;
+  Fkgstrain=Base->Fkgstrain;
+  Fk_symm=Base->Fk_symm;
+  coefs=Base->coefs;
+  gcoefs=Base->gcoefs;
+  gstraincoefs=Base->gstraincoefs;
+}
+
+void LRHandlerPME::setupMesh(ParticleSet& ref)
+{
+  const KContainer& klists(ref.SK->KLists);
+  const int nk=klists.kshell[MaxKshell];
+  // the mesh resolves twice the largest index of the k-vectors
+  TinyVector<int,OHMMS_DIM> mmax(0), msize;
+  for(int ki=0; ki<nk; ki++)
+    for(int d=0; d<OHMMS_DIM; d++)
+      mmax[d]=std::max(mmax[d],std::abs(klists.kpts[ki][d]));
+  for(int d=0; d<OHMMS_DIM; d++)
+    msize[d]=fftSize(std::max(4*mmax[d]+2,Order));
+  if(msize[0]!=MeshSize[0] || msize[1]!=MeshSize[1] || msize[2]!=MeshSize[2])
+  {
+    release();
+    MeshSize=msize;
+    NumOutput=MeshSize[0]*MeshSize[1]*(MeshSize[2]/2+1);
+    allocate();
+  }
+  // 1/|b(m)|^2 along each direction
+  mRealType c[MaxOrder];
+  bsplineWeights(Order,mRealType(0),c);
+  std::vector<mRealType> bsq[OHMMS_DIM];
+  for(int d=0; d<OHMMS_DIM; d++)
+  {
+    const int n=MeshSize[d];
+    bsq[d].resize(n);
+    for(int m=0; m<n; m++)
+    {
+      mRealType re(0), im(0);
+      for(int j=0; j<Order-1; j++)
+      {
+        const mRealType phase=2*M_PI*m*j/n;
+        re+=c[j+1]*std::cos(phase);
+        im+=c[j+1]*std::sin(phase);
+      }
+      bsq[d][m]=mRealType(1)/(re*re+im*im);
+    }
+  }
+  // the transform of a real mesh holds half of the k-vectors, k and -k are merged
+  std::map<int,mRealType> weights;
+  for(int ks=0, ki=0; ks<MaxKshell; ks++)
+    for(; ki<klists.kshell[ks+1]; ki++)
+    {
+      TinyVector<int,OHMMS_DIM> m(klists.kpts[ki]);
+      if(m[2]<0 || (m[2]==0 && (m[1]<0 || (m[1]==0 && m[0]<0))))
+        m=TinyVector<int,OHMMS_DIM>(-m[0],-m[1],-m[2]);
+      const int i0=(m[0]+MeshSize[0])%MeshSize[0];
+      const int i1=(m[1]+MeshSize[1])%MeshSize[1];
+      const int idx=(i0*MeshSize[1]+i1)*(MeshSize[2]/2+1)+m[2];
+      weights[idx]+=Fk_symm[ks]*bsq[0][i0]*bsq[1][i1]*bsq[2][m[2]];
+    }
+  MeshIndex.clear();
+  MeshWeight.clear();
+  for(std::map<int,mRealType>::const_iterator it=weights.begin(); it!=weights.end(); ++it)
+  {
+    MeshIndex.push_back(it->first);
+    MeshWeight.push_back(it->second);
+  }
+}
+
+void LRHandlerPME::allocate()
+{
+  const int nr=MeshSize[0]*MeshSize[1]*MeshSize[2];
+  for(int m=0; m<2; m++)
+  {
+    Q[m]=nullptr;
+    QK[m]=nullptr;
+    Plan[m]=nullptr;
+  }
+  if(nr==0) return;
+  // the FFTW planner is not thread-safe
+  #pragma omp critical (fftw_planner)
+  {
+    for(int m=0; m<2; m++)
+    {
+      Q[m]=static_cast<double*>(fftw_malloc(sizeof(double)*nr));
+      QK[m]=static_cast<fftw_complex*>(fftw_malloc(sizeof(fftw_complex)*NumOutput));
+      Plan[m]=fftw_plan_dft_r2c_3d(MeshSize[0],MeshSize[1],MeshSize[2],Q[m],QK[m],FFTW_ESTIMATE);
+    }
+  }
+}
+
+void LRHandlerPME::release()
+{
+  #pragma omp critical (fftw_planner)
+  {
+    for(int m=0; m<2; m++)
+    {
+      if(Plan[m])
+        fftw_destroy_plan(Plan[m]);
+      fftw_free(Q[m]);
+      fftw_free(QK[m]);
+      Q[m]=nullptr;
+      QK[m]=nullptr;
+      Plan[m]=nullptr;
+    }
+  }
+}
+
+void LRHandlerPME::spread(const ParticleSet& P, const std::vector<pRealType>& Z, int m)
+{
+  const int n0=MeshSize[0], n1=MeshSize[1], n2=MeshSize[2];
+  double* restrict q=Q[m];
+  std::fill(q,q+n0*n1*n2,0.0);
+  mRealType c[OHMMS_DIM][MaxOrder];
+  int g[OHMMS_DIM][MaxOrder];
+  const int nptcl=P.getTotalNum();
+  for(int i=0; i<nptcl; i++)
+  {
+    if(Z[i]==0) continue;
+    const PosType s=P.LRBox.toUnit(P.R[i]);
+    for(int d=0; d<OHMMS_DIM; d++)
+    {
+      const mRealType u=(s[d]-std::floor(s[d]))*MeshSize[d];
+      int f=static_cast<int>(u);
+      const mRealType w=u-f;
+      if(f>=MeshSize[d]) f-=MeshSize[d];
+      bsplineWeights(Order,w,c[d]);
+      // M_p(u-g) is non-zero for g=f,f-1,...,f-p+1
+      for(int t=0; t<Order; t++)
+        g[d][t]=(f-t<0)? f-t+MeshSize[d]:f-t;
+    }
+    for(int t0=0; t0<Order; t0++)
+    {
+      const mRealType z0=Z[i]*c[0][t0];
+      for(int t1=0; t1<Order; t1++)
+      {
+        const mRealType z1=z0*c[1][t1];
+        double* restrict row=q+(g[0][t0]*n1+g[1][t1])*n2;
+        for(int t2=0; t2<Order; t2++)
+          row[g[2][t2]]+=z1*c[2][t2];
+      }
+    }
+  }
+  fftw_execute(Plan[m]);
+}
+
+LRHandlerPME::mRealType
+LRHandlerPME::evaluateMesh(const ParticleSet& P, const std::vector<pRealType>& Z)
+{
+  spread(P,Z,0);
+  const fftw_complex* restrict qk=QK[0];
+  mRealType res=0.0;
+  for(int i=0; i<MeshIndex.size(); i++)
+  {
+    const fftw_complex& a=qk[MeshIndex[i]];
+    res+=MeshWeight[i]*(a[0]*a[0]+a[1]*a[1]);
+  }
+  return 0.5*res;
+}
+
+LRHandlerPME::mRealType
+LRHandlerPME::evaluateMesh(const ParticleSet& A, const std::vector<pRealType>& ZA,
+                           const ParticleSet& B, const std::vector<pRealType>& ZB)
+{
+  spread(A,ZA,0);
+  spread(B,ZB,1);
+  const fftw_complex* restrict qa=QK[0];
+  const fftw_complex* restrict qb=QK[1];
+  mRealType res=0.0;
+  for(int i=0; i<MeshIndex.size(); i++)
+  {
+    const fftw_complex& a=qa[MeshIndex[i]];
+    const fftw_complex& b=qb[MeshIndex[i]];
+    res+=MeshWeight[i]*(a[0]*b[0]+a[1]*b[1]);
+  }
+  return res;
+}
+
+}
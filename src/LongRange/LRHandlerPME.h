@@ -0,0 +1,144 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2018 Jeongnim Kim and QMCPACK developers.
+//
+// File developed by: Ye Luo, yeluo@anl.gov, Argonne National Laboratory
+//
+// File created by: Ye Luo, yeluo@anl.gov, Argonne National Laboratory
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** @file LRHandlerPME.h
+ * @brief Particle-mesh evaluation of the long-range sums of a breakup
+ */
+#ifndef QMCPLUSPLUS_LRHANDLER_PME_H
+#define QMCPLUSPLUS_LRHANDLER_PME_H
+
+#include "LongRange/LRHandlerBase.h"
+#include <fftw3.h>
+#include <memory>
+
+namespace qmcplusplus
+{
+
+/** smooth particle-mesh Ewald evaluation of \f$\sum_k F_k \rho^A_{\bf k}\rho^B_{-\bf k}\f$
+ *
+ * The charges are spread on a regular mesh in the reduced coordinates of the
+ * supercell with cardinal B-splines of order Order and the mesh is transformed
+ * with FFTW. The structure factors of the k-vectors of the breakup are the
+ * transform divided by the B-spline factors b(k), see Essmann et al.,
+ * J. Chem. Phys. 103, 8577 (1995). The cost of a configuration is
+ * \f$N\times Order^3 + M\log M\f$ for a mesh of M points instead of
+ * \f$N\times N_k\f$ for the structure factor, which makes a difference in large cells.
+ *
+ * The short-range part, the constants and \f$F_k\f$ are those of the wrapped
+ * handler, to which all the other functions are delegated. The wrapped handler
+ * is owned only if own_base is set or it was created by makeClone. Only bulk
+ * supercells are supported.
+ */
+class LRHandlerPME: public LRHandlerBase
+{
+public:
+  /** constructor
+   * @param ref particle set with the structure factor of the breakup
+   * @param base handler of the breakup
+   * @param order order of the B-splines, even
+   * @param own_base if true, base is deleted with this handler
+   */
+  LRHandlerPME(ParticleSet& ref, LRHandlerBase* base, int order=8, bool own_base=false);
+
+  ///copy constructor allocates its own mesh and FFT plans, Base is shared
+  LRHandlerPME(const LRHandlerPME& aLR);
+
+  ~LRHandlerPME();
+
+  bool onMesh() const
+  {
+    return true;
+  }
+
+  ///spreading of every particle over Order^3 mesh points and one transform per particle set
+  long evaluationWork(const std::vector<int>& kshell, int num_particles, int num_sets) const
+  {
+    long mesh=1;
+    for(int d=0; d<OHMMS_DIM; d++)
+      mesh*=MeshSize[d];
+    return static_cast<long>(num_particles)*Order*Order*Order+num_sets*mesh;
+  }
+
+  mRealType evaluateMesh(const ParticleSet& P, const std::vector<pRealType>& Z);
+  mRealType evaluateMesh(const ParticleSet& A, const std::vector<pRealType>& ZA,
+                         const ParticleSet& B, const std::vector<pRealType>& ZB);
+
+  ///return the mesh dimensions
+  inline const TinyVector<int,OHMMS_DIM>& getMeshSize() const
+  {
+    return MeshSize;
+  }
+
+  void initBreakup(ParticleSet& ref);
+  void Breakup(ParticleSet& ref, mRealType rs_in);
+  void resetTargetParticleSet(ParticleSet& ref);
+
+  mRealType evaluate(mRealType r, mRealType rinv)
+  {
+    return Base->evaluate(r,rinv);
+  }
+  mRealType evaluateLR(mRealType r)
+  {
+    return Base->evaluateLR(r);
+  }
+  mRealType srDf(mRealType r, mRealType rinv)
+  {
+    return Base->srDf(r,rinv);
+  }
+  mRealType lrDf(mRealType r)
+  {
+    return Base->lrDf(r);
+  }
+  mRealType evaluateSR_k0()
+  {
+    return Base->evaluateSR_k0();
+  }
+  mRealType evaluateLR_r0()
+  {
+    return Base->evaluateLR_r0();
+  }
+
+  LRHandlerBase* makeClone(ParticleSet& ref);
+
+private:
+  ///wrapped handler
+  LRHandlerBase* Base;
+  ///Base if it is owned
+  std::unique_ptr<LRHandlerBase> OwnedBase;
+  ///order of the B-splines
+  int Order;
+  ///mesh dimensions
+  TinyVector<int,OHMMS_DIM> MeshSize;
+  ///number of complex values of the real-to-complex transform
+  int NumOutput;
+  ///charges on the mesh, one per particle set of evaluateMesh
+  double* Q[2];
+  ///transforms of Q
+  fftw_complex* QK[2];
+  fftw_plan Plan[2];
+  ///index in QK of the k-vectors, +k and -k share one entry
+  std::vector<int> MeshIndex;
+  ///\f$F_k|b({\bf k})|^2\f$ summed over the k-vectors of an entry
+  std::vector<mRealType> MeshWeight;
+
+  ///copy the breakup of Base
+  void copyBreakup();
+  ///choose the mesh and tabulate MeshIndex and MeshWeight
+  void setupMesh(ParticleSet& ref);
+  void allocate();
+  void release();
+  ///spread the charges Z of P on Q[m] and transform
+  void spread(const ParticleSet& P, const std::vector<pRealType>& Z, int m);
+};
+
+}
+#endif
@@ -23,6 +23,7 @@
 #include "LongRange/LRHandlerBase.h"
 #include "LongRange/LPQHISRCoulombBasis.h"
 #include "LongRange/LRBreakup.h"
+#include "LongRange/LRBreakupCache.h"
 #include "OhmmsPETE/OhmmsMatrix.h"
 #include "Numerics/OneDimGridBase.h"
 #include "Numerics/OneDimGridFunctor.h"
@@ -463,6 +464,24 @@ private:
     mRealType kcut = 60*M_PI*std::pow(Basis.get_CellVolume(),-1.0/3.0);
     //Use 3000/LMax here...==6000/rc for non-ortho cells
     mRealType kmax(6000.0/ref.LR_rc);
+    //The breakup is fixed by the cell, the cutoffs and the function
+    int Nbasis=Basis.NumBasisElem();
+    std::vector<mRealType> inputs={kc,kcut,kmax,Basis.get_rc(),static_cast<mRealType>(NumKnots)};
+    for(int ip=1; ip<=4; ip++)
+    {
+      inputs.push_back(myFunc.Vk(0.25*ip*kcut));
+      inputs.push_back(myFunc.dVk_dk(0.25*ip*kcut));
+    }
+    LRBreakupCache cache(ClassName,ref,inputs);
+    std::vector<mRealType> allcoefs(3*Nbasis);
+    if(cache.get(MaxKshell,allcoefs))
+    {
+      coefs.assign(allcoefs.begin(),allcoefs.begin()+Nbasis);
+      gcoefs.assign(allcoefs.begin()+Nbasis,allcoefs.begin()+2*Nbasis);
+      gstraincoefs.assign(allcoefs.begin()+2*Nbasis,allcoefs.end());
+      makeSplines(10001);
+      return;
+    }
     MaxKshell = static_cast<int>(breakuphandler.SetupKVecs(kc,kcut,kmax));
     if(FirstTime)
     {
@@ -479,7 +498,6 @@ private:
     //of V_l(r) after the breakup has been done.
     fillVk(breakuphandler.KList);
     //Allocate the space for the coefficients.
-    int Nbasis=Basis.NumBasisElem();
     coefs.resize(Nbasis); //This must be after SetupKVecs.
     gcoefs.resize(Nbasis);
     gstraincoefs.resize(Nbasis);
@@ -534,6 +552,10 @@ private:
     app_log()<<"         LR function chi^2 = "<<chisqr[0]<< std::endl;
     app_log()<<"    LR grad function chi^2 = "<<chisqr[1]<< std::endl;
     app_log()<<"  LR strain function chi^2 = "<<chisqr[2]<< std::endl;
+    std::copy(coefs.begin(),coefs.end(),allcoefs.begin());
+    std::copy(gcoefs.begin(),gcoefs.end(),allcoefs.begin()+Nbasis);
+    std::copy(gstraincoefs.begin(),gstraincoefs.end(),allcoefs.begin()+2*Nbasis);
+    cache.put(MaxKshell,allcoefs);
    // app_log()<<"  n  tn   gtn h(n)\n";
      
   //  myFunc.reset(ref);
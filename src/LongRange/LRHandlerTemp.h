@@ -27,6 +27,7 @@
 #include "LongRange/LRHandlerBase.h"
 #include "LongRange/LPQHIBasis.h"
 #include "LongRange/LRBreakup.h"
+#include "LongRange/LRBreakupCache.h"
 #include "OhmmsPETE/OhmmsMatrix.h"
 
 namespace qmcplusplus
@@ -226,6 +227,14 @@ private:
     mRealType kcut = 60*M_PI*std::pow(Basis.get_CellVolume(),-1.0/3.0);
     //Use 3000/LMax here...==6000/rc for non-ortho cells
     mRealType kmax(6000.0/ref.LR_rc);
+    //The breakup is fixed by the cell, the cutoffs and the function
+    std::vector<mRealType> inputs={kc,kcut,kmax,Basis.get_rc(),static_cast<mRealType>(NumKnots)};
+    for(int ip=1; ip<=4; ip++)
+      inputs.push_back(evalXk(0.25*ip*kcut));
+    LRBreakupCache cache(ClassName,ref,inputs);
+    coefs.resize(Basis.NumBasisElem());
+    if(cache.get(MaxKshell,coefs))
+      return;
     MaxKshell = static_cast<int>(breakuphandler.SetupKVecs(kc,kcut,kmax));
     if(FirstTime)
     {
@@ -246,6 +255,7 @@ private:
     mRealType chisqr(0.0);
     chisqr=breakuphandler.DoBreakup(Fk.data(),coefs.data()); //Fill array of coefficients.
     app_log()<<"\n   LR Breakup chi^2 = "<<chisqr<<std::endl;
+    cache.put(MaxKshell,coefs);
   }
 
   void fillXk(std::vector<TinyVector<mRealType,2> >& KList)
@@ -0,0 +1,178 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2018 Jeongnim Kim and QMCPACK developers.
+//
+// File developed by: Ye Luo, yeluo@anl.gov, Argonne National Laboratory
+//
+// File created by: Ye Luo, yeluo@anl.gov, Argonne National Laboratory
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** @file SRPotentialTable.h
+ * @brief Tabulated short-range potentials for the pair loops over the distance tables
+ */
+#ifndef QMCPLUSPLUS_SR_POTENTIAL_TABLE_H
+#define QMCPLUSPLUS_SR_POTENTIAL_TABLE_H
+
+#include <config.h>
+#include "Numerics/OneDimGridBase.h"
+#include "Numerics/OneDimCubicSpline.h"
+#include "simd/allocator.hpp"
+#include "Message/Communicate.h"
+#include <vector>
+
+namespace qmcplusplus
+{
+
+/** short-range potentials \f$rV_S(r)\f$ on uniform grids over [0,rcut)
+ *
+ * Each function is converted at setup from its OneDimCubicSpline into the
+ * power form \f$c_0+c_1t+c_2t^2+c_3t^3\f$ of every interval, with the four
+ * coefficients in separate aligned arrays. An evaluation is a direct index
+ * computation and does not modify the table, so that the loops over a row of
+ * a distance table can be vectorized and the table can be shared by threads.
+ * As OneDimCubicSpline::splint, the functions are constant for \f$r\ge r_{cut}\f$.
+ */
+template<typename T>
+struct SRPotentialTable
+{
+  struct Function
+  {
+    T Rcut;
+    T Delta;
+    T DeltaInv;
+    ///value for r>=Rcut
+    T Tail;
+    ///index of the last interval
+    int LastIndex;
+    aligned_vector<T> C0, C1, C2, C3;
+  };
+
+  std::vector<Function> Funcs;
+
+  ///number of functions
+  inline int size() const
+  {
+    return Funcs.size();
+  }
+
+  /** add a function
+   * @param f cubic spline of \f$rV_S(r)\f$ on a linear grid starting at 0
+   * @return the index of the function
+   */
+  int add(const OneDimCubicSpline<T>& f)
+  {
+    const OneDimGridBase<T>& agrid(*f.m_grid);
+    if(agrid.getGridTag()!=LINEAR_1DGRID || agrid.rmin()!=T(0))
+      APP_ABORT("SRPotentialTable::add requires a linear grid starting at 0");
+    Function a;
+    const int ng=agrid.size();
+    a.Rcut=f.r_max;
+    a.Delta=agrid.Delta;
+    a.DeltaInv=agrid.DeltaInv;
+    a.Tail=f.ConstValue;
+    a.LastIndex=ng-2;
+    a.C0.resize(ng-1);
+    a.C1.resize(ng-1);
+    a.C2.resize(ng-1);
+    a.C3.resize(ng-1);
+    const T h=agrid.Delta;
+    for(int i=0; i<ng-1; ++i)
+    {
+      const T y0=f.m_Y[i], y1=f.m_Y[i+1];
+      const T d0=f.m_Y2[i], d1=f.m_Y2[i+1];
+      a.C0[i]=y0;
+      a.C1[i]=(y1-y0)/h-h*(2*d0+d1)/6;
+      a.C2[i]=d0/2;
+      a.C3[i]=(d1-d0)/(6*h);
+    }
+    Funcs.push_back(a);
+    return Funcs.size()-1;
+  }
+
+  /** return \f$rV_S(r)\f$ of the ifunc-th function */
+  inline T evaluate(int ifunc, T r) const
+  {
+    const Function& a=Funcs[ifunc];
+    if(r>=a.Rcut) return a.Tail;
+    const int i=std::min(static_cast<int>(r*a.DeltaInv),a.LastIndex);
+    const T t=r-i*a.Delta;
+    return a.C0[i]+t*(a.C1[i]+t*(a.C2[i]+t*a.C3[i]));
+  }
+
+  /** return \f$rV_S(r)\f$ and its derivative du of the ifunc-th function */
+  inline T evaluate(int ifunc, T r, T& du) const
+  {
+    const Function& a=Funcs[ifunc];
+    if(r>=a.Rcut)
+    {
+      du=T(0);
+      return a.Tail;
+    }
+    const int i=std::min(static_cast<int>(r*a.DeltaInv),a.LastIndex);
+    const T t=r-i*a.Delta;
+    du=a.C1[i]+t*(2*a.C2[i]+t*3*a.C3[i]);
+    return a.C0[i]+t*(a.C1[i]+t*(a.C2[i]+t*a.C3[i]));
+  }
+
+  /** evaluate \f$V_S\f$ of the ifunc-th function over a row of distances
+   * @param dist distances
+   * @param v v[j]=\f$V_S\f$(dist[j])
+   * @param n number of distances
+   */
+  inline void evaluateV(int ifunc, const T* restrict dist, T* restrict v, int n) const
+  {
+    const Function& a=Funcs[ifunc];
+    const T rcut=a.Rcut, delta=a.Delta, dinv=a.DeltaInv, tail=a.Tail;
+    const int last=a.LastIndex;
+    const T* restrict c0=a.C0.data();
+    const T* restrict c1=a.C1.data();
+    const T* restrict c2=a.C2.data();
+    const T* restrict c3=a.C3.data();
+    #pragma omp simd
+    for(int j=0; j<n; ++j)
+    {
+      const bool inside=dist[j]<rcut;
+      const T r=inside? dist[j]:T(0);
+      int i=static_cast<int>(r*dinv);
+      i=(i<last)? i:last;
+      const T t=r-i*delta;
+      const T rv=inside? c0[i]+t*(c1[i]+t*(c2[i]+t*c3[i])):tail;
+      v[j]=rv/dist[j];
+    }
+  }
+
+  /** evaluate \f$V_S\f$ and \f$\frac{1}{r}\frac{dV_S}{dr}\f$ of the ifunc-th function over a row of distances
+   *
+   * dv[j] times the displacement is the gradient of \f$V_S\f$.
+   */
+  inline void evaluateVdV(int ifunc, const T* restrict dist, T* restrict v, T* restrict dv, int n) const
+  {
+    const Function& a=Funcs[ifunc];
+    const T rcut=a.Rcut, delta=a.Delta, dinv=a.DeltaInv, tail=a.Tail;
+    const int last=a.LastIndex;
+    const T* restrict c0=a.C0.data();
+    const T* restrict c1=a.C1.data();
+    const T* restrict c2=a.C2.data();
+    const T* restrict c3=a.C3.data();
+    #pragma omp simd
+    for(int j=0; j<n; ++j)
+    {
+      const bool inside=dist[j]<rcut;
+      const T r=inside? dist[j]:T(0);
+      int i=static_cast<int>(r*dinv);
+      i=(i<last)? i:last;
+      const T t=r-i*delta;
+      const T rv=inside? c0[i]+t*(c1[i]+t*(c2[i]+t*c3[i])):tail;
+      const T du=inside? c1[i]+t*(2*c2[i]+t*3*c3[i]):T(0);
+      const T rinv=T(1)/dist[j];
+      v[j]=rv*rinv;
+      dv[j]=(du-rv*rinv)*rinv*rinv;
+    }
+  }
+};
+
+}
+#endif
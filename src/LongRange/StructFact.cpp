@@ -18,7 +18,6 @@
 
 #include <LongRange/StructFact.h>
 #include <config/stdlib/math.h>
-#include <Numerics/e2iphi.h>
 #include <simd/vmath.hpp>
 #include <Numerics/OhmmsBlas.h>
 #include <qmc_common.h>
@@ -28,7 +27,7 @@ namespace qmcplusplus
 
 //Constructor - pass arguments to KLists' constructor
 StructFact::StructFact(ParticleSet& P, RealType kc):
-  DoUpdate(false), StorePerParticle(false), SuperCellEnum(SUPERCELL_BULK)
+  DoUpdate(false), DoRhok(true), StorePerParticle(false), SuperCellEnum(SUPERCELL_BULK)
 {
   if(qmc_common.use_ewald && P.LRBox.SuperCellEnum == SUPERCELL_SLAB)
   {
@@ -49,6 +48,7 @@ StructFact::UpdateNewCell(ParticleSet& P, RealType kc)
   KLists.UpdateKLists(P.LRBox,kc);
   //resize any array
   resize(P.getSpeciesSet().size(),P.getTotalNum(),KLists.numk);
+  buildLadders(P);
   //Compute the entire Rhok
   FillRhok(P);
 }
@@ -66,6 +66,8 @@ void StructFact::resize(int ns, int nptcl, int nkpts)
   }
   eikr_r_temp.resize(nkpts);
   eikr_i_temp.resize(nkpts);
+  eikr_r_old.resize(nkpts);
+  eikr_i_old.resize(nkpts);
 #else
   rhok.resize(ns,nkpts);
   eikr.resize(nptcl,nkpts);
@@ -75,10 +77,91 @@ void StructFact::resize(int ns, int nptcl, int nkpts)
 
 
 
+void StructFact::buildLadders(ParticleSet& P)
+{
+  int nladder=0;
+  for(int idim=0; idim<OHMMS_DIM; idim++)
+  {
+    PosType unit(0.0);
+    unit[idim]=1.0;
+    KUnit[idim]=P.LRBox.k_cart(unit);
+    const int m=KLists.mmax[idim];
+    LadderIndex[idim].resize(KLists.numk);
+    for(int ki=0; ki<KLists.numk; ki++)
+      LadderIndex[idim][ki]=nladder+m+KLists.kpts[ki][idim];
+    nladder+=2*m+1;
+  }
+  ladder_r.resize(nladder);
+  ladder_i.resize(nladder);
+}
+
+void StructFact::evaluateEikr(const PosType& pos, RealType* restrict er, RealType* restrict ei)
+{
+  RealType* restrict lr=ladder_r.data();
+  RealType* restrict li=ladder_i.data();
+  for(int idim=0; idim<OHMMS_DIM; idim++)
+  {
+    const int m=KLists.mmax[idim];
+    RealType s,c;
+    sincos(dot(KUnit[idim],pos),&s,&c);
+    // e^{-in phi} is the conjugate of e^{in phi}
+    lr[m]=1.0;
+    li[m]=0.0;
+    for(int n=1; n<=m; n++)
+    {
+      const RealType r=lr[m+n-1]*c-li[m+n-1]*s;
+      const RealType i=lr[m+n-1]*s+li[m+n-1]*c;
+      lr[m+n]=r;
+      li[m+n]=i;
+      lr[m-n]=r;
+      li[m-n]=-i;
+    }
+    lr+=2*m+1;
+    li+=2*m+1;
+  }
+  lr=ladder_r.data();
+  li=ladder_i.data();
+  const int* restrict ind0=LadderIndex[0].data();
+#if OHMMS_DIM==3
+  const int* restrict ind1=LadderIndex[1].data();
+  const int* restrict ind2=LadderIndex[2].data();
+  #pragma omp simd
+  for(int ki=0; ki<KLists.numk; ki++)
+  {
+    const RealType r01=lr[ind0[ki]]*lr[ind1[ki]]-li[ind0[ki]]*li[ind1[ki]];
+    const RealType i01=lr[ind0[ki]]*li[ind1[ki]]+li[ind0[ki]]*lr[ind1[ki]];
+    er[ki]=r01*lr[ind2[ki]]-i01*li[ind2[ki]];
+    ei[ki]=r01*li[ind2[ki]]+i01*lr[ind2[ki]];
+  }
+#elif OHMMS_DIM==2
+  const int* restrict ind1=LadderIndex[1].data();
+  #pragma omp simd
+  for(int ki=0; ki<KLists.numk; ki++)
+  {
+    er[ki]=lr[ind0[ki]]*lr[ind1[ki]]-li[ind0[ki]]*li[ind1[ki]];
+    ei[ki]=lr[ind0[ki]]*li[ind1[ki]]+li[ind0[ki]]*lr[ind1[ki]];
+  }
+#else
+  for(int ki=0; ki<KLists.numk; ki++)
+  {
+    er[ki]=lr[ind0[ki]];
+    ei[ki]=li[ind0[ki]];
+  }
+#endif
+}
+
 void
 StructFact::UpdateAllPart(ParticleSet& P)
 {
-  FillRhok(P);
+  if(DoRhok)
+    FillRhok(P);
+}
+
+void
+StructFact::checkRhok(const std::string& caller) const
+{
+  if(!DoRhok)
+    APP_ABORT(caller+" reads rhok, which is turned off by lr_mesh=\"only\". Use lr_mesh on every Coulomb term of the particle set.");
 }
 
 
@@ -98,15 +181,14 @@ StructFact::FillRhok(ParticleSet& P)
     // save per particle and species value
     for(int i=0; i<npart; ++i)
     {
-      const auto& pos = P.R[i];
       auto* restrict eikr_r_ptr = eikr_r[i];
       auto* restrict eikr_i_ptr = eikr_i[i];
       auto* restrict rhok_r_ptr = rhok_r[P.GroupID[i]];
       auto* restrict rhok_i_ptr = rhok_i[P.GroupID[i]];
+      evaluateEikr(P.R[i],eikr_r_ptr,eikr_i_ptr);
       #pragma omp simd
       for(int ki=0; ki<nk; ki++)
       {
-        sincos(dot(KLists.kpts_cart[ki],pos),&eikr_i_ptr[ki],&eikr_r_ptr[ki]);
         rhok_r_ptr[ki] += eikr_r_ptr[ki];
         rhok_i_ptr[ki] += eikr_i_ptr[ki];
       }
@@ -117,28 +199,15 @@ StructFact::FillRhok(ParticleSet& P)
     // save per species value
     for(int i=0; i<npart; ++i)
     {
-      const auto& pos = P.R[i];
       auto* restrict rhok_r_ptr = rhok_r[P.GroupID[i]];
       auto* restrict rhok_i_ptr = rhok_i[P.GroupID[i]];
-#ifdef __INTEL_COMPILER
+      evaluateEikr(P.R[i],eikr_r_temp.data(),eikr_i_temp.data());
       #pragma omp simd
       for(int ki=0; ki<nk; ki++)
-      {
-        RealType s,c;
-        sincos(dot(KLists.kpts_cart[ki],pos),&s,&c);
-        rhok_r_ptr[ki] += c;
-        rhok_i_ptr[ki] += s;
-      }
-#else
-      for(int ki=0; ki<nk; ki++)
-        phiV[ki] = dot(KLists.kpts_cart[ki],pos);
-      eval_e2iphi(nk, phiV.data(), eikr_r_temp.data(), eikr_i_temp.data());
-      for(int ki=0; ki<nk; ki++)
       {
         rhok_r_ptr[ki] += eikr_r_temp[ki];
         rhok_i_ptr[ki] += eikr_i_temp[ki];
       }
-#endif
     }
   }
 #else
@@ -163,9 +232,7 @@ StructFact::FillRhok(ParticleSet& P)
 void StructFact::makeMove(int active, const PosType& pos)
 {
 #if defined(USE_REAL_STRUCT_FACTOR)
-  #pragma omp simd
-  for(int ki=0; ki<KLists.numk; ki++)
-    sincos(dot(KLists.kpts_cart[ki],pos),&eikr_i_temp[ki],&eikr_r_temp[ki]);
+  evaluateEikr(pos,eikr_r_temp.data(),eikr_i_temp.data());
 #else
   RealType s,c;//get sin and cos
   for(int ki=0; ki<KLists.numk; ++ki)
@@ -199,13 +266,12 @@ void StructFact::acceptMove(int active, int gid, const PosType& rold)
     RealType* restrict rhok_ptr_i(rhok_i[gid]);
 
     // add the new value and subtract the old value
+    evaluateEikr(rold,eikr_r_old.data(),eikr_i_old.data());
     #pragma omp simd
     for(int ki=0; ki<KLists.numk; ++ki)
     {
-      RealType s, c;
-      sincos(dot(KLists.kpts_cart[ki],rold),&s,&c);
-      rhok_ptr_r[ki] += eikr_r_temp[ki] - c;
-      rhok_ptr_i[ki] += eikr_i_temp[ki] - s;
+      rhok_ptr_r[ki] += eikr_r_temp[ki] - eikr_r_old[ki];
+      rhok_ptr_i[ki] += eikr_i_temp[ki] - eikr_i_old[ki];
     }
   }
 #else
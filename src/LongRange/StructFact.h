@@ -47,6 +47,12 @@ public:
    * unless Hamiltonian uses pbyp.
    */
   bool DoUpdate;
+  /** false, if rhok is not computed by UpdateAllPart
+   *
+   * Default is true. Set to false when the only user of rhok evaluates the
+   * long-range sums on a mesh, see LRHandlerBase::evaluateMesh.
+   */
+  bool DoRhok;
   /// default false, the per particle data is not saved
   bool StorePerParticle;
   /** enumeration for the methods to handle mixed bconds
@@ -85,6 +91,10 @@ public:
   /**  Update Rhok if all particles moved
    */
   void UpdateAllPart(ParticleSet& P);
+  /** abort if rhok and eikr are not computed, see DoRhok
+   * @param caller name of the function that reads them
+   */
+  void checkRhok(const std::string& caller) const;
 
   /** evaluate eikr_temp for eikr for the proposed move
    * @param active index of the moved particle
@@ -167,8 +177,32 @@ public:
   void turnOnStorePerParticle(ParticleSet& P);
 
 private:
+  ///reciprocal cell vectors, kpts_cart[ki]=sum_d kpts[ki][d]*KUnit[d]
+  PosType KUnit[OHMMS_DIM];
+  ///e^{i n KUnit[d].r} for -mmax[d]<=n<=mmax[d], stored by dimension
+  Vector<RealType> ladder_r, ladder_i;
+  ///LadderIndex[d][ki] index of kpts[ki][d] in the ladders
+  std::vector<int> LadderIndex[OHMMS_DIM];
+#if defined(USE_REAL_STRUCT_FACTOR)
+  ///e^{ik.r} at the old position of the accepted particle
+  Vector<RealType> eikr_r_old, eikr_i_old;
+#endif
+
   ///Compute all rhok elements from the start
   void FillRhok(ParticleSet& P);
+  /** set KUnit and the ladder indices of the k-vectors
+   * @param P particle set providing the cell
+   */
+  void buildLadders(ParticleSet& P);
+  /** evaluate e^{ik.r} for all the k-vectors at pos
+   * @param pos position
+   * @param er real part
+   * @param ei imaginary part
+   *
+   * The phases of the reciprocal cell vectors are raised to the integer components of
+   * the k-vectors by recurrence and multiplied instead of calling sincos for every k.
+   */
+  void evaluateEikr(const PosType& pos, RealType* restrict er, RealType* restrict ei);
   /** resize the internal data
    * @param np number of species
    * @param nptcl number of particles
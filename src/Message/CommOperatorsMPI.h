@@ -124,6 +124,13 @@ Communicate::isend(int dest, int tag, T*, int n)
   return MPI_REQUEST_NULL;
 }
 
+template<typename T> inline Communicate::request
+Communicate::ireduce(T& sb, T& rb)
+{
+  APP_ABORT("Need specialization for ireduce(T&, T&)");
+  return MPI_REQUEST_NULL;
+}
+
 template<typename T> inline void Communicate::allreduce(T&, mpi_comm_type comm )
 {
   APP_ABORT("Need specialization for allreduce(T&,comm)");
@@ -460,6 +467,26 @@ Communicate::reduce(std::vector<double>& g)
     g = gt;
 }
 
+/** non-blocking sum of sb over the ranks into rb of the rank 0
+ *
+ * sb and rb are not to be touched until the request is completed.
+ */
+template<> inline Communicate::request
+Communicate::ireduce(std::vector<float>& sb, std::vector<float>& rb)
+{
+  request r;
+  MPI_Ireduce(&(sb[0]),&(rb[0]),sb.size(),MPI_FLOAT,MPI_SUM,0,myMPI,&r);
+  return r;
+}
+
+template<> inline Communicate::request
+Communicate::ireduce(std::vector<double>& sb, std::vector<double>& rb)
+{
+  request r;
+  MPI_Ireduce(&(sb[0]),&(rb[0]),sb.size(),MPI_DOUBLE,MPI_SUM,0,myMPI,&r);
+  return r;
+}
+
 template<>
 inline void
 Communicate::reduce(std::vector<int>& g)
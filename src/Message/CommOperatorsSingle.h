@@ -71,6 +71,13 @@ Communicate::isend(int dest, int tag, T*, int n)
   return 1;
 }
 
+template<typename T> inline Communicate::request
+Communicate::ireduce(T& sb, T& rb)
+{
+  rb=sb;
+  return 1;
+}
+
 template<typename T, typename IT>
 inline void Communicate::gatherv(T& sb, T& rb, IT&, IT&, int dest)
 {
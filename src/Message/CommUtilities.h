@@ -74,6 +74,8 @@ namespace qmcplusplus
 template<typename CT>
 inline void cancel(CT& r) { }
 
+inline void wait_all(int n, Communicate::request* pending) { }
+
 template<typename T>
 inline void bcast(T& a, Communicate* comm) { }
 }
@@ -236,6 +236,7 @@ public:
   template<typename T> request isend(int dest, int tag, T&);
   template<typename T> request irecv(int source, int tag, T*, int n);
   template<typename T> request isend(int dest, int tag, T*, int n);
+  template<typename T> request ireduce(T& sb, T& rb);
 
   // MMORALES: this is just a temporary fix for the communicator problem
   //           Adding needed routines with explicit communicator arguments
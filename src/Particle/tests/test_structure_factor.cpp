@@ -0,0 +1,195 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2018 Jeongnim Kim and QMCPACK developers.
+//
+// File developed by: Mark Dewing, mdewing@anl.gov, Argonne National Laboratory
+//
+// File created by: Mark Dewing, mdewing@anl.gov, Argonne National Laboratory
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include "Particle/ParticleSet.h"
+#include "LongRange/StructFact.h"
+#include "LongRange/KContainer.h"
+#include "LongRange/LRBreakupCache.h"
+#include <qmc_common.h>
+
+#include <stdio.h>
+#include <string>
+#include <set>
+
+namespace qmcplusplus
+{
+
+typedef QMCTraits::RealType RealType;
+typedef QMCTraits::PosType PosType;
+
+/// compare rhok and, if stored, eikr with sincos at every k
+void check_rhok(const ParticleSet& P)
+{
+  const StructFact& sk=*P.SK;
+  const int nk=sk.KLists.numk;
+  for(int ig=0; ig<P.groups(); ig++)
+    for(int ki=0; ki<nk; ki++)
+    {
+      RealType rr(0), ri(0);
+      for(int i=P.first(ig); i<P.last(ig); i++)
+      {
+        const RealType phase=dot(sk.KLists.kpts_cart[ki],P.R[i]);
+        rr+=std::cos(phase);
+        ri+=std::sin(phase);
+        if(sk.StorePerParticle)
+        {
+          REQUIRE(sk.eikr_r[i][ki] == Approx(std::cos(phase)));
+          REQUIRE(sk.eikr_i[i][ki] == Approx(std::sin(phase)));
+        }
+      }
+      REQUIRE(sk.rhok_r[ig][ki] == Approx(rr));
+      REQUIRE(sk.rhok_i[ig][ki] == Approx(ri));
+    }
+}
+
+TEST_CASE("StructFact recurrence", "[particle][longrange]")
+{
+  OHMMS::Controller->initialize(0, NULL);
+
+  for(int store=0; store<2; store++)
+  {
+    ParticleSet elec;
+    elec.setName("elec");
+    std::vector<int> ud(2);
+    ud[0]=2;
+    ud[1]=1;
+    elec.create(ud);
+    elec.R[0]=PosType(0.1, 0.2, 0.3);
+    elec.R[1]=PosType(2.1, -0.4, 1.3);
+    elec.R[2]=PosType(1.0, 3.2, 4.1);
+    SpeciesSet& tspecies=elec.getSpeciesSet();
+    tspecies.addSpecies("u");
+    tspecies.addSpecies("d");
+
+    // a triclinic cell
+    elec.Lattice.BoxBConds=true;
+    elec.Lattice.R(0,0)=4.0; elec.Lattice.R(0,1)=0.0; elec.Lattice.R(0,2)=0.0;
+    elec.Lattice.R(1,0)=1.0; elec.Lattice.R(1,1)=4.5; elec.Lattice.R(1,2)=0.0;
+    elec.Lattice.R(2,0)=0.5; elec.Lattice.R(2,1)=-0.7; elec.Lattice.R(2,2)=5.0;
+    elec.Lattice.reset();
+    elec.createSK();
+    if(store)
+      elec.SK->turnOnStorePerParticle(elec);
+    REQUIRE(elec.SK->KLists.numk > 100);
+    check_rhok(elec);
+
+    // particle-by-particle update
+    elec.SK->DoUpdate=true;
+    const PosType rold=elec.R[1];
+    const PosType rnew(-1.7, 2.9, 0.6);
+    elec.SK->makeMove(1,rnew);
+    elec.SK->acceptMove(1,elec.GroupID[1],rold);
+    elec.R[1]=rnew;
+    check_rhok(elec);
+
+    elec.R[2]=PosType(3.3, 0.1, -2.2);
+    elec.SK->UpdateAllPart(elec);
+    check_rhok(elec);
+  }
+}
+
+TEST_CASE("KContainer sphere", "[particle][longrange]")
+{
+  // a skewed slab, long in the third direction
+  ParticleSet::ParticleLayout_t lattice;
+  lattice.BoxBConds=true;
+  lattice.R(0,0)=4.0; lattice.R(0,1)=0.0; lattice.R(0,2)=0.0;
+  lattice.R(1,0)=1.3; lattice.R(1,1)=3.5; lattice.R(1,2)=0.0;
+  lattice.R(2,0)=0.4; lattice.R(2,1)=-0.6; lattice.R(2,2)=21.0;
+  lattice.reset();
+  const RealType kc=4.5;
+
+  KContainer klists;
+  klists.UpdateKLists(lattice,kc);
+  const int nk=klists.numk;
+  REQUIRE(nk == klists.kpts.size());
+  REQUIRE(klists.kshell.front() == 0);
+  REQUIRE(klists.kshell.back() == nk);
+
+  // every vector of the box within kc, by brute force
+  std::set<std::vector<int> > ref;
+  const int m=40;
+  for(int i=-m; i<=m; i++)
+    for(int j=-m; j<=m; j++)
+      for(int k=-4*m; k<=4*m; k++)
+      {
+        if(i==0 && j==0 && k==0) continue;
+        const PosType kcart=lattice.k_cart(PosType(i,j,k));
+        if(dot(kcart,kcart)<=kc*kc)
+          ref.insert(std::vector<int>{i,j,k});
+      }
+  REQUIRE(nk == ref.size());
+
+  std::set<std::vector<int> > found;
+  for(int ks=0; ks+1<klists.kshell.size(); ks++)
+  {
+    const int key=static_cast<int>(klists.ksq[klists.kshell[ks]]*1000);
+    if(ks>0)
+      REQUIRE(key > static_cast<int>(klists.ksq[klists.kshell[ks-1]]*1000));
+    for(int ki=klists.kshell[ks]; ki<klists.kshell[ks+1]; ki++)
+    {
+      REQUIRE(static_cast<int>(klists.ksq[ki]*1000) == key);
+      const TinyVector<int,3>& kv=klists.kpts[ki];
+      found.insert(std::vector<int>{kv[0],kv[1],kv[2]});
+      const TinyVector<int,3>& mkv=klists.kpts[klists.minusk[ki]];
+      REQUIRE(mkv[0] == -kv[0]);
+      REQUIRE(mkv[1] == -kv[1]);
+      REQUIRE(mkv[2] == -kv[2]);
+    }
+  }
+  REQUIRE(found == ref);
+}
+
+TEST_CASE("LRBreakupCache", "[particle][longrange]")
+{
+  typedef LRBreakupCache::mRealType mRealType;
+  OHMMS::Controller->initialize(0, NULL);
+  ParticleSet::ParticleLayout_t lattice;
+  lattice.BoxBConds=true;
+  lattice.R.diagonal(3.0);
+  lattice.reset();
+
+  const std::string fname="lr_breakup_test.h5";
+  std::remove(fname.c_str());
+  qmc_common.lr_breakup_cache=fname;
+
+  std::vector<mRealType> inputs={1.0, 2.0, 3.5};
+  std::vector<mRealType> coefs={0.1, -0.2, 0.3, 0.4};
+  std::vector<mRealType> cached(coefs.size());
+  int maxkshell=0;
+  LRBreakupCache cache("test",lattice,inputs);
+  REQUIRE(cache.enabled());
+  REQUIRE(!cache.get(maxkshell,cached));
+  cache.put(7,coefs);
+
+  LRBreakupCache same("test",lattice,inputs);
+  REQUIRE(same.key() == cache.key());
+  REQUIRE(same.get(maxkshell,cached));
+  REQUIRE(maxkshell == 7);
+  for(int i=0; i<coefs.size(); i++)
+    REQUIRE(cached[i] == Approx(coefs[i]));
+
+  // a different cell or function misses
+  inputs[2]=3.6;
+  LRBreakupCache other("test",lattice,inputs);
+  REQUIRE(!other.get(maxkshell,cached));
+  lattice.R(0,0)=3.1;
+  LRBreakupCache othercell("test",lattice,std::vector<mRealType>{1.0, 2.0, 3.5});
+  REQUIRE(!othercell.get(maxkshell,cached));
+
+  qmc_common.lr_breakup_cache.clear();
+  REQUIRE(!LRBreakupCache("test",lattice,inputs).enabled());
+  std::remove(fname.c_str());
+}
+}
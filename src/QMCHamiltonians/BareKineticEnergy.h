@@ -44,6 +44,36 @@ inline T laplacian(const TinyVector<std::complex<T>,D>& g, const std::complex<T>
   return  l.real()+OTCDot<T,T,D>::apply(g,g);
 }
 
+/** sum of laplacian over n particles as a flat loop over the components
+ */
+template<typename T, unsigned D>
+inline T sumLaplacian(const TinyVector<T,D>* restrict g, const T* restrict l, int n)
+{
+  const T* restrict gflat=g[0].data();
+  T res=0;
+  #pragma omp simd reduction(+:res)
+  for(int i=0; i<n*D; ++i)
+    res+=gflat[i]*gflat[i];
+  #pragma omp simd reduction(+:res)
+  for(int i=0; i<n; ++i)
+    res+=l[i];
+  return res;
+}
+
+/** specialization of sumLaplacian with complex g & l
+ */
+template<typename T, unsigned D>
+inline T sumLaplacian(const TinyVector<std::complex<T>,D>* restrict g, const std::complex<T>* restrict l, int n)
+{
+  const std::complex<T>* restrict gflat=g[0].data();
+  T res=0;
+  for(int i=0; i<n*D; ++i)
+    res+=gflat[i].real()*gflat[i].real()-gflat[i].imag()*gflat[i].imag();
+  for(int i=0; i<n; ++i)
+    res+=l[i].real();
+  return res;
+}
+
 
 /** @ingroup hamiltonian
   @brief Evaluate the kinetic energy with a single mass
@@ -138,6 +168,7 @@ struct BareKineticEnergy: public QMCHamiltonianBase
       SameMass&=(std::abs(tspecies(massind,i)-M)<1e-6);
       MinusOver2M[i]=-1.0/(2.0*tspecies(massind,i));
     }
+    WorkUnits=p.getTotalNum();
   }
   ///destructor
   ~BareKineticEnergy() { }
@@ -207,6 +238,29 @@ struct BareKineticEnergy: public QMCHamiltonianBase
   }
 
 
+  /** evaluate a crowd of walkers
+   *
+   * With a single mass the gradients and laplacians of each walker are summed
+   * in one flat loop, otherwise evaluate is called.
+   */
+  void mw_evaluate(const std::vector<QMCHamiltonianBase*>& O_list,
+                   const std::vector<ParticleSet*>& P_list,
+                   std::vector<Return_t>& values)
+  {
+    if(!SameMass || streaming_particles)
+    {
+      QMCHamiltonianBase::mw_evaluate(O_list,P_list,values);
+      return;
+    }
+    for(int iw=0; iw<O_list.size(); iw++)
+    {
+      const ParticleSet& P=*P_list[iw];
+      values[iw]=-OneOver2M*sumLaplacian(P.G.data(),P.L.data(),P.getTotalNum());
+      O_list[iw]->Value=values[iw];
+    }
+  }
+
+
 #if !defined(REMOVE_TRACEMANAGER)
   inline Return_t evaluate_sp(ParticleSet& P)
   {
@@ -24,10 +24,11 @@ namespace qmcplusplus
 {
 
 CoulombPBCAA::CoulombPBCAA(ParticleSet& ref, bool active,
-                           bool computeForces) :
+                           bool computeForces, bool useMesh) :
   AA(0), myGrid(0), rVs(0),
   is_active(active), FirstTime(true), myConst(0.0),
-  ComputeForces(computeForces), ForceBase(ref,ref), Ps(ref)
+  ComputeForces(computeForces), UseMesh(useMesh && !computeForces),
+  ForceBase(ref,ref), Ps(ref)
 {
   ReportEngine PRE("CoulombPBCAA","CoulombPBCAA");
   set_energy_domain(potential);
@@ -125,11 +126,35 @@ CoulombPBCAA::evaluate(ParticleSet& P)
   return Value;
 }
 
+void CoulombPBCAA::mw_evaluate(const std::vector<QMCHamiltonianBase*>& O_list,
+                               const std::vector<ParticleSet*>& P_list,
+                               std::vector<Return_t>& values)
+{
+#if defined(USE_REAL_STRUCT_FACTOR)
+  const bool batched= is_active && !UseMesh && !streaming_particles
+                   && P_list[0]->SK->SuperCellEnum!=SUPERCELL_SLAB;
+#else
+  const bool batched=false;
+#endif
+  if(!batched)
+  {
+    QMCHamiltonianBase::mw_evaluate(O_list,P_list,values);
+    return;
+  }
+  for(int iw=0; iw<O_list.size(); iw++)
+  {
+    ParticleSet& P=*P_list[iw];
+    values[iw]=evalLRFolded(P)+evalSR(P)+myConst;
+    O_list[iw]->Value=values[iw];
+  }
+}
+
 
 #if !defined(REMOVE_TRACEMANAGER)
 CoulombPBCAA::Return_t
 CoulombPBCAA::evaluate_sp(ParticleSet& P)
 {
+  P.SK->checkRhok("CoulombPBCAA::evaluate_sp");
   RealType  Vsr = 0.0;
   RealType  Vlr = 0.0;
   mRealType& Vc  = myConst;
@@ -148,7 +173,7 @@ CoulombPBCAA::evaluate_sp(ParticleSet& P)
         const RealType* dist=d_aa.Distances[ipart];
         for(int jpart=0; jpart<ipart; ++jpart)
         {
-          pairpot = z*Zat[jpart]*rVs->splint(dist[jpart])/dist[jpart];
+          pairpot = z*Zat[jpart]*SRTable.evaluate(0,dist[jpart])/dist[jpart];
           V_samp(ipart)+=pairpot;
           V_samp(jpart)+=pairpot;
           Vsr += pairpot;
@@ -162,7 +187,7 @@ CoulombPBCAA::evaluate_sp(ParticleSet& P)
         z = .5*Zat[ipart];
         for(int nn=d_aa.M[ipart],jpart=ipart+1; nn<d_aa.M[ipart+1]; nn++,jpart++)
         {
-          pairpot = z*Zat[jpart]*d_aa.rinv(nn)*rVs->splint(d_aa.r(nn));
+          pairpot = z*Zat[jpart]*d_aa.rinv(nn)*SRTable.evaluate(0,d_aa.r(nn));
           V_samp(ipart)+=pairpot;
           V_samp(jpart)+=pairpot;
           Vsr += pairpot;
@@ -178,6 +203,10 @@ CoulombPBCAA::evaluate_sp(ParticleSet& P)
     {
       APP_ABORT("CoulombPBCAA::evaluate_sp single particle traces have not been implemented for slab geometry");
     }
+    else if(UseMesh)
+    {
+      APP_ABORT("CoulombPBCAA::evaluate_sp single particle traces have not been implemented for the particle mesh");
+    }
     else
     {
       //jtk mark: needs optimizations for USE_REAL_STRUCT_FACTOR
@@ -283,7 +312,16 @@ void CoulombPBCAA::initBreakup(ParticleSet& P)
     SpeciesID[iat]=P.GroupID[iat];
     Zat[iat] = Zspec[P.GroupID[iat]];
   }
-  AA = LRCoulombSingleton::getHandler(P);
+  if(UseMesh)
+  {
+    MeshHandler.reset(LRCoulombSingleton::getMeshHandler(P));
+    AA = MeshHandler.get();
+  }
+  else
+    AA = LRCoulombSingleton::getHandler(P);
+  // pairs and long-range work of an evaluation
+  if(is_active)
+    WorkUnits=NumCenters*(NumCenters-1)/2+AA->evaluationWork(P.SK->KLists.kshell,NumCenters,1);
   //AA->initBreakup(*PtclRef);
   myConst=evalConsts();
   myRcut=AA->get_rc();//Basis.get_rc();
@@ -291,6 +329,9 @@ void CoulombPBCAA::initBreakup(ParticleSet& P)
   {
     rVs = LRCoulombSingleton::createSpline4RbyVs(AA,myRcut,myGrid);
   }
+  if(SRTable.size()==0)
+    SRTable.add(*rVs);
+  SRrow.resize(NumCenters);
 
   P.DistTables[0]->evaluate(P);
 }
@@ -299,6 +340,7 @@ void CoulombPBCAA::initBreakup(ParticleSet& P)
 CoulombPBCAA::Return_t
 CoulombPBCAA::evalLRwithForces(ParticleSet& P)
 {
+  P.SK->checkRhok("CoulombPBCAA::evalLRwithForces");
   //  const StructFact& PtclRhoK(*(P.SK));
   std::vector<TinyVector<RealType,DIM> > grad(P.getTotalNum());
   for(int spec2=0; spec2<NumSpecies; spec2++)
@@ -326,7 +368,7 @@ CoulombPBCAA::evalSRwithForces(ParticleSet& P)
     for(int nn=d_aa->M[ipart],jpart=ipart+1; nn<d_aa->M[ipart+1]; nn++,jpart++)
     {
       RealType rV, d_rV_dr, d2_rV_dr2;
-      rV = rVs->splint(d_aa->r(nn), d_rV_dr, d2_rV_dr2);
+      rV = SRTable.evaluate(0, d_aa->r(nn), d_rV_dr);
       RealType V = rV *d_aa->rinv(nn);
       esum += Zat[jpart]*d_aa->rinv(nn)*rV;
       PosType grad = Zat[jpart]*Zat[ipart]*
@@ -406,26 +448,22 @@ CoulombPBCAA::evalSR(ParticleSet& P)
   mRealType SR=0.0;
   if(d_aa.DTType == DT_SOA)
   {
-    // Ye: the threading will be enabled when splint is thread safe.
-    //#pragma omp parallel for reduction(+:SR)
+    const RealType* restrict z=Zat.data();
+    RealType* restrict v=SRrow.data();
     for(size_t ipart=1; ipart<(NumCenters/2+1); ipart++)
     {
       mRealType esum = 0.0;
-      const RealType* restrict dist=d_aa.Distances[ipart];
+      SRTable.evaluateV(0,d_aa.Distances[ipart],v,ipart);
       for(size_t j=0; j<ipart; ++j)
-      {
-        esum += Zat[j]*rVs->splint(dist[j])/dist[j];
-      }
+        esum += z[j]*v[j];
       SR += Zat[ipart]*esum;
 
       if(ipart==NumCenters-ipart) continue;
 
       esum = 0.0;
-      dist = d_aa.Distances[NumCenters-ipart];
+      SRTable.evaluateV(0,d_aa.Distances[NumCenters-ipart],v,NumCenters-ipart);
       for(size_t j=0; j<NumCenters-ipart; ++j)
-      {
-        esum += Zat[j]*rVs->splint(dist[j])/dist[j];
-      }
+        esum += z[j]*v[j];
       SR += Zat[NumCenters-ipart]*esum;
     }
   }
@@ -438,7 +476,7 @@ CoulombPBCAA::evalSR(ParticleSet& P)
       {
         //if(d_aa->r(nn)>=myRcut) continue;
         //esum += Zat[jpart]*AA->evaluate(d_aa->r(nn),d_aa->rinv(nn));
-        esum += Zat[jpart]*d_aa.rinv(nn)*rVs->splint(d_aa.r(nn));
+        esum += Zat[jpart]*d_aa.rinv(nn)*SRTable.evaluate(0,d_aa.r(nn));
       }
       //Accumulate pair sums...species charge for atom i.
       SR += Zat[ipart]*esum;
@@ -450,6 +488,9 @@ CoulombPBCAA::evalSR(ParticleSet& P)
 CoulombPBCAA::Return_t
 CoulombPBCAA::evalLR(ParticleSet& P)
 {
+  if(UseMesh)
+    return AA->evaluateMesh(P,Zat);
+  P.SK->checkRhok("CoulombPBCAA::evalLR");
   mRealType res=0.0;
   const StructFact& PtclRhoK(*(P.SK));
   if(PtclRhoK.SuperCellEnum==SUPERCELL_SLAB)
@@ -510,6 +551,37 @@ CoulombPBCAA::evalLR(ParticleSet& P)
 }
 
 
+CoulombPBCAA::Return_t
+CoulombPBCAA::evalLRFolded(ParticleSet& P)
+{
+  P.SK->checkRhok("CoulombPBCAA::evalLRFolded");
+  mRealType res=0.0;
+#if defined(USE_REAL_STRUCT_FACTOR)
+  const StructFact& PtclRhoK(*(P.SK));
+  const int nk=PtclRhoK.KLists.kshell[AA->MaxKshell];
+  RhokZ_r.resize(nk);
+  RhokZ_i.resize(nk);
+  RealType* restrict zr=RhokZ_r.data();
+  RealType* restrict zi=RhokZ_i.data();
+  std::fill(zr,zr+nk,RealType(0));
+  std::fill(zi,zi+nk,RealType(0));
+  for(int s=0; s<NumSpecies; s++)
+  {
+    const RealType z=Zspec[s];
+    const RealType* restrict rr=PtclRhoK.rhok_r[s];
+    const RealType* restrict ri=PtclRhoK.rhok_i[s];
+    #pragma omp simd aligned(zr,zi)
+    for(int ki=0; ki<nk; ki++)
+    {
+      zr[ki]+=z*rr[ki];
+      zi[ki]+=z*ri[ki];
+    }
+  }
+  res=0.5*AA->evaluate(PtclRhoK.KLists.kshell,zr,zi,zr,zi);
+#endif
+  return res;
+}
+
 CoulombPBCAA::Return_t
 CoulombPBCAA::evalConsts_orig(bool report)
 {
@@ -651,7 +723,7 @@ CoulombPBCAA::evalConsts_old(bool report)
 QMCHamiltonianBase* CoulombPBCAA::makeClone(ParticleSet& qp, TrialWaveFunction& psi)
 {
   if(is_active)
-    return new CoulombPBCAA(qp,is_active,ComputeForces);
+    return new CoulombPBCAA(qp,is_active,ComputeForces,UseMesh);
   else
     return new CoulombPBCAA(*this);//nothing needs to be re-evaluated
 }
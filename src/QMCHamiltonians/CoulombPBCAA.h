@@ -19,6 +19,7 @@
 #include "QMCHamiltonians/QMCHamiltonianBase.h"
 #include "QMCHamiltonians/ForceBase.h"
 #include "LongRange/LRCoulombSingleton.h"
+#include <memory>
 
 namespace qmcplusplus
 {
@@ -35,10 +36,17 @@ struct CoulombPBCAA: public QMCHamiltonianBase, public ForceBase
   typedef LRCoulombSingleton::LRHandlerType  LRHandlerType;
   typedef LRCoulombSingleton::GridType       GridType;
   typedef LRCoulombSingleton::RadFunctorType RadFunctorType;
+  typedef LRCoulombSingleton::SRTableType    SRTableType;
   typedef LRHandlerType::mRealType           mRealType;
   LRHandlerType* AA;
+  ///particle-mesh handler, AA when UseMesh, shared by the copies of an inactive operator
+  std::shared_ptr<LRHandlerType> MeshHandler;
   GridType* myGrid;
   RadFunctorType* rVs;
+  ///tabulated rVs used by the pair loops
+  SRTableType SRTable;
+  ///scratch row of the short-range potential
+  aligned_vector<RealType> SRrow;
 
   bool is_active;
   bool FirstTime;
@@ -59,6 +67,10 @@ struct CoulombPBCAA: public QMCHamiltonianBase, public ForceBase
   Vector<ComplexType> del_eikr;
   /// Flag for whether to compute forces or not
   bool ComputeForces;
+  /// Flag for the evaluation of the long-range part on a particle mesh
+  bool UseMesh;
+  /// charge-weighted structure factor used by evalLRFolded
+  aligned_vector<RealType> RhokZ_r, RhokZ_i;
 //     madelung constant
   RealType MC0;
 
@@ -72,7 +84,7 @@ struct CoulombPBCAA: public QMCHamiltonianBase, public ForceBase
 
   /** constructor */
   CoulombPBCAA(ParticleSet& ref, bool active,
-               bool computeForces=false);
+               bool computeForces=false, bool useMesh=false);
 
   ~CoulombPBCAA();
 
@@ -80,6 +92,16 @@ struct CoulombPBCAA: public QMCHamiltonianBase, public ForceBase
 
   Return_t evaluate(ParticleSet& P);
 
+  /** evaluate a crowd of walkers
+   *
+   * The long-range part of a bulk cell folds the structure factors of the
+   * species before the sum over the k-vectors, see evalLRFolded. Other cases
+   * call evaluate.
+   */
+  void mw_evaluate(const std::vector<QMCHamiltonianBase*>& O_list,
+                   const std::vector<ParticleSet*>& P_list,
+                   std::vector<Return_t>& values);
+
   void update_source(ParticleSet& s);
 
   /** Do nothing */
@@ -112,6 +134,11 @@ struct CoulombPBCAA: public QMCHamiltonianBase, public ForceBase
 
   Return_t evalSR(ParticleSet& P);
   Return_t evalLR(ParticleSet& P);
+  /** long-range part of a bulk cell as \f$\frac{1}{2}\sum_k F_k|\sum_s Z_s\rho^s_{\bf k}|^2\f$
+   *
+   * One pass over the k-vectors instead of one per pair of species.
+   */
+  Return_t evalLRFolded(ParticleSet& P);
   Return_t evalSRwithForces(ParticleSet& P);
   Return_t evalLRwithForces(ParticleSet& P);
   Return_t evalConsts(bool report=true);
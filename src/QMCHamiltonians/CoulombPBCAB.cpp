@@ -24,8 +24,9 @@ namespace qmcplusplus
 {
 
 CoulombPBCAB::CoulombPBCAB(ParticleSet& ions, ParticleSet& elns,
-                           bool computeForces):
+                           bool computeForces, bool useMesh):
   PtclA(ions), myConst(0.0), myGrid(nullptr),V0(nullptr),fV0(nullptr),dfV0(nullptr),ComputeForces(computeForces),
+  UseMesh(useMesh && !computeForces),
   ForceBase (ions, elns), MaxGridPoints(10000),Pion(ions),Peln(elns)
 {
   ReportEngine PRE("CoulombPBCAB","CoulombPBCAB");
@@ -43,7 +44,7 @@ CoulombPBCAB::CoulombPBCAB(ParticleSet& ions, ParticleSet& elns,
 
 QMCHamiltonianBase* CoulombPBCAB::makeClone(ParticleSet& qp, TrialWaveFunction& psi)
 {
-  CoulombPBCAB* myclone=new CoulombPBCAB(PtclA,qp,ComputeForces);
+  CoulombPBCAB* myclone=new CoulombPBCAB(PtclA,qp,ComputeForces,UseMesh);
   myclone->FirstForceIndex = FirstForceIndex;
   if(myGrid)
     myclone->myGrid=new GridType(*myGrid);
@@ -80,6 +81,11 @@ QMCHamiltonianBase* CoulombPBCAB::makeClone(ParticleSet& qp, TrialWaveFunction&
       }
     }
   } 
+  myclone->SRTable=SRTable;
+  myclone->SRFuncAt=SRFuncAt;
+  myclone->fSRFuncAt=fSRFuncAt;
+  myclone->fdSRFuncAt=fdSRFuncAt;
+  myclone->SRBlocks=SRBlocks;
   return myclone;
 }
 
@@ -173,11 +179,81 @@ CoulombPBCAB::evaluate(ParticleSet& P)
 }
 
 
+void CoulombPBCAB::mw_evaluate(const std::vector<QMCHamiltonianBase*>& O_list,
+                               const std::vector<ParticleSet*>& P_list,
+                               std::vector<Return_t>& values)
+{
+#if defined(USE_REAL_STRUCT_FACTOR)
+  const bool batched= !ComputeForces && !UseMesh && !streaming_particles
+                   && PtclA.SK->SuperCellEnum!=SUPERCELL_SLAB;
+#else
+  const bool batched=false;
+#endif
+  if(!batched)
+  {
+    QMCHamiltonianBase::mw_evaluate(O_list,P_list,values);
+    return;
+  }
+#if defined(USE_REAL_STRUCT_FACTOR)
+  // the ions do not move within a crowd
+  const StructFact& RhoKA(*(PtclA.SK));
+  const std::vector<int>& kshell(RhoKA.KLists.kshell);
+  const int nk=kshell[AB->MaxKshell];
+  FkRhokA_r.resize(nk);
+  FkRhokA_i.resize(nk);
+  RealType* restrict ar=FkRhokA_r.data();
+  RealType* restrict ai=FkRhokA_i.data();
+  std::fill(ar,ar+nk,RealType(0));
+  std::fill(ai,ai+nk,RealType(0));
+  for(int i=0; i<NumSpeciesA; i++)
+  {
+    const RealType z=Zspec[i];
+    const RealType* restrict rr=RhoKA.rhok_r[i];
+    const RealType* restrict ri=RhoKA.rhok_i[i];
+    #pragma omp simd aligned(ar,ai)
+    for(int ki=0; ki<nk; ki++)
+    {
+      ar[ki]+=z*rr[ki];
+      ai[ki]+=z*ri[ki];
+    }
+  }
+  for(int ks=0; ks<AB->MaxKshell; ks++)
+  {
+    const RealType fk=AB->Fk_symm[ks];
+    for(int ki=kshell[ks]; ki<kshell[ks+1]; ki++)
+    {
+      ar[ki]*=fk;
+      ai[ki]*=fk;
+    }
+  }
+  for(int iw=0; iw<O_list.size(); iw++)
+  {
+    ParticleSet& P=*P_list[iw];
+    const StructFact& RhoKB(*(P.SK));
+    RhoKB.checkRhok("CoulombPBCAB::mw_evaluate");
+    mRealType lr=0.0;
+    for(int j=0; j<NumSpeciesB; j++)
+    {
+      const RealType* restrict rr=RhoKB.rhok_r[j];
+      const RealType* restrict ri=RhoKB.rhok_i[j];
+      mRealType u=0.0;
+      #pragma omp simd aligned(ar,ai) reduction(+:u)
+      for(int ki=0; ki<nk; ki++)
+        u+=ar[ki]*rr[ki]+ai[ki]*ri[ki];
+      lr+=Qspec[j]*u;
+    }
+    values[iw]=lr+evalSR(P)+myConst;
+    O_list[iw]->Value=values[iw];
+  }
+#endif
+}
+
 
 #if !defined(REMOVE_TRACEMANAGER)
 CoulombPBCAB::Return_t
 CoulombPBCAB::evaluate_sp(ParticleSet& P)
 {
+  P.SK->checkRhok("CoulombPBCAB::evaluate_sp");
   RealType  Vsr = 0.0;
   RealType  Vlr = 0.0;
   mRealType& Vc  = myConst;
@@ -194,10 +270,10 @@ CoulombPBCAB::evaluate_sp(ParticleSet& P)
     for(int iat=0; iat<NptclA; iat++)
     {
       z = .5*Zat[iat];
-      RadFunctorType* rVs=Vat[iat];
+      const int ifunc=SRFuncAt[iat];
       for(int nn=d_ab.M[iat], jat=0; nn<d_ab.M[iat+1]; ++nn,++jat)
       {
-        pairpot = z*Qat[jat]*d_ab.rinv(nn)*rVs->splint(d_ab.r(nn));
+        pairpot = z*Qat[jat]*d_ab.rinv(nn)*SRTable.evaluate(ifunc,d_ab.r(nn));
         Vi_samp(iat)+=pairpot;
         Ve_samp(jat)+=pairpot;
         Vsr+=pairpot;
@@ -213,6 +289,10 @@ CoulombPBCAB::evaluate_sp(ParticleSet& P)
     {
       APP_ABORT("CoulombPBCAB::evaluate_sp single particle traces have not been implemented for slab geometry");
     }
+    else if(UseMesh)
+    {
+      APP_ABORT("CoulombPBCAB::evaluate_sp single particle traces have not been implemented for the particle mesh");
+    }
     else
     {
       //jtk mark: needs optimizations for USE_REAL_STRUCT_FACTOR
@@ -383,13 +463,17 @@ CoulombPBCAB::evalSR(ParticleSet& P)
   const DistanceTableData &d_ab(*P.DistTables[myTableIndex]);
   mRealType res=czero;
   if(d_ab.DTType == DT_SOA)
-  {//can be optimized but not important enough
+  {
+    const RealType* restrict z=Zat.data();
+    RealType* restrict v=SRrow.data();
     for(size_t b=0; b<NptclB; ++b)
     {
       const RealType* restrict dist=d_ab.Distances[b];
+      for(int ib=0; ib+1<SRBlocks.size(); ++ib)
+        SRTable.evaluateV(SRFuncAt[SRBlocks[ib]],dist+SRBlocks[ib],v+SRBlocks[ib],SRBlocks[ib+1]-SRBlocks[ib]);
       mRealType esum=czero;
       for(size_t a=0; a<NptclA; ++a)
-        esum += Zat[a]*Vat[a]->splint(dist[a])/dist[a];
+        esum += z[a]*v[a];
       res += esum*Qat[b];
     }
   }
@@ -399,11 +483,11 @@ CoulombPBCAB::evalSR(ParticleSet& P)
     for(int iat=0; iat<NptclA; iat++)
     {
       mRealType esum = czero;
-      RadFunctorType* rVs=Vat[iat];
+      const int ifunc=SRFuncAt[iat];
       for(int nn=d_ab.M[iat], jat=0; nn<d_ab.M[iat+1]; ++nn,++jat)
       {
         // if(d_ab.r(nn)>=(myRcut-0.1)) continue;
-        esum += Qat[jat]*d_ab.rinv(nn)*rVs->splint(d_ab.r(nn));;
+        esum += Qat[jat]*d_ab.rinv(nn)*SRTable.evaluate(ifunc,d_ab.r(nn));
       }
       //Accumulate pair sums...species charge for atom i.
       res += Zat[iat]*esum;
@@ -416,6 +500,9 @@ CoulombPBCAB::evalSR(ParticleSet& P)
 CoulombPBCAB::Return_t
 CoulombPBCAB::evalLR(ParticleSet& P)
 {
+  if(UseMesh)
+    return AB->evaluateMesh(PtclA,Zat,P,Qat);
+  P.SK->checkRhok("CoulombPBCAB::evalLR");
   mRealType res=0.0;
   const StructFact& RhoKA(*(PtclA.SK));
   const StructFact& RhoKB(*(P.SK));
@@ -593,7 +680,15 @@ void CoulombPBCAB::initBreakup(ParticleSet& P)
   //AB->initBreakup(*PtclB);
   //initBreakup is called only once
   //AB = LRCoulombSingleton::getHandler(*PtclB);
-  AB = LRCoulombSingleton::getHandler(P);
+  if(UseMesh)
+  {
+    MeshHandler.reset(LRCoulombSingleton::getMeshHandler(P));
+    AB = MeshHandler.get();
+  }
+  else
+    AB = LRCoulombSingleton::getHandler(P);
+  // pairs and long-range work of an evaluation
+  WorkUnits=NptclA*NptclB+AB->evaluationWork(P.SK->KLists.kshell,NptclA+NptclB,2);
   myConst=evalConsts();
   myRcut=AB->get_rc();//Basis.get_rc();
   // create the spline function for the short-range part assuming pure potential
@@ -606,6 +701,7 @@ void CoulombPBCAB::initBreakup(ParticleSet& P)
     }
     Vat.resize(NptclA,V0);
     Vspec.resize(NumSpeciesA,nullptr);//prepare for PP to overwrite it
+    SRFuncAt.assign(NptclA,SRTable.add(*V0));
   }
   
   //If ComputeForces is true, then we allocate space for the radial derivative functors.
@@ -624,8 +720,23 @@ void CoulombPBCAB::initBreakup(ParticleSet& P)
     fdVat.resize(NptclA,dfV0);
     fVspec.resize(NumSpeciesA,nullptr);
     fdVspec.resize(NumSpeciesA,nullptr);
+    fSRFuncAt.assign(NptclA,SRTable.add(*fV0));
+    fdSRFuncAt.assign(NptclA,SRTable.add(*dfV0));
   }
+  SRrow.resize(NptclA);
+  resetSRBlocks();
+}
 
+void CoulombPBCAB::resetSRBlocks()
+{
+  SRBlocks.clear();
+  for(int iat=0; iat<NptclA; ++iat)
+  {
+    if(iat==0 || SRFuncAt[iat]!=SRFuncAt[iat-1]
+       || (ComputeForces && (fSRFuncAt[iat]!=fSRFuncAt[iat-1] || fdSRFuncAt[iat]!=fdSRFuncAt[iat-1])))
+      SRBlocks.push_back(iat);
+  }
+  SRBlocks.push_back(NptclA);
 }
 
 /** add a local pseudo potential
@@ -664,10 +775,14 @@ void CoulombPBCAB::add(int groupID, RadFunctorType* ppot)
     RealType deriv=(v[1]-v[0])/((*myGrid)[1]-(*myGrid)[0]);
     rfunc->spline(0,deriv,ng-1,0.0);
     Vspec[groupID]=rfunc;
+    const int ifunc=SRTable.add(*rfunc);
     for(int iat=0; iat<NptclA; iat++)
     {
       if(PtclA.GroupID[iat]==groupID)
+      {
         Vat[iat]=rfunc;
+        SRFuncAt[iat]=ifunc;
+      }
     }
   }
 
@@ -711,12 +826,16 @@ void CoulombPBCAB::add(int groupID, RadFunctorType* ppot)
     
     fVspec[groupID]=ffunc;
     fdVspec[groupID]=fdfunc;
+    const int ifunc=SRTable.add(*ffunc);
+    const int idfunc=SRTable.add(*fdfunc);
     for(int iat=0; iat<NptclA; iat++)
     {
       if(PtclA.GroupID[iat]==groupID)
       {
         fVat[iat]=ffunc;
         fdVat[iat]=fdfunc;
+        fSRFuncAt[iat]=ifunc;
+        fdSRFuncAt[iat]=idfunc;
       }
     }
     //Done   
@@ -737,11 +856,13 @@ void CoulombPBCAB::add(int groupID, RadFunctorType* ppot)
       fclose(fout);
     }
   }
+  resetSRBlocks();
 }
 
 CoulombPBCAB::Return_t
 CoulombPBCAB::evalLRwithForces(ParticleSet& P)
 {
+  P.SK->checkRhok("CoulombPBCAB::evalLRwithForces");
   //  const StructFact& RhoKA(*(PtclA.SK));
   //  const StructFact& RhoKB(*(P.SK));
   std::vector<TinyVector<RealType,DIM> > grad(PtclA.getTotalNum());
@@ -779,9 +900,9 @@ CoulombPBCAB::evalSRwithForces(ParticleSet& P)
       {
         //Low hanging SIMD fruit here.  See J1/J2 grad computation.
         rinv=1.0/dist[a];
-        rV=Vat[a]->splint(dist[a]);
-        frV=fVat[a]->splint(dist[a]);
-        fdrV=fdVat[a]->splint(dist[a]);
+        rV=SRTable.evaluate(SRFuncAt[a],dist[a]);
+        frV=SRTable.evaluate(fSRFuncAt[a],dist[a]);
+        fdrV=SRTable.evaluate(fdSRFuncAt[a],dist[a]);
         dvdr=Qat[b]*Zat[a]*(fdrV-frV)*rinv;
         forces[a][0]-=dvdr*dr[a][0]*rinv;
         forces[a][1]-=dvdr*dr[a][1]*rinv;
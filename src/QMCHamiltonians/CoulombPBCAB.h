@@ -19,6 +19,7 @@
 #include "QMCHamiltonians/QMCHamiltonianBase.h"
 #include "QMCHamiltonians/ForceBase.h"
 #include "LongRange/LRCoulombSingleton.h"
+#include <memory>
 #include "Numerics/OneDimGridBase.h"
 #include "Numerics/OneDimGridFunctor.h"
 #include "Numerics/OneDimCubicSpline.h"
@@ -39,6 +40,7 @@ struct CoulombPBCAB: public QMCHamiltonianBase, public ForceBase
   typedef LRCoulombSingleton::LRHandlerType  LRHandlerType;
   typedef LRCoulombSingleton::GridType       GridType;
   typedef LRCoulombSingleton::RadFunctorType RadFunctorType;
+  typedef LRCoulombSingleton::SRTableType    SRTableType;
   typedef LRHandlerType::mRealType           mRealType;
 
   typedef DistanceTableData::RowContainer RowContainerType;
@@ -47,6 +49,8 @@ struct CoulombPBCAB: public QMCHamiltonianBase, public ForceBase
   ParticleSet& PtclA;
   ///long-range Handler
   LRHandlerType* AB;
+  ///particle-mesh handler, AB when UseMesh, shared by the copies of this operator
+  std::shared_ptr<LRHandlerType> MeshHandler;
   ///long-range derivative handler
   LRHandlerType* dAB;
   ///locator of the distance table
@@ -73,6 +77,8 @@ struct CoulombPBCAB: public QMCHamiltonianBase, public ForceBase
   RadFunctorType* dfV0;
   /// Flag for whether to compute forces or not
   bool ComputeForces;
+  /// Flag for the evaluation of the long-range part on a particle mesh
+  bool UseMesh;
   int MaxGridPoints;
 
   ///number of particles per species of A
@@ -98,6 +104,18 @@ struct CoulombPBCAB: public QMCHamiltonianBase, public ForceBase
   ////Short-range potential (r*V) and potential derivative d/dr(rV) derivative for each species
   std::vector<RadFunctorType*> fVspec;
   std::vector<RadFunctorType*> fdVspec;
+  ///tabulated short-range potentials of all the species used by the pair loops
+  SRTableType SRTable;
+  ///index in SRTable of the potential of each ion
+  std::vector<int> SRFuncAt;
+  ///index in SRTable of the force potential and its derivative of each ion
+  std::vector<int> fSRFuncAt, fdSRFuncAt;
+  ///boundaries of the blocks of consecutive ions sharing the same functions
+  std::vector<int> SRBlocks;
+  ///scratch row of the short-range potential
+  aligned_vector<RealType> SRrow;
+  ///\f$F_k\sum_i Z_i\rho^{A,i}_{\bf k}\f$ used by mw_evaluate
+  aligned_vector<RealType> FkRhokA_r, FkRhokA_i;
   /*@{
    * @brief temporary data for pbyp evaluation
    */
@@ -125,7 +143,7 @@ struct CoulombPBCAB: public QMCHamiltonianBase, public ForceBase
   ParticleSet& Peln;
   ParticleSet& Pion;
 
-  CoulombPBCAB(ParticleSet& ions, ParticleSet& elns, bool computeForces=false);
+  CoulombPBCAB(ParticleSet& ions, ParticleSet& elns, bool computeForces=false, bool useMesh=false);
 
   ///// copy constructor
   //CoulombPBCAB(const CoulombPBCAB& c);
@@ -145,6 +163,17 @@ struct CoulombPBCAB: public QMCHamiltonianBase, public ForceBase
 
   Return_t evaluate(ParticleSet& P);
 
+  /** evaluate a crowd of walkers
+   *
+   * In a bulk cell the structure factor of the ions, weighted by the charges
+   * and \f$F_k\f$, is computed once for the crowd and each walker only takes
+   * its dot product with the structure factors of its own species.
+   * Other cases call evaluate.
+   */
+  void mw_evaluate(const std::vector<QMCHamiltonianBase*>& O_list,
+                   const std::vector<ParticleSet*>& P_list,
+                   std::vector<Return_t>& values);
+
   /** Do nothing */
   bool put(xmlNodePtr cur)
   {
@@ -182,6 +211,9 @@ struct CoulombPBCAB: public QMCHamiltonianBase, public ForceBase
   ///Adds a local pseudopotential channel "ppot" to all source species of type "groupID".
   void add(int groupID, RadFunctorType* ppot);
 
+  ///reset SRBlocks after the functions of the ions have changed
+  void resetSRBlocks();
+
   void addObservables(PropertySetType& plist, BufferType& collectables);
 
   void setObservables(PropertySetType& plist)
@@ -260,6 +260,11 @@ CoulombPBCAB_CUDA::makeClone(ParticleSet& qp, TrialWaveFunction& psi)
     myclone->V0Spline = V0Spline;
     myclone->SRSplines[ig] = SRSplines[ig];
   }
+  myclone->SRTable=SRTable;
+  myclone->SRFuncAt=SRFuncAt;
+  myclone->fSRFuncAt=fSRFuncAt;
+  myclone->fdSRFuncAt=fdSRFuncAt;
+  myclone->SRBlocks=SRBlocks;
   return myclone;
 }
 
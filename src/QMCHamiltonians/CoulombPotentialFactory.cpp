@@ -85,6 +85,7 @@ HamiltonianFactory::addCoulombPotential(xmlNodePtr cur)
   std::string sourceInp(targetPtcl->getName());
   std::string title("ElecElec"),pbc("yes");
   std::string forces("no");
+  std::string lrMesh("no");
   bool physical = true;
   OhmmsAttributeSet hAttrib;
   hAttrib.add(title,"id");
@@ -94,9 +95,16 @@ HamiltonianFactory::addCoulombPotential(xmlNodePtr cur)
   hAttrib.add(pbc,"pbc");
   hAttrib.add(physical,"physical");
   hAttrib.add(forces,"forces");
+  hAttrib.add(lrMesh,"lr_mesh");
   hAttrib.put(cur);
   bool applyPBC= (PBCType && pbc=="yes");
   bool doForces = (forces == "yes") || (forces == "true");
+  bool useMesh = applyPBC && (lrMesh == "yes" || lrMesh == "true" || lrMesh == "only");
+#ifdef QMC_CUDA
+  if(useMesh)
+    app_warning() << "  lr_mesh is ignored by the CUDA Coulomb potentials" << std::endl;
+  useMesh=false;
+#endif
   ParticleSet *ptclA=targetPtcl;
   if(sourceInp != targetPtcl->getName())
   {
@@ -110,6 +118,13 @@ HamiltonianFactory::addCoulombPotential(xmlNodePtr cur)
     }
     ptclA = (*pit).second;
   }
+  // lr_mesh="only" also stops rhok of the quantum particles, its other users abort, see StructFact::checkRhok
+  if(useMesh && lrMesh == "only" && (sourceInp != targetInp || ptclA == targetPtcl))
+  {
+    app_log() << "  lr_mesh=\"only\" turns off rhok of " << targetPtcl->getName()
+              << ". Every Coulomb term of " << targetPtcl->getName() << " must use lr_mesh." << std::endl;
+    targetPtcl->SK->DoRhok=false;
+  }
   if(sourceInp == targetInp) // AA type
   {
     if(!applyPBC && ptclA->getTotalNum() == 1)
@@ -130,7 +145,7 @@ HamiltonianFactory::addCoulombPotential(xmlNodePtr cur)
     }
 #else
     if(applyPBC)
-      targetH->addOperator(new CoulombPBCAA(*ptclA,quantum,doForces),title,physical);
+      targetH->addOperator(new CoulombPBCAA(*ptclA,quantum,doForces,useMesh),title,physical);
     else
     {
       targetH->addOperator(new CoulombPotential<Return_t>(ptclA,0,quantum), title, physical);
@@ -146,7 +161,7 @@ HamiltonianFactory::addCoulombPotential(xmlNodePtr cur)
       targetH->addOperator(new CoulombPotentialAB_CUDA(ptclA,targetPtcl),title);
 #else
     if(applyPBC)
-      targetH->addOperator(new CoulombPBCAB(*ptclA,*targetPtcl),title);
+      targetH->addOperator(new CoulombPBCAB(*ptclA,*targetPtcl,false,useMesh),title);
     else
       targetH->addOperator(new CoulombPotential<Return_t>(ptclA,targetPtcl,true),title);
 #endif
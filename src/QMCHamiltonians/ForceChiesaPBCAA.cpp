@@ -20,6 +20,7 @@
 #include "Numerics/MatrixOperators.h"
 #include "OhmmsData/ParameterSet.h"
 #include "OhmmsData/AttributeSet.h"
+#include <memory>
 
 namespace qmcplusplus
 {
@@ -138,6 +139,16 @@ void ForceChiesaPBCAA::initBreakup(ParticleSet& P)
   AB = LRCoulombSingleton::getDerivHandler(P);
 //  myConst=evalConsts();
   myRcut=AB->get_rc();//Basis.get_rc();
+  if(SRTable.size()==0)
+  {
+    //SRTable copies the splines, which do not own the grid
+    std::unique_ptr<GridType> agrid(new GridType);
+    agrid->set(0.0,myRcut,1001);
+    std::unique_ptr<RadFunctorType> rVs(LRCoulombSingleton::createSpline4RbyVs(AB,myRcut,agrid.get()));
+    std::unique_ptr<RadFunctorType> rVsDeriv(LRCoulombSingleton::createSpline4RbyVsDeriv(AB,myRcut,agrid.get()));
+    SRTable.add(*rVs);
+    SRTable.add(*rVsDeriv);
+  }
   // create the spline function for the short-range part assuming pure potential
  // if(V0==0)
  // {
@@ -187,7 +198,7 @@ void ForceChiesaPBCAA::evaluateSR(ParticleSet& P)
         const RealType r = dist[iat];
         const RealType rinv = RealType(1)/r;
         RealType g_f = g_filter(r);
-        RealType V = -AB->srDf(r,rinv);
+        RealType V = -srDf(r);
         PosType drhat = rinv*d_ab.Displacements[jat][iat];
         forces[iat] += g_f*Zat[iat]*Qat[jat]*V*drhat;
       }
@@ -208,7 +219,7 @@ void ForceChiesaPBCAA::evaluateSR(ParticleSet& P)
         RealType V;
         RealType g_f=g_filter(d_ab.r(nn));
         //rV = rVs->splint(d_ab.r(nn), d_rV_dr, d2_rV_dr2);
-        V = -AB->srDf(d_ab.r(nn),d_ab.rinv(nn));
+        V = -srDf(d_ab.r(nn));
        // std::stringstream wee;
       //  wee<<"srDf() #"<<omp_get_thread_num()<<" V= "<<V<<" "<<iat<<" "<<nn<< std::endl;
       //  std::cout <<wee.str();
@@ -234,7 +245,7 @@ void ForceChiesaPBCAA::evaluateSR_AA()
       const RealType* restrict dist=d_aa.Distances[ipart];
       for(size_t jpart=0; jpart<ipart; ++jpart)
       {
-        RealType V = -AB->srDf(dist[jpart],RealType(1)/dist[jpart]);
+        RealType V = -srDf(dist[jpart]);
         PosType grad = -Zat[jpart]*Zat[ipart]*V*dist[jpart]*d_aa.Displacements[ipart][jpart];
         forces_IonIon[ipart] += grad;
         forces_IonIon[jpart] -= grad;
@@ -251,7 +262,7 @@ void ForceChiesaPBCAA::evaluateSR_AA()
     {
       for(int nn=d_aa.M[ipart],jpart=ipart+1; nn<d_aa.M[ipart+1]; nn++,jpart++)
       {
-        RealType V = -AB->srDf(d_aa.r(nn),d_aa.rinv(nn));
+        RealType V = -srDf(d_aa.r(nn));
         PosType grad = -Zat[jpart]*Zat[ipart]*V*d_aa.rinv(nn)*d_aa.dr(nn);
         forces_IonIon[ipart] += grad;
         forces_IonIon[jpart] -= grad;
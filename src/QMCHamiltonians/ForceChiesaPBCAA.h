@@ -28,6 +28,7 @@ struct ForceChiesaPBCAA: public QMCHamiltonianBase, public ForceBase
   typedef LRCoulombSingleton::LRHandlerType LRHandlerType;
   typedef LRCoulombSingleton::GridType GridType;
   typedef LRCoulombSingleton::RadFunctorType RadFunctorType;
+  typedef LRCoulombSingleton::SRTableType SRTableType;
 
 
   RealType Rcut; // parameter: radial distance within which estimator is used
@@ -62,6 +63,15 @@ struct ForceChiesaPBCAA: public QMCHamiltonianBase, public ForceBase
   GridType* myGrid;
   ///Always mave a radial functor for the bare coulomb
   RadFunctorType* V0;
+  ///tabulated \f$rV_S\f$ and \f$d(rV_S)/dr\f$ of AB
+  SRTableType SRTable;
+
+  ///return \f$dV_S/dr\f$ from SRTable
+  inline RealType srDf(RealType r) const
+  {
+    const RealType rinv=RealType(1)/r;
+    return (SRTable.evaluate(1,r)-SRTable.evaluate(0,r)*rinv)*rinv;
+  }
 
   ///number of particles per species of A
   std::vector<int> NofSpeciesA;
@@ -21,7 +21,8 @@ namespace qmcplusplus
 {
 
 NonLocalECPComponent::NonLocalECPComponent():
-  lmax(0), nchannel(0), nknot(0), Rmax(-1), VP(0)
+  lmax(0), nchannel(0), nknot(0), Rmax(-1), VP(0),
+  RatioTimer(TimerManager.createTimer("NonLocalECP::ratios",timer_level_fine))
 {
 #if !defined(REMOVE_TRACEMANAGER)
   streaming_particles = false;
@@ -115,6 +116,7 @@ NonLocalECPComponent::evaluateOne(ParticleSet& W, int iat, TrialWaveFunction& ps
   std::vector<RealType> psiratio_(nknot);
   PosType deltaV[nknot];
 
+  RatioTimer->start();
   if(VP)
   {
     // Compute ratios with VP
@@ -146,6 +148,8 @@ NonLocalECPComponent::evaluateOne(ParticleSet& W, int iat, TrialWaveFunction& ps
       //psi.rejectMove(iel);
     }
   }
+  RatioTimer->stop();
+  RatioTimer->add_work(nknot);
 
   // Compute radial potential, multiplied by (2l+1) factor.
   for(int ip=0; ip< nchannel; ip++)
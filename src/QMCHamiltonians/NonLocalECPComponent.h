@@ -78,6 +78,8 @@ struct NonLocalECPComponent: public QMCTraits
 
   ///virtual particle set: delay initialization
   VirtualParticleSet* VP;
+  ///timer of the ratios on the quadrature points, shared by the clones
+  NewTimer* RatioTimer;
 
   //DistanceTableData* myTable;
 
@@ -130,6 +130,7 @@ NonLocalECPotential::evaluate(ParticleSet& P, bool Tmove)
 {
   std::vector<NonLocalData>& Txy(nonLocalOps.Txy);
   Value=0.0;
+  WorkUnits=0;
 #if !defined(REMOVE_TRACEMANAGER)
   if( streaming_particles)
   {
@@ -153,7 +154,10 @@ NonLocalECPotential::evaluate(ParticleSet& P, bool Tmove)
         const auto &displ = myTable->Displacements[jel];
         for(int iat=0; iat<NumIons; iat++)
           if(PP[iat]!=nullptr && dist[iat]<PP[iat]->Rmax)
+          {
             Value += PP[iat]->evaluateOneWithForces(P,iat,Psi,jel,dist[iat],RealType(-1)*displ[iat],forces[iat],Tmove,Txy);
+            WorkUnits += PP[iat]->nknot;
+          }
       }
     }
     else
@@ -171,7 +175,10 @@ NonLocalECPotential::evaluate(ParticleSet& P, bool Tmove)
         const auto &displ = myTable->Displacements[jel];
         for(int iat=0; iat<NumIons; iat++)
           if(PP[iat]!=nullptr && dist[iat]<PP[iat]->Rmax)
+          {
             Value += PP[iat]->evaluateOne(P,iat,Psi,jel,dist[iat],RealType(-1)*displ[iat],Tmove,Txy);
+            WorkUnits += PP[iat]->nknot;
+          }
       }
     }
     else
@@ -184,6 +191,7 @@ NonLocalECPotential::evaluate(ParticleSet& P, bool Tmove)
           const RealType r(myTable->r(nn));
           if(r>PP[iat]->Rmax) continue;
           Value += PP[iat]->evaluateOne(P,iat,Psi,iel,r,myTable->dr(nn),Tmove,Txy);
+          WorkUnits += PP[iat]->nknot;
         }
       }
     }
@@ -213,6 +221,50 @@ NonLocalECPotential::evaluate(ParticleSet& P, bool Tmove)
 #endif
 }
 
+void
+NonLocalECPotential::mw_evaluate(const std::vector<QMCHamiltonianBase*>& O_list,
+                                 const std::vector<ParticleSet*>& P_list,
+                                 std::vector<Return_t>& values)
+{
+  if(ComputeForces || streaming_particles || P_list[0]->DistTables[myTableIndex]->DTType != DT_SOA)
+  {
+    QMCHamiltonianBase::mw_evaluate(O_list,P_list,values);
+    return;
+  }
+  RmaxAt.resize(NumIons);
+  for(int iat=0; iat<NumIons; iat++)
+    RmaxAt[iat]=(PP[iat]!=nullptr)? PP[iat]->Rmax:RealType(-1);
+  const RealType* restrict rmax=RmaxAt.data();
+  std::vector<int> inside(NumIons);
+  for(int iw=0; iw<O_list.size(); iw++)
+  {
+    NonLocalECPotential& nl=static_cast<NonLocalECPotential&>(*O_list[iw]);
+    ParticleSet& P=*P_list[iw];
+    std::vector<NonLocalData>& Txy(nl.nonLocalOps.Txy);
+    for(int ipp=0; ipp<nl.PPset.size(); ipp++)
+      if(nl.PPset[ipp]) nl.PPset[ipp]->randomize_grid(*nl.myRNG);
+    const auto myTable = P.DistTables[myTableIndex];
+    Return_t v=0.0;
+    long work=0;
+    for(int jel=0; jel<P.getTotalNum(); jel++)
+    {
+      const auto &dist  = myTable->Distances[jel];
+      const auto &displ = myTable->Displacements[jel];
+      int n=0;
+      for(int iat=0; iat<NumIons; iat++)
+        if(dist[iat]<rmax[iat]) inside[n++]=iat;
+      for(int i=0; i<n; i++)
+      {
+        const int iat=inside[i];
+        v += nl.PP[iat]->evaluateOne(P,iat,nl.Psi,jel,dist[iat],RealType(-1)*displ[iat],false,Txy);
+        work += nl.PP[iat]->nknot;
+      }
+    }
+    nl.Value=values[iw]=v;
+    nl.WorkUnits=work;
+  }
+}
+
 void
 NonLocalECPotential::computeOneElectronTxy(ParticleSet& P, const int ref_elec)
 {
@@ -46,6 +46,17 @@ class NonLocalECPotential: public QMCHamiltonianBase, public ForceBase
 
   Return_t evaluateWithToperator(ParticleSet& P);
 
+  /** evaluate a crowd of walkers
+   *
+   * The cutoff radii of the ions are packed once for the crowd and each
+   * electron is screened against them in a flat loop. The quadrature of each
+   * walker uses its own wavefunction and random generator.
+   * Forces and the AoS distance tables call evaluate.
+   */
+  void mw_evaluate(const std::vector<QMCHamiltonianBase*>& O_list,
+                   const std::vector<ParticleSet*>& P_list,
+                   std::vector<Return_t>& values);
+
   /** set non local moves options
    * @param cur the xml input
    */
@@ -121,6 +132,8 @@ class NonLocalECPotential: public QMCHamiltonianBase, public ForceBase
   bool UseVP;
   ///Pulay force vector
   ParticleSet::ParticlePos_t PulayTerm;
+  ///cutoff radius of each ion, negative without a pseudopotential
+  aligned_vector<RealType> RmaxAt;
 #if !defined(REMOVE_TRACEMANAGER)
   ///single particle trace samples
   Array<TraceReal,1>* Ve_sample;
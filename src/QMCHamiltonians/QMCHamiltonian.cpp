@@ -472,6 +472,7 @@ QMCHamiltonian::evaluate(ParticleSet& P)
     H[i]->collect_scalar_traces();
 #endif
     myTimers[i]->stop();
+    myTimers[i]->add_work(H[i]->WorkUnits);
     H[i]->setParticlePropertyList(P.PropertyList,myIndex);
   }
   KineticEnergy=H[0]->Value;
@@ -480,6 +481,51 @@ QMCHamiltonian::evaluate(ParticleSet& P)
   // auxHevaluate(P);
   return LocalEnergy;
 }
+
+void
+QMCHamiltonian::mw_evaluate(const std::vector<QMCHamiltonian*>& H_list,
+                            const std::vector<ParticleSet*>& P_list,
+                            std::vector<Return_t>& LocalEnergies)
+{
+  const int nw=H_list.size();
+  QMCHamiltonian& leader=*H_list[0];
+  std::vector<QMCHamiltonianBase*> O_list(nw);
+  std::vector<Return_t> values(nw);
+  LocalEnergies.resize(nw);
+  for(int iw=0; iw<nw; iw++)
+    H_list[iw]->LocalEnergy=0.0;
+  for(int i=0; i<leader.H.size(); ++i)
+  {
+    for(int iw=0; iw<nw; iw++)
+      O_list[iw]=H_list[iw]->H[i];
+    leader.myTimers[i]->start();
+    leader.H[i]->mw_evaluate(O_list,P_list,values);
+    leader.myTimers[i]->stop();
+    long work=0;
+    for(int iw=0; iw<nw; iw++)
+      work+=O_list[iw]->WorkUnits;
+    leader.myTimers[i]->add_work(work);
+    for(int iw=0; iw<nw; iw++)
+    {
+      QMCHamiltonian& h=*H_list[iw];
+      h.LocalEnergy += values[iw];
+      h.H[i]->setObservables(h.Observables);
+#if !defined(REMOVE_TRACEMANAGER)
+      h.H[i]->collect_scalar_traces();
+#endif
+      h.H[i]->setParticlePropertyList(P_list[iw]->PropertyList,h.myIndex);
+    }
+  }
+  for(int iw=0; iw<nw; iw++)
+  {
+    QMCHamiltonian& h=*H_list[iw];
+    ParticleSet& P=*P_list[iw];
+    h.KineticEnergy=h.H[0]->Value;
+    P.PropertyList[LOCALENERGY]=h.LocalEnergy;
+    P.PropertyList[LOCALPOTENTIAL]=h.LocalEnergy-h.KineticEnergy;
+    LocalEnergies[iw]=h.LocalEnergy;
+  }
+}
     
 QMCHamiltonian::RealType 
 QMCHamiltonian::evaluateValueAndDerivatives(ParticleSet& P,
@@ -595,6 +641,7 @@ QMCHamiltonian::evaluateWithToperator(ParticleSet& P)
     H[i]->collect_scalar_traces();
 #endif
     myTimers[i]->stop();
+    myTimers[i]->add_work(H[i]->WorkUnits);
   }
   KineticEnergy=H[0]->Value;
   P.PropertyList[LOCALENERGY]=LocalEnergy;
@@ -252,6 +252,18 @@ public:
    * @return Local energy
    */
   Return_t evaluateWithToperator(ParticleSet& P);
+
+  /** evaluate the local energies of a crowd of walkers
+   * @param H_list Hamiltonians of the walkers, clones of the same Hamiltonian
+   * @param P_list particle sets of the walkers
+   * @param LocalEnergies local energies of the walkers
+   *
+   * Same as evaluate of each walker but every operator works on the whole
+   * crowd at once. The timers of H_list[0] are used.
+   */
+  static void mw_evaluate(const std::vector<QMCHamiltonian*>& H_list,
+                          const std::vector<ParticleSet*>& P_list,
+                          std::vector<Return_t>& LocalEnergies);
   
   /** evaluate energy and derivatives wrt to the variables
    * @param P ParticleSet
@@ -23,7 +23,7 @@ namespace qmcplusplus
 {
 
 QMCHamiltonianBase::QMCHamiltonianBase()
-  :myIndex(-1),Value(0.0),Dependants(0),tWalker(0)
+  :myIndex(-1),Value(0.0),WorkUnits(0),Dependants(0),tWalker(0)
 {
   quantum_domain       = no_quantum_domain;
   energy_domain        = no_energy_domain;
@@ -116,6 +116,13 @@ void QMCHamiltonianBase::registerObservables(std::vector<observable_helper*>& h5
   }
 }
 
+void QMCHamiltonianBase::mw_evaluate(const std::vector<QMCHamiltonianBase*>& O_list,
+    const std::vector<ParticleSet*>& P_list, std::vector<Return_t>& values)
+{
+  for(int iw=0; iw<O_list.size(); iw++)
+    values[iw]=O_list[iw]->evaluate(*P_list[iw]);
+}
+
 void QMCHamiltonianBase::addEnergy(MCWalkerConfiguration &W,
     std::vector<RealType> &LocalEnergy)
 {
@@ -105,6 +105,8 @@ struct QMCHamiltonianBase: public QMCTraits
   Return_t Value;
   ///a new value for a proposed move
   Return_t NewValue;
+  ///work units of the last evaluate, e.g. pairs or quadrature points, added to the timer
+  long WorkUnits;
   /// This is used to store the value for force on the source
   /// ParticleSet.  It is accumulated if setComputeForces(true).
   ParticleSet::ParticlePos_t IonForce;
@@ -301,6 +303,18 @@ struct QMCHamiltonianBase: public QMCTraits
     return evaluate(P);
   }
 
+  /** evaluate the values of a crowd of walkers
+   * @param O_list operators of the walkers, clones of this operator
+   * @param P_list particle sets of the walkers
+   * @param values values[iw] of the iw-th walker
+   *
+   * Called on O_list[0], the Value of every operator is set as by evaluate.
+   * Default calls evaluate of each walker.
+   */
+  virtual void mw_evaluate(const std::vector<QMCHamiltonianBase*>& O_list,
+                           const std::vector<ParticleSet*>& P_list,
+                           std::vector<Return_t>& values);
+
   /** update data associated with a particleset
    * @param s source particle set
    *
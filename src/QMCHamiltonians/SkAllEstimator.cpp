@@ -109,6 +109,7 @@ void SkAllEstimator::evaluateIonIon()
 
 SkAllEstimator::Return_t SkAllEstimator::evaluate(ParticleSet& P)
 {
+  P.SK->checkRhok("SkAllEstimator::evaluate");
   RealType w=tWalker->Weight;
 #if defined(USE_REAL_STRUCT_FACTOR)
   //sum over species
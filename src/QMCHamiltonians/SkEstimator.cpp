@@ -54,6 +54,7 @@ void SkEstimator::resetTargetParticleSet(ParticleSet& P)
 
 SkEstimator::Return_t SkEstimator::evaluate(ParticleSet& P)
 {
+  P.SK->checkRhok("SkEstimator::evaluate");
 #if defined(USE_REAL_STRUCT_FACTOR)
   //sum over species
   std::copy(P.SK->rhok_r[0],P.SK->rhok_r[0]+NumK,RhokTot_r.begin());
@@ -132,6 +132,7 @@ namespace qmcplusplus
 
   StaticStructureFactor::Return_t StaticStructureFactor::evaluate(ParticleSet& P)
   {
+    P.SK->checkRhok("StaticStructureFactor::evaluate");
     RealType w=tWalker->Weight;
     const Matrix<RealType>& rhok_r = P.SK->rhok_r;
     const Matrix<RealType>& rhok_i = P.SK->rhok_i;
@@ -23,6 +23,7 @@
 #include "Particle/SymmetricDistanceTableData.h"
 #include "QMCApp/ParticleSetPool.h"
 #include "QMCHamiltonians/CoulombPBCAA.h"
+#include "LongRange/LRHandlerPME.h"
 
 
 #include <stdio.h>
@@ -184,5 +185,168 @@ TEST_CASE("Coulomb PBC A-A elec", "[hamiltonian]")
 }
 
 
+TEST_CASE("Coulomb PBC A-A mesh", "[hamiltonian]")
+{
+
+  LRCoulombSingleton::CoulombHandler = 0;
+
+  OHMMS::Controller->initialize(0, NULL);
+
+  Uniform3DGridLayout grid;
+  grid.BoxBConds = true; // periodic
+  grid.R(0,0) = 5.0; grid.R(0,1) = 0.0; grid.R(0,2) = 0.0;
+  grid.R(1,0) = 1.2; grid.R(1,1) = 4.6; grid.R(1,2) = 0.0;
+  grid.R(2,0) = -0.8; grid.R(2,1) = 0.9; grid.R(2,2) = 6.1;
+  grid.reset();
+
+  ParticleSet elec;
+
+  elec.Lattice.copy(grid);
+  elec.setName("elec");
+  std::vector<int> ud(2);
+  ud[0] = ud[1] = 8;
+  elec.create(ud);
+  for (int i = 0; i < elec.getTotalNum(); i++)
+    elec.R[i] = ParticleSet::PosType(0.3+0.9*i, 2.1*std::cos(0.7*i)+1.0, 0.4*i*i-2.0);
+
+  SpeciesSet &tspecies =  elec.getSpeciesSet();
+  int upIdx = tspecies.addSpecies("u");
+  int downIdx = tspecies.addSpecies("d");
+  int chargeIdx = tspecies.addAttribute("charge");
+  int massIdx = tspecies.addAttribute("mass");
+  tspecies(chargeIdx, upIdx) = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+  tspecies(massIdx, upIdx) = 1.0;
+  tspecies(massIdx, downIdx) = 1.0;
+
+  elec.createSK();
+
+  CoulombPBCAA caa(elec, true);
+  CoulombPBCAA caa_mesh(elec, true, false, true);
+  REQUIRE(caa_mesh.UseMesh);
+  REQUIRE(caa_mesh.AA->onMesh());
+  // pairs and long-range work of an evaluation
+  const int n = elec.getTotalNum();
+  REQUIRE(caa.WorkUnits == n*(n-1)/2 + elec.SK->KLists.kshell[caa.AA->MaxKshell]);
+  const TinyVector<int,3>& mesh = static_cast<LRHandlerPME*>(caa_mesh.AA)->getMeshSize();
+  REQUIRE(caa_mesh.WorkUnits == n*(n-1)/2 + n*8*8*8 + mesh[0]*mesh[1]*mesh[2]);
+  elec.update();
+
+  double lr = caa.evalLR(elec);
+  double lr_mesh = caa_mesh.evalLR(elec);
+  REQUIRE(lr_mesh == Approx(lr).epsilon(1e-6));
+  REQUIRE(caa_mesh.evaluate(elec) == Approx(caa.evaluate(elec)).epsilon(1e-6));
+
+  // a clone of the mesh handler owns the clone of the wrapped handler
+  std::unique_ptr<LRHandlerBase> aa_clone(caa_mesh.AA->makeClone(elec));
+  REQUIRE(aa_clone->onMesh());
+  REQUIRE(aa_clone->evaluateMesh(elec, caa_mesh.Zat) == Approx(lr_mesh));
+
+  // the mesh does not need rhok
+  elec.SK->DoRhok = false;
+  elec.R[3] = ParticleSet::PosType(-1.3, 0.2, 2.9);
+  elec.update();
+  CoulombPBCAA caa_ref(elec, true);
+  elec.SK->DoRhok = true;
+  elec.update();
+  REQUIRE(caa_mesh.evalLR(elec) == Approx(caa_ref.evalLR(elec)).epsilon(1e-6));
 }
 
+TEST_CASE("Coulomb PBC A-A crowd", "[hamiltonian]")
+{
+
+  LRCoulombSingleton::CoulombHandler = 0;
+
+  OHMMS::Controller->initialize(0, NULL);
+
+  Uniform3DGridLayout grid;
+  grid.BoxBConds = true; // periodic
+  grid.R(0,0) = 5.0; grid.R(0,1) = 0.0; grid.R(0,2) = 0.0;
+  grid.R(1,0) = 1.2; grid.R(1,1) = 4.6; grid.R(1,2) = 0.0;
+  grid.R(2,0) = -0.8; grid.R(2,1) = 0.9; grid.R(2,2) = 6.1;
+  grid.reset();
+
+  ParticleSet elec;
+
+  elec.Lattice.copy(grid);
+  elec.setName("elec");
+  std::vector<int> ud(2);
+  ud[0] = 5;
+  ud[1] = 3;
+  elec.create(ud);
+
+  // two species with different charges to check the folding of rhok
+  SpeciesSet &tspecies =  elec.getSpeciesSet();
+  int upIdx = tspecies.addSpecies("u");
+  int downIdx = tspecies.addSpecies("d");
+  int chargeIdx = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx) = -1;
+  tspecies(chargeIdx, downIdx) = 2;
+
+  elec.createSK();
+
+  const int nw = 3;
+  std::vector<ParticleSet*> P_list(nw);
+  std::vector<CoulombPBCAA*> caa(nw);
+  std::vector<QMCHamiltonianBase*> O_list(nw);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    P_list[iw] = new ParticleSet(elec);
+    for (int i = 0; i < elec.getTotalNum(); i++)
+      P_list[iw]->R[i] = ParticleSet::PosType(0.3+0.9*i+0.4*iw, 2.1*std::cos(0.7*i+iw)+1.0, 0.4*i*i-2.0*iw);
+    caa[iw] = new CoulombPBCAA(*P_list[iw], true);
+    O_list[iw] = caa[iw];
+    P_list[iw]->update();
+  }
+
+  std::vector<QMCHamiltonianBase::Return_t> values(nw);
+  caa[0]->mw_evaluate(O_list, P_list, values);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    REQUIRE(caa[iw]->Value == values[iw]);
+    REQUIRE(values[iw] == Approx(caa[iw]->evaluate(*P_list[iw])));
+    delete caa[iw];
+    delete P_list[iw];
+  }
+}
+
+TEST_CASE("SRPotentialTable", "[hamiltonian]")
+{
+  typedef LRCoulombSingleton::pRealType pRealType;
+  const pRealType rcut=2.5;
+  const int ng=501;
+  LinearGrid<pRealType> agrid;
+  agrid.set(0,rcut,ng);
+  std::vector<pRealType> v(ng);
+  for(int ig=0; ig<ng; ig++)
+    v[ig]=std::erfc(1.3*agrid[ig]);
+  OneDimCubicSpline<pRealType> rVs(&agrid,v);
+  rVs.spline(0,-1.3*2/std::sqrt(M_PI),ng-1,0.0);
+
+  LRCoulombSingleton::SRTableType table;
+  table.add(rVs);
+  REQUIRE(table.add(rVs) == 1);
+
+  // includes a grid point, the last interval and beyond the cutoff
+  const std::vector<pRealType> dist={0.013, 0.4, 1.0, 1.77, 2.499, 2.5, 3.1};
+  const int n=dist.size();
+  std::vector<pRealType> vs(n), dvs(n);
+  table.evaluateVdV(1,dist.data(),vs.data(),dvs.data(),n);
+  for(int j=0; j<n; j++)
+  {
+    pRealType du_ref, d2u_ref, du;
+    const pRealType u_ref=rVs.splint(dist[j],du_ref,d2u_ref);
+    if(dist[j]>=rcut) du_ref=0;
+    REQUIRE(table.evaluate(0,dist[j]) == Approx(u_ref));
+    REQUIRE(table.evaluate(0,dist[j],du) == Approx(u_ref));
+    REQUIRE(du == Approx(du_ref));
+    REQUIRE(vs[j] == Approx(u_ref/dist[j]));
+    REQUIRE(dvs[j] == Approx((du_ref-u_ref/dist[j])/(dist[j]*dist[j])));
+  }
+  table.evaluateV(0,dist.data(),dvs.data(),n);
+  for(int j=0; j<n; j++)
+    REQUIRE(dvs[j] == Approx(vs[j]));
+}
+
+
+}
@@ -24,6 +24,8 @@
 #include "QMCApp/ParticleSetPool.h"
 #include "QMCHamiltonians/CoulombPBCAB.h"
 #include "QMCHamiltonians/CoulombPBCAA.h"
+#include "QMCHamiltonians/BareKineticEnergy.h"
+#include "QMCHamiltonians/QMCHamiltonian.h"
 
 
 #include <stdio.h>
@@ -111,6 +113,166 @@ TEST_CASE("Coulomb PBC A-B", "[hamiltonian]")
 
 }
 
+TEST_CASE("Coulomb PBC A-B mesh", "[hamiltonian]")
+{
+
+  LRCoulombSingleton::CoulombHandler = 0;
+
+  OHMMS::Controller->initialize(0, NULL);
+
+  Uniform3DGridLayout grid;
+  grid.BoxBConds = true; // periodic
+  grid.R(0,0) = 4.0; grid.R(0,1) = 0.5; grid.R(0,2) = 0.0;
+  grid.R(1,0) = 0.0; grid.R(1,1) = 4.5; grid.R(1,2) = 0.3;
+  grid.R(2,0) = 0.7; grid.R(2,1) = 0.0; grid.R(2,2) = 5.0;
+  grid.reset();
+
+  ParticleSet ions;
+  ParticleSet elec;
+
+  ions.setName("ion");
+  std::vector<int> nions(2);
+  nions[0] = 2;
+  nions[1] = 1;
+  ions.create(nions);
+  ions.R[0] = ParticleSet::PosType(0.0, 0.0, 0.0);
+  ions.R[1] = ParticleSet::PosType(2.0, 2.1, 2.4);
+  ions.R[2] = ParticleSet::PosType(1.1, 3.3, -0.6);
+
+  SpeciesSet &ion_species =  ions.getSpeciesSet();
+  int hIdx = ion_species.addSpecies("H");
+  int heIdx = ion_species.addSpecies("He");
+  int pChargeIdx = ion_species.addAttribute("charge");
+  ion_species(pChargeIdx, hIdx) = 1;
+  ion_species(pChargeIdx, heIdx) = 2;
+  ions.Lattice.copy(grid);
+  ions.createSK();
+
+  elec.Lattice.copy(grid);
+  elec.setName("elec");
+  std::vector<int> ud(2);
+  ud[0] = ud[1] = 2;
+  elec.create(ud);
+  for (int i = 0; i < elec.getTotalNum(); i++)
+    elec.R[i] = ParticleSet::PosType(0.3+1.1*i, 1.7*std::sin(0.9*i)+0.5, 0.6*i*i-1.0);
+
+  SpeciesSet &tspecies =  elec.getSpeciesSet();
+  int upIdx = tspecies.addSpecies("u");
+  int downIdx = tspecies.addSpecies("d");
+  int chargeIdx = tspecies.addAttribute("charge");
+  int massIdx = tspecies.addAttribute("mass");
+  tspecies(chargeIdx, upIdx) = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+  tspecies(massIdx, upIdx) = 1.0;
+  tspecies(massIdx, downIdx) = 1.0;
+
+  elec.createSK();
+
+  elec.addTable(ions,DT_SOA_PREFERRED);
+  ions.update();
+  elec.update();
+
+  CoulombPBCAB cab(ions, elec);
+  CoulombPBCAB cab_mesh(ions, elec, false, true);
+  REQUIRE(cab_mesh.UseMesh);
+  REQUIRE(cab_mesh.evalLR(elec) == Approx(cab.evalLR(elec)).epsilon(1e-6));
+  REQUIRE(cab_mesh.evaluate(elec) == Approx(cab.evaluate(elec)).epsilon(1e-6));
+}
+
+TEST_CASE("Coulomb PBC A-B crowd", "[hamiltonian]")
+{
+
+  LRCoulombSingleton::CoulombHandler = 0;
+
+  OHMMS::Controller->initialize(0, NULL);
+
+  Uniform3DGridLayout grid;
+  grid.BoxBConds = true; // periodic
+  grid.R(0,0) = 4.0; grid.R(0,1) = 0.5; grid.R(0,2) = 0.0;
+  grid.R(1,0) = 0.0; grid.R(1,1) = 4.5; grid.R(1,2) = 0.3;
+  grid.R(2,0) = 0.7; grid.R(2,1) = 0.0; grid.R(2,2) = 5.0;
+  grid.reset();
+
+  ParticleSet ions;
+  ParticleSet elec;
+
+  ions.setName("ion");
+  std::vector<int> nions(2);
+  nions[0] = 2;
+  nions[1] = 1;
+  ions.create(nions);
+  ions.R[0] = ParticleSet::PosType(0.0, 0.0, 0.0);
+  ions.R[1] = ParticleSet::PosType(2.0, 2.1, 2.4);
+  ions.R[2] = ParticleSet::PosType(1.1, 3.3, -0.6);
+
+  SpeciesSet &ion_species =  ions.getSpeciesSet();
+  int hIdx = ion_species.addSpecies("H");
+  int heIdx = ion_species.addSpecies("He");
+  int pChargeIdx = ion_species.addAttribute("charge");
+  ion_species(pChargeIdx, hIdx) = 1;
+  ion_species(pChargeIdx, heIdx) = 2;
+  ions.Lattice.copy(grid);
+  ions.createSK();
+
+  elec.Lattice.copy(grid);
+  elec.setName("elec");
+  std::vector<int> ud(2);
+  ud[0] = ud[1] = 2;
+  elec.create(ud);
+
+  SpeciesSet &tspecies =  elec.getSpeciesSet();
+  int upIdx = tspecies.addSpecies("u");
+  int downIdx = tspecies.addSpecies("d");
+  int chargeIdx = tspecies.addAttribute("charge");
+  int massIdx = tspecies.addAttribute("mass");
+  tspecies(chargeIdx, upIdx) = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+  tspecies(massIdx, upIdx) = 1.0;
+  tspecies(massIdx, downIdx) = 1.0;
+
+  elec.createSK();
+  elec.addTable(ions,DT_SOA_PREFERRED);
+  ions.update();
+
+  // a Hamiltonian per walker, as the clones of a driver
+  const int nw = 3;
+  std::vector<ParticleSet*> P_list(nw);
+  std::vector<QMCHamiltonian*> H_list(nw);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    ParticleSet& P = *(P_list[iw] = new ParticleSet(elec));
+    for (int i = 0; i < P.getTotalNum(); i++)
+    {
+      P.R[i] = ParticleSet::PosType(0.3+1.1*i, 1.7*std::sin(0.9*i+iw)+0.5, 0.6*i*i-1.0+0.3*iw);
+      P.G[i] = ParticleSet::GradType(0.1*i, -0.2*iw, 0.3);
+      P.L[i] = -0.4*i-iw;
+    }
+    H_list[iw] = new QMCHamiltonian;
+    H_list[iw]->addOperator(new BareKineticEnergy<double>(P), "Kinetic");
+    H_list[iw]->addOperator(new CoulombPBCAA(P, true), "ElecElec");
+    H_list[iw]->addOperator(new CoulombPBCAB(ions, P), "IonElec");
+    H_list[iw]->addObservables(P);
+    P.update();
+  }
+
+  std::vector<QMCHamiltonian::Return_t> energies;
+  QMCHamiltonian::mw_evaluate(H_list, P_list, energies);
+  REQUIRE(energies.size() == nw);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    ParticleSet& P = *P_list[iw];
+    REQUIRE(P.PropertyList[LOCALENERGY] == energies[iw]);
+    std::vector<double> obs(H_list[iw]->sizeOfObservables());
+    for (int i = 0; i < obs.size(); i++)
+      obs[i] = H_list[iw]->getObservable(i);
+    REQUIRE(H_list[iw]->evaluate(P) == Approx(energies[iw]));
+    for (int i = 0; i < obs.size(); i++)
+      REQUIRE(H_list[iw]->getObservable(i) == Approx(obs[i]));
+    delete H_list[iw];
+    delete P_list[iw];
+  }
+}
+
 TEST_CASE("Coulomb PBC A-B BCC H", "[hamiltonian]")
 {
 
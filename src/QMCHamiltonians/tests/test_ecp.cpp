@@ -16,6 +16,9 @@
 #include "Configuration.h"
 #include "Numerics/Quadrature.h"
 #include "QMCHamiltonians/ECPComponentBuilder.h"
+#include "QMCHamiltonians/NonLocalECPotential.h"
+#include "QMCWaveFunctions/TrialWaveFunction.h"
+#include "Particle/ParticleSet.h"
 
 namespace qmcplusplus
 {
@@ -103,4 +106,96 @@ TEST_CASE("ReadFileBuffer_reopen","[hamiltonian]")
   REQUIRE(buf.length > 14);
 }
 
+TEST_CASE("NonLocalECPotential mw_evaluate","[hamiltonian]")
+{
+  OHMMS::Controller->initialize(0, NULL);
+  Communicate *c = OHMMS::Controller;
+
+  ParticleSet ions;
+  ions.setName("ion0");
+  // create(int) leaves GroupID unset, the pseudopotential is added by group
+  std::vector<int> ion_groups(1, 2);
+  ions.create(ion_groups);
+  ions.R[0] = 0.0;
+  ions.R[1][0] = 1.5;
+  ions.R[1][1] = 0.0;
+  ions.R[1][2] = 0.0;
+  SpeciesSet &ion_species = ions.getSpeciesSet();
+  int pIdx = ion_species.addSpecies("C");
+  int pChargeIdx = ion_species.addAttribute("charge");
+  ion_species(pChargeIdx, pIdx) = 4;
+  // the ion positions are copied to RSoA only when the ions own a SoA table
+  ions.addTable(ions, DT_SOA_PREFERRED);
+  ions.update();
+
+  // two walkers in different configurations
+  ParticleSet elec[2];
+  for (int iw = 0; iw < 2; iw++)
+  {
+    elec[iw].setName("e");
+    std::vector<int> agroup(2, 2);
+    elec[iw].create(agroup);
+    for (int iel = 0; iel < elec[iw].getTotalNum(); iel++)
+    {
+      elec[iw].R[iel][0] = 0.4 * iel - 0.1 * iw;
+      elec[iw].R[iel][1] = 0.3 - 0.2 * iel + 0.15 * iw;
+      elec[iw].R[iel][2] = 0.1 * iel * iw - 0.2;
+    }
+    SpeciesSet &tspecies = elec[iw].getSpeciesSet();
+    int upIdx = tspecies.addSpecies("u");
+    int downIdx = tspecies.addSpecies("d");
+    int chargeIdx = tspecies.addAttribute("charge");
+    tspecies(chargeIdx, upIdx) = -1;
+    tspecies(chargeIdx, downIdx) = -1;
+  }
+
+  ECPComponentBuilder ecp("test_mw_ecp",c);
+  bool okay = ecp.read_pp_file("C.BFD.xml");
+  REQUIRE(okay);
+  REQUIRE(ecp.pp_nonloc != NULL);
+
+  TrialWaveFunction psi(c);
+  NonLocalECPotential nlpp(ions, elec[0], psi, false, false);
+  nlpp.add(pIdx, ecp.pp_nonloc);
+
+  TrialWaveFunction psi_w(c);
+  std::vector<QMCHamiltonianBase*> O_list(2);
+  std::vector<ParticleSet*> P_list(2);
+  for (int iw = 0; iw < 2; iw++)
+  {
+    O_list[iw] = nlpp.makeClone(elec[iw], psi_w);
+    P_list[iw] = &elec[iw];
+    elec[iw].update();
+  }
+
+  // the quadrature grids of both paths are rotated with the same random numbers
+  std::vector<RandomGenerator_t> rng(2), rng_ref(2);
+  for (int iw = 0; iw < 2; iw++)
+  {
+    rng_ref[iw] = rng[iw];
+    O_list[iw]->setRandomGenerator(&rng[iw]);
+  }
+
+  std::vector<QMCHamiltonianBase::Return_t> values(2);
+  O_list[0]->mw_evaluate(O_list, P_list, values);
+  std::vector<long> work(2);
+  for (int iw = 0; iw < 2; iw++)
+  {
+    REQUIRE(O_list[iw]->Value == Approx(values[iw]));
+    work[iw] = O_list[iw]->WorkUnits;
+  }
+  // electrons within the cutoff of the ions
+  REQUIRE(work[0] > 0);
+  REQUIRE(values[0] != Approx(values[1]));
+
+  for (int iw = 0; iw < 2; iw++)
+  {
+    O_list[iw]->setRandomGenerator(&rng_ref[iw]);
+    QMCHamiltonianBase::Return_t v = O_list[iw]->evaluate(elec[iw]);
+    REQUIRE(v == Approx(values[iw]));
+    REQUIRE(O_list[iw]->WorkUnits == work[iw]);
+    delete O_list[iw];
+  }
+}
+
 }
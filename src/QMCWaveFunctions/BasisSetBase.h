@@ -147,6 +147,15 @@ struct RealBasisSetBase
   typedef VectorSoaContainer<T,OHMMS_DIM+2> vgl_type;
   ///size of the basis set
   int BasisSetSize;
+  ///if true, evaluateV and evaluateVGL fill SignificantRanges
+  bool Screening;
+  /** [first,last) ranges of the basis functions above the cutoff for the last evaluated particle
+   *
+   * The basis functions outside these ranges are negligible.
+   */
+  std::vector<std::pair<int,int> > SignificantRanges;
+
+  RealBasisSetBase(): BasisSetSize(0), Screening(false) { }
 
   inline int getBasisSetSize()
   {
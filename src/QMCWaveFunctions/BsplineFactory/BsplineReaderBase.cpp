@@ -25,7 +25,10 @@
 namespace qmcplusplus
 {
   BsplineReaderBase::BsplineReaderBase(EinsplineSetBuilder* e)
-    : mybuilder(e), MeshSize(0), myFirstSPO(0), myNumOrbs(0), checkNorm(true)
+    : mybuilder(e), MeshSize(0), myFirstSPO(0), myNumOrbs(0), checkNorm(true),
+      compressTable(false), compressionTolerance(1.0e-4),
+      reduceSymmetry(false), symmetryTolerance(1.0e-6),
+      tuneHybrid(false), hybridTolerance(1.0e-3)
   {
     myComm=mybuilder->getCommunicator();
   }
@@ -84,8 +87,17 @@ namespace qmcplusplus
   {
     // check orbital normalization by default
     std::string check_orb_norm("yes");
+    std::string compression("no");
+    std::string symmetry("no");
+    std::string hybrid_tuning("no");
     OhmmsAttributeSet a;
     a.add(check_orb_norm,"check_orb_norm");
+    a.add(compression,"compression");
+    a.add(compressionTolerance,"compression_tolerance");
+    a.add(symmetry,"symmetry");
+    a.add(symmetryTolerance,"symmetry_tolerance");
+    a.add(hybrid_tuning,"hybrid_tuning");
+    a.add(hybridTolerance,"hybrid_tolerance");
     a.put(cur);
 
     // allow user to turn off norm check with a warning
@@ -94,6 +106,21 @@ namespace qmcplusplus
       app_log() << "WARNING: disable orbital normalization check!" << std::endl;
       checkNorm = false;
     }
+
+    if (compression == "int16")
+      compressTable = true;
+    else if (compression != "no")
+      APP_ABORT("BsplineReaderBase::setCommon unknown compression=\"" + compression + "\". Use \"no\" or \"int16\".");
+
+    if (symmetry == "yes")
+      reduceSymmetry = true;
+    else if (symmetry != "no")
+      APP_ABORT("BsplineReaderBase::setCommon unknown symmetry=\"" + symmetry + "\". Use \"no\" or \"yes\".");
+
+    if (hybrid_tuning == "yes")
+      tuneHybrid = true;
+    else if (hybrid_tuning != "no")
+      APP_ABORT("BsplineReaderBase::setCommon unknown hybrid_tuning=\"" + hybrid_tuning + "\". Use \"no\" or \"yes\".");
   }
 
   SPOSet* BsplineReaderBase::create_spline_set(int spin, xmlNodePtr cur)
@@ -47,6 +47,18 @@ struct BsplineReaderBase
   int myNumOrbs;
   ///check the norm of orbitals
   bool checkNorm;
+  ///store the spline coefficients as scaled 16-bit integers
+  bool compressTable;
+  ///largest relative error of the orbital values accepted for the compressed table
+  double compressionTolerance;
+  ///store only the irreducible wedge of the table
+  bool reduceSymmetry;
+  ///relative tolerance on the spline coefficients to accept a symmetry operation
+  double symmetryTolerance;
+  ///choose the atomic regions and the 3D mesh of the hybrid representation
+  bool tuneHybrid;
+  ///largest relative error of the orbital values accepted by the hybrid tuning
+  double hybridTolerance;
   ///map from spo index to band index
   std::vector<std::vector<int> > spo2band;
 
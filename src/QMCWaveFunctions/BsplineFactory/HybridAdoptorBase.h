@@ -54,12 +54,15 @@ struct AtomicOrbitalSoA
   MultiBspline1D<ST>* SplineInst;
 
   vContainer_type localV, localG, localL;
+  ///weights of the 4 coefficient rows of each lm, for V, Gx, Gy, Gz and L
+  vContainer_type row_weights;
 
   AtomicOrbitalSoA(int Lmax):
   Ylm(Lmax), MultiSpline(nullptr), SplineInst(nullptr), lmax(Lmax),
   lm_tot((Lmax+1)*(Lmax+1))
   {
     r_power_minus_l.resize(lm_tot);
+    row_weights.resize(lm_tot*20);
     l_vals.resize(lm_tot);
     for(int l=0; l<=lmax; l++)
       for(int m=-l; m<=l; m++)
@@ -162,6 +165,80 @@ struct AtomicOrbitalSoA
     return success;
   }
 
+  /** contract the radial coefficients of all the orbitals, values only
+   * @param coefs first coefficient row of the cell
+   * @param w weights of the rows, 4 per lm
+   * @param val output
+   * @param n number of orbitals
+   *
+   * The radial functions are never stored. The orbitals are processed in blocks
+   * and the partial sums of a block stay in L1 along the lm loop.
+   */
+  inline void contract_v(const ST* restrict coefs, const ST* restrict w, ST* restrict val, size_t n) const
+  {
+    const intptr_t xs=SplineInst->spline_m.x_stride;
+    const size_t block=128;
+    std::fill(val,val+n,ST(0));
+    for(size_t ib_first=0; ib_first<n; ib_first+=block)
+    {
+      const size_t ib_last=std::min(ib_first+block,n);
+      for(size_t lm=0; lm<lm_tot; lm++)
+      {
+        const ST* restrict c0=coefs+lm*Npad;
+        const ST* restrict c1=c0+xs;
+        const ST* restrict c2=c0+2*xs;
+        const ST* restrict c3=c0+3*xs;
+        const ST* restrict wlm=w+lm*4;
+        const ST w0=wlm[0], w1=wlm[1], w2=wlm[2], w3=wlm[3];
+        #pragma omp simd
+        for(size_t ib=ib_first; ib<ib_last; ib++)
+          val[ib]+=w0*c0[ib]+w1*c1[ib]+w2*c2[ib]+w3*c3[ib];
+      }
+    }
+  }
+
+  /** contract the radial coefficients of all the orbitals, VGL
+   * @param coefs first coefficient row of the cell
+   * @param w weights of the rows, 20 per lm ordered as V, Gx, Gy, Gz and L
+   * @param n number of orbitals
+   */
+  inline void contract_vgl(const ST* restrict coefs, const ST* restrict w, ST* restrict val,
+                           ST* restrict g0, ST* restrict g1, ST* restrict g2, ST* restrict lapl, size_t n) const
+  {
+    const intptr_t xs=SplineInst->spline_m.x_stride;
+    const size_t block=128;
+    std::fill(val,val+n,ST(0));
+    std::fill(g0,g0+Npad,ST(0));
+    std::fill(g1,g1+Npad,ST(0));
+    std::fill(g2,g2+Npad,ST(0));
+    std::fill(lapl,lapl+n,ST(0));
+    for(size_t ib_first=0; ib_first<n; ib_first+=block)
+    {
+      const size_t ib_last=std::min(ib_first+block,n);
+      for(size_t lm=0; lm<lm_tot; lm++)
+      {
+        const ST* restrict c0=coefs+lm*Npad;
+        const ST* restrict c1=c0+xs;
+        const ST* restrict c2=c0+2*xs;
+        const ST* restrict c3=c0+3*xs;
+        const ST* restrict wlm=w+lm*20;
+        #pragma omp simd
+        for(size_t ib=ib_first; ib<ib_last; ib++)
+        {
+          const ST coef_0=c0[ib];
+          const ST coef_1=c1[ib];
+          const ST coef_2=c2[ib];
+          const ST coef_3=c3[ib];
+          val[ib] +=wlm[ 0]*coef_0+wlm[ 1]*coef_1+wlm[ 2]*coef_2+wlm[ 3]*coef_3;
+          g0[ib]  +=wlm[ 4]*coef_0+wlm[ 5]*coef_1+wlm[ 6]*coef_2+wlm[ 7]*coef_3;
+          g1[ib]  +=wlm[ 8]*coef_0+wlm[ 9]*coef_1+wlm[10]*coef_2+wlm[11]*coef_3;
+          g2[ib]  +=wlm[12]*coef_0+wlm[13]*coef_1+wlm[14]*coef_2+wlm[15]*coef_3;
+          lapl[ib]+=wlm[16]*coef_0+wlm[17]*coef_1+wlm[18]*coef_2+wlm[19]*coef_3;
+        }
+      }
+    }
+  }
+
   //evaluate only V
   template<typename VV>
   inline void evaluate_v(const ST& r, const PointType& dr, VV& myV)
@@ -172,20 +249,14 @@ struct AtomicOrbitalSoA
       Ylm.evaluateV(0,0,1);
     const ST* restrict Ylm_v=Ylm[0];
 
-    constexpr ST czero(0);
-    ST* restrict val=myV.data();
-    ST* restrict local_val=localV.data();
-    std::fill(myV.begin(),myV.end(),czero);
-
-    SplineInst->evaluate(r,localV);
-
+    ST a[4];
+    const ST* restrict coefs=SplineInst->prefactors(r,a);
+    ST* restrict w=row_weights.data();
     for(size_t lm=0; lm<lm_tot; lm++)
-    {
-      #pragma omp simd aligned(val,local_val)
-      for(size_t ib=0; ib<myV.size(); ib++)
-        val[ib]+=Ylm_v[lm]*local_val[ib];
-      local_val+=Npad;
-    }
+      for(int i=0; i<4; i++)
+        w[lm*4+i]=Ylm_v[lm]*a[i];
+
+    contract_v(coefs,w,myV.data(),myV.size());
   }
 
   template<typename DISPL, typename VM>
@@ -250,23 +321,16 @@ struct AtomicOrbitalSoA
     ST* restrict g0=myG.data(0);
     ST* restrict g1=myG.data(1);
     ST* restrict g2=myG.data(2);
-    constexpr ST czero(0), cone(1), chalf(0.5);
-    std::fill(myV.begin(),myV.end(),czero);
-    std::fill(g0,g0+Npad,czero);
-    std::fill(g1,g1+Npad,czero);
-    std::fill(g2,g2+Npad,czero);
-    std::fill(myL.begin(),myL.end(),czero);
+    constexpr ST czero(0), cone(1), chalf(0.5), ctwo(2);
     ST* restrict val=myV.data();
     ST* restrict lapl=myL.data();
-    ST* restrict local_val=localV.data();
-    ST* restrict local_grad=localG.data();
-    ST* restrict local_lapl=localL.data();
-
-    SplineInst->evaluate_vgl(r,localV,localG,localL);
 
     if(r>rmin_sqrt)
     {
-      // far from core
+      // far from core, the radial functions are contracted on the fly
+      ST a[4], da[4], d2a[4];
+      const ST* restrict coefs=SplineInst->prefactors(r,a,da,d2a);
+
       r_power_minus_l[0]=cone;
       ST r_power_temp=cone;
       for(int l=1; l<=lmax; l++)
@@ -276,40 +340,52 @@ struct AtomicOrbitalSoA
           r_power_minus_l[lm]=r_power_temp;
       }
 
+      // V, G and L are linear in the radial value v, gradient g and laplacian l
+      ST* restrict w=row_weights.data();
       for(size_t lm=0; lm<lm_tot; lm++)
       {
         const ST& l_val=l_vals[lm];
         const ST& r_power=r_power_minus_l[lm];
         const ST Ylm_rescale=Ylm_v[lm]*r_power;
         const ST rhat_dot_G = ( rhatx*Ylm_gx[lm] + rhaty*Ylm_gy[lm] + rhatz*Ylm_gz[lm] ) * r_power;
-        #pragma omp simd aligned(val,g0,g1,g2,lapl,local_val,local_grad,local_lapl)
-        for(size_t ib=0; ib<myV.size(); ib++)
+        const ST Vpart = l_val*rinv*Ylm_rescale;
+        // factors of v and g in the gradient
+        const ST gx_v = r_power*Ylm_gx[lm] - Vpart*rhatx;
+        const ST gy_v = r_power*Ylm_gy[lm] - Vpart*rhaty;
+        const ST gz_v = r_power*Ylm_gz[lm] - Vpart*rhatz;
+        const ST gx_g = Ylm_rescale*rhatx;
+        const ST gy_g = Ylm_rescale*rhaty;
+        const ST gz_g = Ylm_rescale*rhatz;
+        // factors of v and g in the laplacian, l comes with Ylm_rescale
+        const ST l_v = -Vpart*rinv - l_val*rinv*rhat_dot_G;
+        const ST l_g = ( ctwo - l_val )*rinv*Ylm_rescale + rhat_dot_G;
+        ST* restrict wlm=w+lm*20;
+        for(int i=0; i<4; i++)
         {
-          const ST local_v=local_val[ib];
-          const ST local_g=local_grad[ib];
-          const ST local_l=local_lapl[ib];
-          // value
-          const ST Vpart = l_val*rinv*local_v;
-          val[ib] += Ylm_rescale*local_v;
-
-          // grad
-          const ST factor1 = local_g*Ylm_rescale;
-          const ST factor2 = local_v*r_power;
-          const ST factor3 = -Vpart*Ylm_rescale;
-          g0[ib] += factor1 * rhatx + factor2 * Ylm_gx[lm] + factor3 * rhatx;
-          g1[ib] += factor1 * rhaty + factor2 * Ylm_gy[lm] + factor3 * rhaty;
-          g2[ib] += factor1 * rhatz + factor2 * Ylm_gz[lm] + factor3 * rhatz;
-
-          // laplacian
-          lapl[ib] += (local_l + ( local_g * ( 2 - l_val ) - Vpart ) * rinv) * Ylm_rescale
-                    + (local_g - Vpart ) * rhat_dot_G;
+          wlm[i]    = Ylm_rescale*a[i];
+          wlm[4+i]  = gx_v*a[i] + gx_g*da[i];
+          wlm[8+i]  = gy_v*a[i] + gy_g*da[i];
+          wlm[12+i] = gz_v*a[i] + gz_g*da[i];
+          wlm[16+i] = l_v*a[i] + l_g*da[i] + Ylm_rescale*d2a[i];
         }
-        local_val+=Npad;
-        local_grad+=Npad;
-        local_lapl+=Npad;
       }
+
+      contract_vgl(coefs,w,val,g0,g1,g2,lapl,myV.size());
+      return;
     }
-    else if(r>rmin)
+
+    std::fill(myV.begin(),myV.end(),czero);
+    std::fill(g0,g0+Npad,czero);
+    std::fill(g1,g1+Npad,czero);
+    std::fill(g2,g2+Npad,czero);
+    std::fill(myL.begin(),myL.end(),czero);
+    ST* restrict local_val=localV.data();
+    ST* restrict local_grad=localG.data();
+    ST* restrict local_lapl=localL.data();
+
+    SplineInst->evaluate_vgl(r,localV,localG,localL);
+
+    if(r>rmin)
     {
       // the possibility of reaching here is very very low
       std::cout << "Warning: an electron is very close to an ion, distance=" << r << " be careful!" << std::endl;
@@ -167,7 +167,7 @@ struct HybridCplxSoA: public BaseAdoptor, public HybridAdoptorBase<typename Base
 
   inline size_t estimateMemory(const int nP)
   {
-    return BaseAdoptor::estimateMemory(nP)+myV.size()*sizeof(ST)/sizeof(ValueType)*nP;
+    return myV.size()*sizeof(ST)/sizeof(ValueType)*nP;
   }
 
   template<typename VV, typename GV>
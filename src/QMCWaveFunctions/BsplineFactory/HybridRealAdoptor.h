@@ -170,7 +170,7 @@ struct HybridRealSoA: public BaseAdoptor, public HybridAdoptorBase<typename Base
 
   inline size_t estimateMemory(const int nP)
   {
-    return BaseAdoptor::estimateMemory(nP)+myV.size()*sizeof(ST)/sizeof(ValueType)*nP;
+    return myV.size()*sizeof(ST)/sizeof(ValueType)*nP;
   }
 
   template<typename VV, typename GV>
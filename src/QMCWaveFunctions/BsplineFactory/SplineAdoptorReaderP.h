@@ -66,6 +66,11 @@ struct SplineAdoptorReader: public BsplineReaderBase
     FFTplan=NULL;
   }
 
+  // choose the parameters of Hybrid
+  virtual void tune_hybridrep(int spin, const BandInfoGroup& bandgroup)
+  {
+    app_warning() << "  hybrid_tuning is only used by the hybrid orbital representation. Ignored." << std::endl;
+  }
   // set info for Hybrid
   virtual void initialize_hybridrep_atomic_centers() {}
   // transform cG to radial functions
@@ -73,6 +78,10 @@ struct SplineAdoptorReader: public BsplineReaderBase
 
   void export_MultiSpline(multi_UBspline_3d_z** target)
   {
+    if(bspline->SplineInst->spline_c)
+      APP_ABORT("SplineAdoptorReader::export_MultiSpline the table is compressed. Set compression=\"no\".");
+    if(bspline->SplineInst->symmetry)
+      APP_ABORT("SplineAdoptorReader::export_MultiSpline the table is symmetry reduced. Set symmetry=\"no\".");
     *target = new multi_UBspline_3d_z;
     multi_UBspline_3d_d* source_MultiSpline = (multi_UBspline_3d_d*) bspline->MultiSpline;
 
@@ -125,6 +134,10 @@ struct SplineAdoptorReader: public BsplineReaderBase
 
   void export_MultiSpline(multi_UBspline_3d_d** target)
   {
+    if(bspline->SplineInst->spline_c)
+      APP_ABORT("SplineAdoptorReader::export_MultiSpline the table is compressed. Set compression=\"no\".");
+    if(bspline->SplineInst->symmetry)
+      APP_ABORT("SplineAdoptorReader::export_MultiSpline the table is symmetry reduced. Set symmetry=\"no\".");
     *target = (multi_UBspline_3d_d*) bspline->MultiSpline;
   }
 
@@ -143,6 +156,7 @@ struct SplineAdoptorReader: public BsplineReaderBase
       app_log() << "  Can use SoA implementation for mGL" << std::endl;
 
     // set info for Hybrid
+    if(tuneHybrid) this->tune_hybridrep(spin,bandgroup);
     this->initialize_hybridrep_atomic_centers();
 
     //baseclass handles twists
@@ -244,10 +258,62 @@ struct SplineAdoptorReader: public BsplineReaderBase
       }
     }
 
+    if(reduceSymmetry) reduce_table_symmetry();
+    if(compressTable) compress_table();
+
     clear();
     return bspline;
   }
 
+  /** keep only the irreducible wedge of the table
+   *
+   * The symmetry is detected on the spline coefficients, see MultiBsplineSymmetry.
+   */
+  void reduce_table_symmetry()
+  {
+    Timer now;
+    MultiBspline<DataType>* SplineInst=bspline->SplineInst;
+    size_t full_size=SplineInst->sizeInByte();
+    int order=SplineInst->reduce_symmetry(symmetryTolerance);
+    bspline->MultiSpline=SplineInst->spline_m;
+    app_log() << "  SplineAdoptorReader symmetry reduction " << now.elapsed() << " sec" << std::endl;
+    if(order==1)
+    {
+      app_log() << "  No symmetry shared by all the orbitals. Keep the full table." << std::endl;
+      return;
+    }
+    qmc_common.memory_allocated -= full_size-SplineInst->sizeInByte();
+    app_log() << "  Table reduced by " << order << " symmetry operations from " << (full_size>>20) << " MB to "
+              << (SplineInst->sizeInByte()>>20) << " MB" << std::endl;
+  }
+
+  /** replace the full precision table by the 16-bit table
+   *
+   * The compressed table is kept only if the relative error of the values
+   * stays below compressionTolerance.
+   */
+  void compress_table()
+  {
+    Timer now;
+    MultiBspline<DataType>* SplineInst=bspline->SplineInst;
+    MultiBsplineCompressed<DataType>* compressed=new MultiBsplineCompressed<DataType>(SplineInst->spline_m);
+    double err=spline2::compression_error(SplineInst->spline_m,compressed);
+    app_log() << "  SplineAdoptorReader compress the table " << now.elapsed() << " sec" << std::endl;
+    app_log() << "  Relative error of the compressed table = " << err << std::endl;
+    if(err>compressionTolerance)
+    {
+      app_warning() << "  The error of the compressed table exceeds compression_tolerance = "
+                    << compressionTolerance << ". Keep the full precision table." << std::endl;
+      delete compressed;
+      return;
+    }
+    size_t full_size=SplineInst->sizeInByte();
+    SplineInst->adopt_compressed(compressed);
+    qmc_common.memory_allocated -= full_size-SplineInst->sizeInByte();
+    app_log() << "  Table memory reduced from " << (full_size>>20) << " MB to "
+              << (SplineInst->sizeInByte()>>20) << " MB" << std::endl;
+  }
+
   /** fft and spline cG
    * @param cG psi_g to be processed
    * @param ti twist index
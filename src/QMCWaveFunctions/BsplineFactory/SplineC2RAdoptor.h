@@ -80,6 +80,10 @@ struct SplineC2RSoA: public SplineAdoptorBase<ST,3>
   vContainer_type myL;
   gContainer_type myG;
   hContainer_type myH;
+  ///positions of the virtual particles in the unit of PrimLattice
+  std::vector<PointType> multi_ru;
+  ///symmetry operations folding the virtual particles into the reduced table
+  std::vector<int> multi_sym_ops;
 
   SplineC2RSoA(): BaseType(), nComplexBands(0), SplineInst(nullptr), MultiSpline(nullptr)
   {
@@ -245,6 +249,7 @@ struct SplineC2RSoA: public SplineAdoptorBase<ST,3>
   {
     const PointType& r=P.activeR(iat);
     PointType ru(PrimLattice.toUnit_floor(r));
+    const int sym_ops=SplineInst->fold(ru);
 
     #pragma omp parallel
     {
@@ -254,7 +259,11 @@ struct SplineC2RSoA: public SplineAdoptorBase<ST,3>
                         omp_get_thread_num(),
                         first, last);
 
-      spline2::evaluate3d(SplineInst->spline_m,ru,myV,first,last);
+      if(SplineInst->spline_c)
+        spline2::evaluate3d(SplineInst->spline_c,ru,myV,first,last);
+      else
+        spline2::evaluate3d(SplineInst->spline_m,ru,myV,first,last);
+      if(sym_ops) SplineInst->symmetry->unfold_v(sym_ops,myV,first,last);
       assign_v(r,myV,psi,first/2,last/2);
     }
   }
@@ -262,6 +271,17 @@ struct SplineC2RSoA: public SplineAdoptorBase<ST,3>
   template<typename VM, typename VAV>
   inline void evaluateValues(const VirtualParticleSet& VP, VM& psiM, VAV& SPOMem)
   {
+    const int nVP=VP.getTotalNum();
+    Matrix<ST,aligned_allocator<ST> > multi_myV((ST*)SPOMem.data(),nVP,myV.size());
+    multi_ru.resize(nVP);
+    multi_sym_ops.resize(nVP);
+    for(int iat=0; iat<nVP; ++iat)
+    {
+      const PointType& r=VP.activeR(iat);
+      multi_ru[iat]=PrimLattice.toUnit_floor(r);
+      multi_sym_ops[iat]=SplineInst->fold(multi_ru[iat]);
+    }
+
     #pragma omp parallel
     {
       int first, last;
@@ -270,20 +290,23 @@ struct SplineC2RSoA: public SplineAdoptorBase<ST,3>
                         omp_get_thread_num(),
                         first, last);
 
+      if(SplineInst->spline_c)
+        spline2::evaluate3d_multi_pos(SplineInst->spline_c,multi_ru,multi_myV,first,last);
+      else
+        spline2::evaluate3d_multi_pos(SplineInst->spline_m,multi_ru,multi_myV,first,last);
+
       const size_t m=psiM.cols();
-      for(int iat=0; iat<VP.getTotalNum(); ++iat)
+      for(int iat=0; iat<nVP; ++iat)
       {
-        const PointType& r=VP.activeR(iat);
-        PointType ru(PrimLattice.toUnit_floor(r));
         Vector<TT> psi(psiM[iat],m);
-
-        spline2::evaluate3d(SplineInst->spline_m,ru,myV,first,last);
-        assign_v(r,myV,psi,first/2,last/2);
+        vContainer_type myV_one(multi_myV[iat],myV.size());
+        if(multi_sym_ops[iat]) SplineInst->symmetry->unfold_v(multi_sym_ops[iat],myV_one,first,last);
+        assign_v(VP.activeR(iat),myV_one,psi,first/2,last/2);
       }
     }
   }
 
-  inline size_t estimateMemory(const int nP) { return 0; }
+  inline size_t estimateMemory(const int nP) { return myV.size()*sizeof(ST)/sizeof(TT)*nP; }
 
   /** assign_vgl
    */
@@ -534,6 +557,7 @@ struct SplineC2RSoA: public SplineAdoptorBase<ST,3>
   {
     const PointType& r=P.activeR(iat);
     PointType ru(PrimLattice.toUnit_floor(r));
+    const int sym_ops=SplineInst->fold(ru);
 
     #pragma omp parallel
     {
@@ -543,7 +567,11 @@ struct SplineC2RSoA: public SplineAdoptorBase<ST,3>
                         omp_get_thread_num(),
                         first, last);
 
-      spline2::evaluate3d_vgh(SplineInst->spline_m,ru,myV,myG,myH,first,last);
+      if(SplineInst->spline_c)
+        spline2::evaluate3d_vgh(SplineInst->spline_c,ru,myV,myG,myH,first,last);
+      else
+        spline2::evaluate3d_vgh(SplineInst->spline_m,ru,myV,myG,myH,first,last);
+      if(sym_ops) SplineInst->symmetry->unfold_vgh(sym_ops,myV,myG,myH,first,last);
       assign_vgl(r,psi,dpsi,d2psi,first/2,last/2);
     }
   }
@@ -736,6 +764,7 @@ struct SplineC2RSoA: public SplineAdoptorBase<ST,3>
   {
     const PointType& r=P.activeR(iat);
     PointType ru(PrimLattice.toUnit_floor(r));
+    const int sym_ops=SplineInst->fold(ru);
     #pragma omp parallel
     {
       int first, last;
@@ -744,7 +773,11 @@ struct SplineC2RSoA: public SplineAdoptorBase<ST,3>
                         omp_get_thread_num(),
                         first, last);
 
-      spline2::evaluate3d_vgh(SplineInst->spline_m,ru,myV,myG,myH,first,last);
+      if(SplineInst->spline_c)
+        spline2::evaluate3d_vgh(SplineInst->spline_c,ru,myV,myG,myH,first,last);
+      else
+        spline2::evaluate3d_vgh(SplineInst->spline_m,ru,myV,myG,myH,first,last);
+      if(sym_ops) SplineInst->symmetry->unfold_vgh(sym_ops,myV,myG,myH,first,last);
       assign_vgh(r,psi,dpsi,grad_grad_psi,first/2,last/2);
     }
   }
@@ -22,8 +22,10 @@
 #ifndef QMCPLUSPLUS_EINSPLINE_HYBRID_ADOPTOR_READERP_H
 #define QMCPLUSPLUS_EINSPLINE_HYBRID_ADOPTOR_READERP_H
 
+#include <random>
 #include <Numerics/Quadrature.h>
 #include <Numerics/Bessel.h>
+#include <einspline/bspline_eval_d.h>
 #include <QMCWaveFunctions/BsplineFactory/HybridAdoptorBase.h>
 
 //#include <QMCHamiltonians/Ylm.h>
@@ -150,11 +152,366 @@ struct SplineHybridAdoptorReader: public SplineAdoptorReader<SA>
   using BaseReader::mybuilder;
   using BaseReader::rotate_phase_r;
   using BaseReader::rotate_phase_i;
+  using BaseReader::MeshSize;
+  using BaseReader::myComm;
+  using BaseReader::hybridTolerance;
+
+  ///true once the parameters are tuned, they are shared by all the band groups
+  bool hybridTuned;
 
   SplineHybridAdoptorReader(EinsplineSetBuilder* e)
-    : BaseReader(e)
+    : BaseReader(e), hybridTuned(false)
   {}
 
+  /** default radial grid of an atomic region
+   * @param cutoff cutoff radius
+   * @param delta output, grid point distance
+   * @return number of grid points
+   */
+  static int default_spline_npoints(double cutoff, double& delta)
+  {
+    delta = std::min(0.02, cutoff/4.0);
+    return std::ceil((cutoff + 1e-4) / delta) + 3;
+  }
+
+  /** choose the atomic regions and the 3D mesh
+   *
+   * A few bands of the group are transformed on rank 0 and their values are compared
+   * with the plane wave sums. The error is relative to the root mean square of each orbital.
+   * - cutoff_radius and lmax: for each species, the largest radius where the
+   *   radial x Ylm expansion meets hybridTolerance and the smallest lmax reaching it.
+   *   cutoff_radius and lmax given in the input are the upper bounds of the search.
+   * - 3D mesh: the coarsest mesh meeting hybridTolerance outside the inner cutoff of all the atoms.
+   * The tuning works on the periodic part of the orbitals.
+   */
+  void tune_hybridrep(int spin, const BandInfoGroup& bandgroup) override
+  {
+    if(hybridTuned) return;
+    hybridTuned=true;
+
+    Timer now;
+    app_log() << "Tuning hybrid orbital representation to the relative error " << hybridTolerance << std::endl;
+    mybuilder->ReadGvectors_ESHDF();
+    const TinyVector<int,3> mesh_full=(MeshSize[0]==0)?mybuilder->MeshSize:MeshSize;
+    auto& ACInfo=mybuilder->AtomicCentersInfo;
+
+    // sample bands spread over the group
+    const int max_tuning_bands=8;
+    const std::vector<BandInfo>& cur_bands=bandgroup.myBands;
+    const int N=bandgroup.getNumDistinctOrbitals();
+    const int nsamples=std::min(N,max_tuning_bands);
+    std::vector<Vector<std::complex<double> > > cGs(nsamples);
+    for(int is=0; is<nsamples; is++)
+    {
+      const int iorb=(nsamples>1)?is*(N-1)/(nsamples-1):0;
+      cGs[is].resize(mybuilder->Gvecs[0].size());
+      this->get_psi_g(cur_bands[iorb].TwistIndex, spin, cur_bands[iorb].BandIndex, cGs[is]);
+    }
+
+    TinyVector<int,3> mesh_tuned(mesh_full);
+    if(myComm->rank()==0)
+    {
+      tune_atomic_regions(cGs);
+      mesh_tuned=tune_mesh(cGs, mesh_full);
+    }
+    myComm->bcast(ACInfo.cutoff);
+    myComm->bcast(ACInfo.inner_cutoff);
+    myComm->bcast(ACInfo.spline_radius);
+    myComm->bcast(ACInfo.lmax);
+    myComm->bcast(ACInfo.spline_npoints);
+    myComm->bcast(mesh_tuned);
+    MeshSize=mesh_tuned;
+
+    // table size per orbital, in the number of coefficients
+    const double size_full=double(mesh_full[0]+3)*double(mesh_full[1]+3)*double(mesh_full[2]+3);
+    double size_3d=double(MeshSize[0]+3)*double(MeshSize[1]+3)*double(MeshSize[2]+3);
+    double size_atomic=0.0;
+    for(int center_idx=0; center_idx<ACInfo.Ncenters; center_idx++)
+    {
+      if(ACInfo.cutoff[center_idx]<=0) continue;
+      double delta;
+      const int npoints=(ACInfo.spline_npoints[center_idx]>0)?ACInfo.spline_npoints[center_idx]
+                                                             :default_spline_npoints(ACInfo.cutoff[center_idx],delta);
+      size_atomic+=double(npoints+2)*double((ACInfo.lmax[center_idx]+1)*(ACInfo.lmax[center_idx]+1));
+    }
+    app_log() << "  Hybrid tuning mesh " << mesh_full << " -> " << MeshSize << std::endl;
+    app_log() << "  Table size per orbital " << size_full << " -> " << size_3d << " (3D) + "
+              << size_atomic << " (atomic) coefficients, memory saved "
+              << 100.0*(1.0-(size_3d+size_atomic)/size_full) << "%" << std::endl;
+    app_log() << "  Hybrid tuning time " << now.elapsed() << " sec" << std::endl;
+  }
+
+  /** choose cutoff_radius and lmax of each species
+   * @param cGs plane wave coefficients of the sample bands
+   */
+  void tune_atomic_regions(const std::vector<Vector<std::complex<double> > >& cGs)
+  {
+    auto& ACInfo=mybuilder->AtomicCentersInfo;
+    typedef typename EinsplineSetBuilder::UnitCellType UnitCellType;
+    const TinyVector<int,3> no_shift(0);
+    Gvectors<double, UnitCellType> Gvecs(mybuilder->Gvecs[0], mybuilder->PrimCell, no_shift,
+                                         0, mybuilder->Gvecs[0].size());
+    const int max_tuning_lmax=8;
+    const int nr=10;
+    const int nb=cGs.size();
+    Quadrature3D<double> quad(7);
+    const int nk=quad.nk;
+
+    std::vector<double> norms(nb);
+    for(int ib=0; ib<nb; ib++)
+    {
+      double norm2=0.0;
+      for(size_t ig=0; ig<cGs[ib].size(); ig++)
+        norm2+=std::norm(cGs[ib][ig]);
+      norms[ib]=std::sqrt(norm2);
+    }
+
+    std::vector<bool> done(ACInfo.Ncenters,false);
+    for(int center_idx=0; center_idx<ACInfo.Ncenters; center_idx++)
+    {
+      if(done[center_idx]) continue;
+      const int my_GroupID=ACInfo.GroupID[center_idx];
+      for(int id=center_idx; id<ACInfo.Ncenters; id++)
+        if(my_GroupID==ACInfo.GroupID[id]) done[id]=true;
+
+      const double rmax=(ACInfo.cutoff[center_idx]>0)?ACInfo.cutoff[center_idx]:ACInfo.non_overlapping_radius[center_idx];
+      const int lcap=(ACInfo.lmax[center_idx]>=0)?ACInfo.lmax[center_idx]:max_tuning_lmax;
+      const int lm_tot=(lcap+1)*(lcap+1);
+      const TinyVector<double,3> center=ACInfo.ion_pos[center_idx];
+
+      // c_lm(r_k) = 4 pi i^l sum_G cG exp(iG.R) j_l(|G|r_k) Y_lm(G), the same expansion as create_atomic_centers_Gspace
+      std::vector<std::complex<double> > clm(nb*nr*lm_tot,std::complex<double>());
+      #pragma omp parallel
+      {
+        std::vector<std::complex<double> > clm_local(clm.size(),std::complex<double>());
+        std::vector<std::complex<double> > phased(nb);
+        aligned_vector<double> j_lm_G(lm_tot);
+        aligned_vector<double> YlmG(lm_tot);
+        SoaSphericalTensor<double> Ylm(lcap);
+        #pragma omp for
+        for(size_t ig=0; ig<Gvecs.NumGvecs; ig++)
+        {
+          Gvecs.calc_Ylm_G(ig, Ylm, YlmG);
+          double s, c;
+          sincos(dot(Gvecs.gvecs_cart[ig],center),&s,&c);
+          for(int ib=0; ib<nb; ib++)
+            phased[ib]=cGs[ib][ig]*std::complex<double>(c,s);
+          for(int k=0; k<nr; k++)
+          {
+            double r=rmax*(k+1)/nr;
+            Gvecs.calc_jlm_G(lcap, r, ig, j_lm_G);
+            for(int lm=0; lm<lm_tot; lm++)
+              j_lm_G[lm]*=YlmG[lm];
+            for(int ib=0; ib<nb; ib++)
+            {
+              std::complex<double>* restrict out=clm_local.data()+(ib*nr+k)*lm_tot;
+              for(int lm=0; lm<lm_tot; lm++)
+                out[lm]+=phased[ib]*j_lm_G[lm];
+            }
+          }
+        }
+        #pragma omp critical
+        for(size_t i=0; i<clm.size(); i++)
+          clm[i]+=clm_local[i];
+      }
+      std::complex<double> i_power(4.0*M_PI,0.0);
+      for(int l=0; l<=lcap; l++)
+      {
+        for(int ib=0; ib<nb; ib++)
+          for(int k=0; k<nr; k++)
+            for(int lm=l*l; lm<(l+1)*(l+1); lm++)
+              clm[(ib*nr+k)*lm_tot+lm]*=i_power;
+        i_power*=std::complex<double>(0.0,1.0);
+      }
+
+      // err(k,L): largest error at r_k on the quadrature points truncating at L
+      Matrix<double> err(nr,lcap+1);
+      err=0.0;
+      #pragma omp parallel
+      {
+        SoaSphericalTensor<double> Ylm(lcap);
+        Matrix<double> err_local(nr,lcap+1);
+        err_local=0.0;
+        #pragma omp for collapse(2)
+        for(int k=0; k<nr; k++)
+          for(int iq=0; iq<nk; iq++)
+          {
+            const double r=rmax*(k+1)/nr;
+            const TinyVector<double,3> pos=center+r*quad.xyz_m[iq];
+            Ylm.evaluateV(quad.xyz_m[iq][0], quad.xyz_m[iq][1], quad.xyz_m[iq][2]);
+            const double* restrict Ylm_v=Ylm[0];
+            for(int ib=0; ib<nb; ib++)
+            {
+              const std::complex<double> exact=Gvecs.evaluate_psi_r(cGs[ib], pos);
+              const std::complex<double>* restrict c=clm.data()+(ib*nr+k)*lm_tot;
+              std::complex<double> approx;
+              for(int l=0; l<=lcap; l++)
+              {
+                for(int lm=l*l; lm<(l+1)*(l+1); lm++)
+                  approx+=c[lm]*Ylm_v[lm];
+                err_local(k,l)=std::max(err_local(k,l),std::abs(exact-approx)/norms[ib]);
+              }
+            }
+          }
+        #pragma omp critical
+        for(int k=0; k<nr; k++)
+          for(int l=0; l<=lcap; l++)
+            err(k,l)=std::max(err(k,l),err_local(k,l));
+      }
+
+      // the largest radius within the tolerance and then the smallest lmax
+      int k_tuned=-1;
+      while(k_tuned+1<nr && err(k_tuned+1,lcap)<=hybridTolerance) k_tuned++;
+      double cutoff=0.0;
+      int lmax=0;
+      if(k_tuned<0)
+        app_warning() << "  Hybrid tuning cannot reach the tolerance with lmax=" << lcap
+                      << " for group " << my_GroupID << ". No atomic regions are used." << std::endl;
+      else
+      {
+        cutoff=rmax*(k_tuned+1)/nr;
+        double max_err;
+        for(lmax=0; lmax<=lcap; lmax++)
+        {
+          max_err=0.0;
+          for(int k=0; k<=k_tuned; k++)
+            max_err=std::max(max_err,err(k,lmax));
+          if(max_err<=hybridTolerance) break;
+        }
+        app_log() << "  Hybrid tuning group " << my_GroupID << " cutoff_radius=" << cutoff
+                  << " lmax=" << lmax << " error=" << max_err << std::endl;
+      }
+
+      for(int id=0; id<ACInfo.Ncenters; id++)
+        if(my_GroupID==ACInfo.GroupID[id])
+        {
+          ACInfo.cutoff[id]=cutoff;
+          ACInfo.lmax[id]=lmax;
+          if(ACInfo.inner_cutoff[id]>cutoff) ACInfo.inner_cutoff[id]=-1.0;
+          // keep the input radial grid only if it still covers the cutoff
+          if(ACInfo.spline_radius[id]>0 && ACInfo.spline_npoints[id]>1 &&
+             cutoff>ACInfo.spline_radius[id]-2.0*ACInfo.spline_radius[id]/(ACInfo.spline_npoints[id]-1))
+          {
+            ACInfo.spline_radius[id]=-1.0;
+            ACInfo.spline_npoints[id]=-1;
+          }
+        }
+    }
+  }
+
+  /** choose the coarsest 3D mesh
+   * @param cGs plane wave coefficients of the sample bands
+   * @param mesh_full mesh from the FFT grid and meshfactor, the finest candidate
+   * @return the tuned mesh
+   */
+  TinyVector<int,3> tune_mesh(const std::vector<Vector<std::complex<double> > >& cGs, const TinyVector<int,3>& mesh_full)
+  {
+    auto& ACInfo=mybuilder->AtomicCentersInfo;
+    typedef typename EinsplineSetBuilder::UnitCellType UnitCellType;
+    const UnitCellType& PrimCell=mybuilder->PrimCell;
+    TinyVector<int,3> no_shift(0);
+    Gvectors<double, UnitCellType> Gvecs(mybuilder->Gvecs[0], PrimCell, no_shift,
+                                         0, mybuilder->Gvecs[0].size());
+    const int nb=cGs.size();
+    const int max_points=256;
+
+    // random points where the 3D spline contributes, out of the inner cutoff of all the atoms
+    // the lattice image nearest in the reduced coordinates only overestimates the distance
+    std::vector<TinyVector<double,3> > points;
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> uniform(0.0,1.0);
+    for(int itry=0; itry<16*max_points && points.size()<max_points; itry++)
+    {
+      TinyVector<double,3> u(uniform(rng),uniform(rng),uniform(rng));
+      bool inside=false;
+      for(int center_idx=0; center_idx<ACInfo.Ncenters && !inside; center_idx++)
+      {
+        if(ACInfo.cutoff[center_idx]<=0) continue;
+        const double inner=(ACInfo.inner_cutoff[center_idx]>=0)?ACInfo.inner_cutoff[center_idx]
+                                                               :std::max(ACInfo.cutoff[center_idx]-0.3,0.0);
+        TinyVector<double,3> du=u-PrimCell.toUnit(ACInfo.ion_pos[center_idx]);
+        for(int d=0; d<3; d++) du[d]-=std::round(du[d]);
+        const TinyVector<double,3> dr=PrimCell.toCart(du);
+        inside=(std::sqrt(dot(dr,dr))<inner);
+      }
+      if(!inside) points.push_back(u);
+    }
+    const int np=points.size();
+    if(np==0) return mesh_full;
+
+    Matrix<std::complex<double> > exact(nb,np);
+    std::vector<double> norms(nb);
+    for(int ib=0; ib<nb; ib++)
+    {
+      double norm2=0.0;
+      for(size_t ig=0; ig<cGs[ib].size(); ig++)
+        norm2+=std::norm(cGs[ib][ig]);
+      norms[ib]=std::sqrt(norm2);
+      #pragma omp parallel for
+      for(int ip=0; ip<np; ip++)
+        exact(ib,ip)=Gvecs.evaluate_psi_r(cGs[ib],PrimCell.toCart(points[ip]));
+    }
+
+    TinyVector<int,3> mesh_tuned(mesh_full), mesh_last(0);
+    TinyVector<double,3> start(0.0), end(1.0);
+    for(int is=0; is<7; is++)
+    {
+      const double scale=1.0-0.1*is;
+      TinyVector<int,3> mesh;
+      for(int d=0; d<3; d++)
+      {
+        mesh[d]=static_cast<int>(std::ceil(scale*mesh_full[d]));
+        mesh[d]=std::max(mesh[d]+mesh[d]%2,4);
+      }
+      if(mesh[0]==mesh_last[0] && mesh[1]==mesh_last[1] && mesh[2]==mesh_last[2]) continue;
+      mesh_last=mesh;
+
+      Array<std::complex<double>,3> box(mesh[0],mesh[1],mesh[2]);
+      Array<double,3> data_r(mesh[0],mesh[1],mesh[2]), data_i(mesh[0],mesh[1],mesh[2]);
+      fftw_plan plan=fftw_plan_dft_3d(mesh[0], mesh[1], mesh[2],
+                                      reinterpret_cast<fftw_complex*>(box.data()),
+                                      reinterpret_cast<fftw_complex*>(box.data()),
+                                      +1, FFTW_ESTIMATE);
+      UBspline_3d_d* spline_tr=nullptr;
+      UBspline_3d_d* spline_ti=nullptr;
+      spline_tr=einspline::create(spline_tr,start,end,mesh,no_shift);
+      spline_ti=einspline::create(spline_ti,start,end,mesh,no_shift);
+      double max_err=0.0;
+      for(int ib=0; ib<nb; ib++)
+      {
+        unpack4fftw(cGs[ib],mybuilder->Gvecs[0],mesh,box);
+        fftw_execute(plan);
+        for(size_t i=0; i<box.size(); i++)
+        {
+          data_r.data()[i]=box.data()[i].real();
+          data_i.data()[i]=box.data()[i].imag();
+        }
+        einspline::set(spline_tr,data_r.data());
+        einspline::set(spline_ti,data_i.data());
+        for(int ip=0; ip<np; ip++)
+        {
+          const std::complex<double> approx(einspline::evaluate(spline_tr,points[ip]),
+                                            einspline::evaluate(spline_ti,points[ip]));
+          max_err=std::max(max_err,std::abs(exact(ib,ip)-approx)/norms[ib]);
+        }
+      }
+      einspline::destroy(spline_tr);
+      einspline::destroy(spline_ti);
+      fftw_destroy_plan(plan);
+
+      app_log() << "  Hybrid tuning mesh " << mesh << " error=" << max_err << std::endl;
+      if(max_err>hybridTolerance)
+      {
+        if(is==0)
+          app_warning() << "  Hybrid tuning cannot reach the tolerance with the mesh " << mesh
+                        << ". Increase meshfactor." << std::endl;
+        break;
+      }
+      mesh_tuned=mesh;
+    }
+    return mesh_tuned;
+  }
+
   /** initialize basic parameters of atomic orbitals */
   void initialize_hybridrep_atomic_centers() override
   {
@@ -203,8 +560,8 @@ struct SplineHybridAdoptorReader: public SplineAdoptorReader<SA>
           {
             app_log() << "Parameters 'spline_radius' and 'spline_npoints' for group " << my_GroupID
                       << " as atom " << center_idx << " are not specified." << std::endl;
-            const double delta = std::min(0.02, ACInfo.cutoff[center_idx]/4.0);
-            const int n_grid_point = std::ceil((ACInfo.cutoff[center_idx] + 1e-4) / delta) + 3;
+            double delta;
+            const int n_grid_point = default_spline_npoints(ACInfo.cutoff[center_idx], delta);
             for(int id=0; id<ACInfo.Ncenters; id++)
               if(my_GroupID==ACInfo.GroupID[id])
               {
@@ -68,6 +68,12 @@ struct SplineR2RSoA: public SplineAdoptorBase<ST,3>
   vContainer_type myL;
   gContainer_type myG;
   hContainer_type myH;
+  ///positions of the virtual particles in the unit of PrimLattice
+  std::vector<PointType> multi_ru;
+  ///symmetry operations folding the virtual particles into the reduced table
+  std::vector<int> multi_sym_ops;
+  ///signs of the virtual particles from the boundary conditions
+  std::vector<int> multi_bc_sign;
 
   SplineR2RSoA(): BaseType(), SplineInst(nullptr), MultiSpline(nullptr)
   {
@@ -204,6 +210,7 @@ struct SplineR2RSoA: public SplineAdoptorBase<ST,3>
     const PointType& r=P.activeR(iat);
     PointType ru;
     int bc_sign=convertPos(r,ru);
+    const int sym_ops=SplineInst->fold(ru);
 
     #pragma omp parallel
     {
@@ -213,7 +220,11 @@ struct SplineR2RSoA: public SplineAdoptorBase<ST,3>
                         omp_get_thread_num(),
                         first, last);
 
-      spline2::evaluate3d(SplineInst->spline_m,ru,myV,first,last);
+      if(SplineInst->spline_c)
+        spline2::evaluate3d(SplineInst->spline_c,ru,myV,first,last);
+      else
+        spline2::evaluate3d(SplineInst->spline_m,ru,myV,first,last);
+      if(sym_ops) SplineInst->symmetry->unfold_v(sym_ops,myV,first,last);
       assign_v(bc_sign,myV,psi,first,last);
     }
   }
@@ -221,6 +232,17 @@ struct SplineR2RSoA: public SplineAdoptorBase<ST,3>
   template<typename VM, typename VAV>
   inline void evaluateValues(const VirtualParticleSet& VP, VM& psiM, VAV& SPOMem)
   {
+    const int nVP=VP.getTotalNum();
+    Matrix<ST,aligned_allocator<ST> > multi_myV((ST*)SPOMem.data(),nVP,myV.size());
+    multi_ru.resize(nVP);
+    multi_sym_ops.resize(nVP);
+    multi_bc_sign.resize(nVP);
+    for(int iat=0; iat<nVP; ++iat)
+    {
+      multi_bc_sign[iat]=convertPos(VP.activeR(iat),multi_ru[iat]);
+      multi_sym_ops[iat]=SplineInst->fold(multi_ru[iat]);
+    }
+
     #pragma omp parallel
     {
       int first, last;
@@ -229,21 +251,23 @@ struct SplineR2RSoA: public SplineAdoptorBase<ST,3>
                         omp_get_thread_num(),
                         first, last);
 
+      if(SplineInst->spline_c)
+        spline2::evaluate3d_multi_pos(SplineInst->spline_c,multi_ru,multi_myV,first,last);
+      else
+        spline2::evaluate3d_multi_pos(SplineInst->spline_m,multi_ru,multi_myV,first,last);
+
       const size_t m=psiM.cols();
-      for(int iat=0; iat<VP.getTotalNum(); ++iat)
+      for(int iat=0; iat<nVP; ++iat)
       {
-        const PointType& r=VP.activeR(iat);
-        PointType ru;
-        int bc_sign=convertPos(r,ru);
         Vector<TT> psi(psiM[iat],m);
-
-        spline2::evaluate3d(SplineInst->spline_m,ru,myV,first,last);
-        assign_v(bc_sign,myV,psi,first,last);
+        vContainer_type myV_one(multi_myV[iat],myV.size());
+        if(multi_sym_ops[iat]) SplineInst->symmetry->unfold_v(multi_sym_ops[iat],myV_one,first,last);
+        assign_v(multi_bc_sign[iat],myV_one,psi,first,last);
       }
     }
   }
 
-  inline size_t estimateMemory(const int nP) { return 0; }
+  inline size_t estimateMemory(const int nP) { return myV.size()*sizeof(ST)/sizeof(TT)*nP; }
 
   template<typename VV, typename GV>
   inline void assign_vgl(int bc_sign, VV& psi, GV& dpsi, VV& d2psi, int first = 0, int last = -1) const
@@ -307,6 +331,7 @@ struct SplineR2RSoA: public SplineAdoptorBase<ST,3>
     const PointType& r=P.activeR(iat);
     PointType ru;
     int bc_sign=convertPos(r,ru);
+    const int sym_ops=SplineInst->fold(ru);
 
     #pragma omp parallel
     {
@@ -316,7 +341,11 @@ struct SplineR2RSoA: public SplineAdoptorBase<ST,3>
                         omp_get_thread_num(),
                         first, last);
 
-      spline2::evaluate3d_vgh(SplineInst->spline_m,ru,myV,myG,myH,first,last);
+      if(SplineInst->spline_c)
+        spline2::evaluate3d_vgh(SplineInst->spline_c,ru,myV,myG,myH,first,last);
+      else
+        spline2::evaluate3d_vgh(SplineInst->spline_m,ru,myV,myG,myH,first,last);
+      if(sym_ops) SplineInst->symmetry->unfold_vgh(sym_ops,myV,myG,myH,first,last);
       assign_vgl(bc_sign,psi,dpsi,d2psi,first,last);
     }
   }
@@ -385,6 +414,7 @@ struct SplineR2RSoA: public SplineAdoptorBase<ST,3>
     const PointType& r=P.activeR(iat);
     PointType ru;
     int bc_sign=convertPos(r,ru);
+    const int sym_ops=SplineInst->fold(ru);
 
     #pragma omp parallel
     {
@@ -394,7 +424,11 @@ struct SplineR2RSoA: public SplineAdoptorBase<ST,3>
                         omp_get_thread_num(),
                         first, last);
 
-      spline2::evaluate3d_vgh(SplineInst->spline_m,ru,myV,myG,myH,first,last);
+      if(SplineInst->spline_c)
+        spline2::evaluate3d_vgh(SplineInst->spline_c,ru,myV,myG,myH,first,last);
+      else
+        spline2::evaluate3d_vgh(SplineInst->spline_m,ru,myV,myG,myH,first,last);
+      if(sym_ops) SplineInst->symmetry->unfold_vgh(sym_ops,myV,myG,myH,first,last);
       assign_vgh(bc_sign,psi,dpsi,grad_grad_psi,first,last);
     }
   }
@@ -215,11 +215,21 @@ public:
   inline void
   acceptMove(const ParticleSet& P, int iat)
   {
-    // update QP table
-    // may be faster if I do this one qp at a time, for now do full update
-    for(int i=0; i<NumTargets; i++)
-      QP.R[i] = newQP[i];
-    QP.update(0);
+    // update QP table one qp at a time unless most of them moved
+    bool moved=(2*indexQP.size()<=NumTargets);
+    for(int i=0; moved && i<indexQP.size(); i++)
+    {
+      const int jat=indexQP[i];
+      QP.setActive(jat);
+      if((moved=QP.makeMoveAndCheck(jat,newQP[jat]-QP.R[jat])))
+        QP.acceptMove(jat);
+    }
+    if(!moved)
+    {
+      for(int i=0; i<NumTargets; i++)
+        QP.R[i] = newQP[i];
+      QP.update(0);
+    }
     indexQP.clear();
     switch(UpdateMode)
     {
@@ -280,6 +280,7 @@ public:
 #if defined(USE_REAL_STRUCT_FACTOR)
     APP_ABORT("Backflow_ee_kSpace::evaluate");
 #else
+    P.SK->checkRhok("Backflow_ee_kSpace::evaluate");
     //memcopy if necessary but this is not so critcal
     copy(P.SK->rhok[0],P.SK->rhok[0]+NumKVecs,Rhok.data());
     for(int spec1=1; spec1<NumGroups; spec1++)
@@ -320,6 +321,7 @@ public:
 #if defined(USE_REAL_STRUCT_FACTOR)
     APP_ABORT("Backflow_ee_kSpace::evaluate");
 #else
+    P.SK->checkRhok("Backflow_ee_kSpace::evaluate");
     //memcopy if necessary but this is not so critcal
     copy(P.SK->rhok[0],P.SK->rhok[0]+NumKVecs,Rhok.data());
     for(int spec1=1; spec1<NumGroups; spec1++)
@@ -199,10 +199,9 @@ void DiracDeterminantWithBackflow::copyFromBuffer(ParticleSet& P, WFBufferType&
  */
 DiracDeterminantWithBackflow::ValueType DiracDeterminantWithBackflow::ratio(ParticleSet& P, int iat)
 {
-  // FIX FIX FIX : code Woodbury formula
   psiM_temp=psiM;
-  // either code Woodbury or do multiple single particle updates
   UpdateMode=ORB_PBYP_RATIO;
+  movedQP.clear();
   std::vector<int>::iterator it = BFTrans->indexQP.begin();
   std::vector<int>::iterator it_end = BFTrans->indexQP.end();
   while(it != it_end)
@@ -213,6 +212,7 @@ DiracDeterminantWithBackflow::ValueType DiracDeterminantWithBackflow::ratio(Part
       continue;
     }
     int jat = *it-FirstIndex;
+    movedQP.push_back(jat);
     PosType dr = BFTrans->newQP[*it] - BFTrans->QP.R[*it];
     BFTrans->QP.makeMoveAndCheck(*it,dr);
     Phi->evaluate(BFTrans->QP, *it, psiV);
@@ -221,12 +221,9 @@ DiracDeterminantWithBackflow::ValueType DiracDeterminantWithBackflow::ratio(Part
     BFTrans->QP.rejectMove(*it);
     it++;
   }
-  // FIX FIX FIX : code Woodbury formula
-  psiMinv_temp = psiM_temp;
-  // FIX FIX FIX : code Woodbury formula
   InverseTimer.start();
   RealType NewPhase;
-  RealType NewLog=InvertWithLog(psiMinv_temp.data(),NumPtcls,NumOrbitals,WorkSpace.data(),Pivot.data(),NewPhase);
+  RealType NewLog=updateInverse(NewPhase);
   InverseTimer.stop();
 #if defined(QMC_COMPLEX)
   RealType ratioMag = std::exp(NewLog-LogValue);
@@ -236,6 +233,53 @@ DiracDeterminantWithBackflow::ValueType DiracDeterminantWithBackflow::ratio(Part
 #endif
 }
 
+DiracDeterminantWithBackflow::RealType DiracDeterminantWithBackflow::updateInverse(RealType& NewPhase)
+{
+  const int k=movedQP.size();
+  if(k==0)
+  {
+    psiMinv_temp=psiMinv;
+    NewPhase=PhaseValue;
+    return LogValue;
+  }
+  if(2*k>NumPtcls)
+  {
+    psiMinv_temp=psiM_temp;
+    return InvertWithLog(psiMinv_temp.data(),NumPtcls,NumOrbitals,WorkSpace.data(),Pivot.data(),NewPhase);
+  }
+  // psiMinv[j] is orthonormal to the orbitals of quasiparticle j, the columns of psiM
+  WoodburyV.resize(k,NumOrbitals);
+  WoodburyW.resize(k,NumPtcls);
+  WoodburyM.resize(k,k);
+  for(int s=0; s<k; s++)
+    for(int orb=0; orb<NumOrbitals; orb++)
+      WoodburyV(s,orb)=psiM_temp(orb,movedQP[s]);
+  // W(s,j)=psiMinv[j].v_s, M(s,t)=W(s,j_t)
+  for(int s=0; s<k; s++)
+    for(int j=0; j<NumPtcls; j++)
+      WoodburyW(s,j)=simd::dot(psiMinv[j],WoodburyV[s],NumOrbitals);
+  for(int s=0; s<k; s++)
+    for(int t=0; t<k; t++)
+      WoodburyM(s,t)=WoodburyW(s,movedQP[t]);
+  // det(M) is the ratio of the determinants
+  RealType dPhase;
+  RealType dLog=InvertWithLog(WoodburyM.data(),k,k,WorkSpace.data(),Pivot.data(),dPhase);
+  NewPhase=PhaseValue+dPhase;
+  // psiMinv_temp[j]=psiMinv[j]-sum_s C(s,j) psiMinv[j_s], C=M^{-1}(W-E^T)
+  for(int t=0; t<k; t++)
+    WoodburyW(t,movedQP[t])-=ValueType(1);
+  psiMinv_temp=psiMinv;
+  for(int j=0; j<NumPtcls; j++)
+    for(int s=0; s<k; s++)
+    {
+      ValueType c(0);
+      for(int t=0; t<k; t++)
+        c+=WoodburyM(s,t)*WoodburyW(t,j);
+      BLAS::axpy(NumOrbitals,-c,psiMinv[movedQP[s]],1,psiMinv_temp[j],1);
+    }
+  return LogValue+dLog;
+}
+
 void DiracDeterminantWithBackflow::evaluateRatiosAlltoOne(ParticleSet& P, std::vector<ValueType>& ratios)
 {
   APP_ABORT(" Need to implement DiracDeterminantWithBackflow::evaluateRatiosAlltoOne. \n");
@@ -285,10 +329,10 @@ DiracDeterminantWithBackflow::evalGradSource
 DiracDeterminantWithBackflow::ValueType
 DiracDeterminantWithBackflow::ratioGrad(ParticleSet& P, int iat, GradType& grad_iat)
 {
-  // FIX FIX FIX : code Woodbury formula
   psiM_temp=psiM;
   dpsiM_temp=dpsiM;
   UpdateMode=ORB_PBYP_PARTIAL;
+  movedQP.clear();
   std::vector<int>::iterator it = BFTrans->indexQP.begin();
   std::vector<int>::iterator it_end = BFTrans->indexQP.end();
   ParticleSet::ParticlePos_t dr;
@@ -300,6 +344,7 @@ DiracDeterminantWithBackflow::ratioGrad(ParticleSet& P, int iat, GradType& grad_
       continue;
     }
     int jat = *it-FirstIndex;
+    movedQP.push_back(jat);
     PosType dr = BFTrans->newQP[*it] - BFTrans->QP.R[*it];
     BFTrans->QP.makeMoveAndCheck(*it,dr);
     Phi->evaluate(BFTrans->QP, *it, psiV, dpsiV, d2psiV);
@@ -310,12 +355,9 @@ DiracDeterminantWithBackflow::ratioGrad(ParticleSet& P, int iat, GradType& grad_
     BFTrans->QP.rejectMove(*it);
     it++;
   }
-  // FIX FIX FIX : code Woodbury formula
-  psiMinv_temp = psiM_temp;
-  // FIX FIX FIX : code Woodbury formula
   InverseTimer.start();
   RealType NewPhase;
-  RealType NewLog=InvertWithLog(psiMinv_temp.data(),NumPtcls,NumOrbitals,WorkSpace.data(),Pivot.data(),NewPhase);
+  RealType NewLog=updateInverse(NewPhase);
   InverseTimer.stop();
   // update Fmatdiag_temp
   for(int j=0; j<NumPtcls; j++)
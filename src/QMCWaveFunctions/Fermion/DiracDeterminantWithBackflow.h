@@ -154,6 +154,15 @@ public:
    */
   DiracDeterminantWithBackflow* makeCopy(SPOSet* spo) const;
 
+  /** compute psiMinv_temp and the new log after the columns movedQP of psiM_temp changed
+   * @param NewPhase phase of the new determinant
+   * @return log of the new determinant
+   *
+   * With k moved quasiparticles, the inverse is updated with the Woodbury formula
+   * at O(kN^2) cost instead of a full inversion when 2k<=N.
+   */
+  RealType updateInverse(RealType& NewPhase);
+
   inline ValueType rcdot(TinyVector<RealType,OHMMS_DIM>& lhs, TinyVector<ValueType,OHMMS_DIM>& rhs)
   {
     ValueType ret(0);
@@ -188,6 +197,10 @@ public:
   Vector<IndexType> Pivot;
 
   ValueMatrix_t psiMinv_temp;
+  ///local indices of the quasiparticles moved by the active particle
+  std::vector<int> movedQP;
+  ///scratch of the low-rank update of psiMinv_temp
+  ValueMatrix_t WoodburyV, WoodburyW, WoodburyM;
   ValueType *FirstAddressOfGGG;
   ValueType *LastAddressOfGGG;
   ValueType *FirstAddressOfFm;
@@ -40,16 +40,75 @@ namespace qmcplusplus
     }
     buildTableTimer.stop();
     readMatTimer.start();
-    std::vector<int>::const_iterator it2=data.begin();
-    const size_t nitems=sign.size();
-    // explore Inclusive Scan for OpenMP
-    for(size_t count=0; count<nitems; ++count)
+    const ExcitationGroups& groups=*detGroups;
+    const ValueType* restrict dp=dotProducts.data();
+    const size_t ld=dotProducts.cols();
+    const RealType* restrict sg=sign.data();
+
+    // the 2x2 minors shared by the doubles and the triples
     {
-      const size_t n=*it2;
-      //ratios[count]=(count!=ref)?sign[count]*det0*CalculateRatioFromMatrixElements(n,dotProducts,it2+1):det0;
-      if(count!=ref)
-        ratios[count] = sign[count]*det0*CalculateRatioFromMatrixElements(n,dotProducts,it2+1);
-      it2+=3*n+1;
+      const size_t nminors=groups.MinorI.size();
+      const int* restrict mi=groups.MinorI.data();
+      const int* restrict mj=groups.MinorJ.data();
+      const int* restrict ma=groups.MinorA.data();
+      const int* restrict mb=groups.MinorB.data();
+      ValueType* restrict mv=MinorValues.data();
+      #pragma omp simd
+      for(size_t k=0; k<nminors; ++k)
+        mv[k]=dp[mi[k]*ld+ma[k]]*dp[mj[k]*ld+mb[k]]-dp[mi[k]*ld+mb[k]]*dp[mj[k]*ld+ma[k]];
+    }
+
+    for(size_t k=0; k<groups.Zeros.size(); ++k)
+      ratios[groups.Zeros[k]]=sg[groups.Zeros[k]]*det0;
+
+    {
+      const size_t nsingles=groups.SingleIndex.size();
+      const int* restrict idx=groups.SingleIndex.data();
+      const int* restrict h=groups.SingleHole.data();
+      const int* restrict p=groups.SingleParticle.data();
+      #pragma omp simd
+      for(size_t k=0; k<nsingles; ++k)
+        ratios[idx[k]]=sg[idx[k]]*det0*dp[h[k]*ld+p[k]];
+    }
+
+    {
+      const size_t ndoubles=groups.DoubleIndex.size();
+      const int* restrict idx=groups.DoubleIndex.data();
+      const int* restrict m=groups.DoubleMinor.data();
+      const RealType* restrict ms=groups.DoubleSign.data();
+      const ValueType* restrict mv=MinorValues.data();
+      #pragma omp simd
+      for(size_t k=0; k<ndoubles; ++k)
+        ratios[idx[k]]=sg[idx[k]]*ms[k]*det0*mv[m[k]];
+    }
+
+    {
+      const size_t ntriples=groups.TripleIndex.size();
+      const int* restrict idx=groups.TripleIndex.data();
+      const int* restrict h=groups.TripleHole.data();
+      const int* restrict p0=groups.TripleParticle[0].data();
+      const int* restrict p1=groups.TripleParticle[1].data();
+      const int* restrict p2=groups.TripleParticle[2].data();
+      const int* restrict m0=groups.TripleMinor[0].data();
+      const int* restrict m1=groups.TripleMinor[1].data();
+      const int* restrict m2=groups.TripleMinor[2].data();
+      const RealType* restrict s0=groups.TripleSign[0].data();
+      const RealType* restrict s1=groups.TripleSign[1].data();
+      const RealType* restrict s2=groups.TripleSign[2].data();
+      const ValueType* restrict mv=MinorValues.data();
+      #pragma omp simd
+      for(size_t k=0; k<ntriples; ++k)
+      {
+        const ValueType* restrict row=dp+h[k]*ld;
+        ratios[idx[k]]=sg[idx[k]]*det0*(s0[k]*row[p0[k]]*mv[m0[k]]+s1[k]*row[p1[k]]*mv[m1[k]]+s2[k]*row[p2[k]]*mv[m2[k]]);
+      }
+    }
+
+    for(size_t k=0; k<groups.HigherIndex.size(); ++k)
+    {
+      const int count=groups.HigherIndex[k];
+      const int offset=groups.HigherOffset[k];
+      ratios[count]=sg[count]*det0*CalculateRatioFromMatrixElements(data[offset],dotProducts,data.begin()+offset+1);
     }
     ratios[ref]=det0;
     readMatTimer.stop();
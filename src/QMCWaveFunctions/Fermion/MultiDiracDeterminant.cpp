@@ -23,6 +23,8 @@
 #include "Numerics/OhmmsBlas.h"
 #include "Numerics/MatrixOperators.h"
 #include <algorithm>
+#include <array>
+#include <map>
 #include <vector>
 
 // mmorales:
@@ -63,6 +65,8 @@ void MultiDiracDeterminant::createDetData(ci_configuration2& ref, std::vector<in
   data.clear();
   sign.resize(nci);
   pairs.clear();
+  // flags of the pairs already in the list
+  std::vector<char> used(NumPtcls*NumOrbitals,0);
   for(size_t i=0; i<nci; i++)
   {
     sign[i] = ref.calculateExcitations(confgList[i],nex,pos,ocp,uno);
@@ -74,18 +78,20 @@ void MultiDiracDeterminant::createDetData(ci_configuration2& ref, std::vector<in
     for(int k=0; k<nex; k++)
       data.push_back(ocp[k]);
     // determine unique pairs, to avoid redundant calculation of matrix elements
-    // if storing the entire MOxMO matrix is too much, then make an array and a mapping to it.
-    // is there an easier way??
     for(int k1=0; k1<nex; k1++)
       for(int k2=0; k2<nex; k2++)
       {
-//           std::pair<int,int> temp(ocp[k1],uno[k2]);
-        std::pair<int,int> temp(pos[k1],uno[k2]);
-        if(find(pairs.begin(),pairs.end(),temp) == pairs.end()) //pair is new
-          pairs.push_back(temp);
+        const size_t ij=pos[k1]*NumOrbitals+uno[k2];
+        if(!used[ij]) //pair is new
+        {
+          used[ij]=1;
+          pairs.push_back(std::pair<int,int>(pos[k1],uno[k2]));
+        }
       }
   }
   app_log()<<"Number of terms in pairs array: " <<pairs.size() << std::endl;
+  detGroups->build(data,ReferenceDeterminant);
+  app_log()<<"Number of 2x2 minors of the excitations: " <<detGroups->MinorI.size() << std::endl;
   /*
        std::cout <<"ref: " <<ref << std::endl;
        std::cout <<"list: " << std::endl;
@@ -98,6 +104,104 @@ void MultiDiracDeterminant::createDetData(ci_configuration2& ref, std::vector<in
   */
 }
 
+void MultiDiracDeterminant::ExcitationGroups::build(const std::vector<int>& data, int ref)
+{
+  Zeros.clear();
+  SingleIndex.clear();
+  SingleHole.clear();
+  SingleParticle.clear();
+  MinorI.clear();
+  MinorJ.clear();
+  MinorA.clear();
+  MinorB.clear();
+  DoubleIndex.clear();
+  DoubleMinor.clear();
+  DoubleSign.clear();
+  TripleIndex.clear();
+  TripleHole.clear();
+  for(int k=0; k<3; k++)
+  {
+    TripleParticle[k].clear();
+    TripleMinor[k].clear();
+    TripleSign[k].clear();
+  }
+  HigherIndex.clear();
+  HigherOffset.clear();
+
+  // index of the minor (i,j|a,b) in the canonical order i<j, a<b and the sign of the reordering
+  std::map<std::array<int,4>,int> minors;
+  auto findMinor=[&](int i, int j, int a, int b, RealType& s)
+  {
+    s=1.0;
+    if(i>j)
+    {
+      std::swap(i,j);
+      s=-s;
+    }
+    if(a>b)
+    {
+      std::swap(a,b);
+      s=-s;
+    }
+    const std::array<int,4> key={{i,j,a,b}};
+    auto it=minors.find(key);
+    if(it!=minors.end())
+      return (*it).second;
+    const int m=MinorI.size();
+    MinorI.push_back(i);
+    MinorJ.push_back(j);
+    MinorA.push_back(a);
+    MinorB.push_back(b);
+    minors[key]=m;
+    return m;
+  };
+
+  RealType s;
+  size_t offset=0;
+  for(int count=0; offset<data.size(); ++count)
+  {
+    const int n=data[offset];
+    const int* h=data.data()+offset+1;
+    const int* p=h+n;
+    if(count!=ref)
+    {
+      switch(n)
+      {
+        case 0:
+          Zeros.push_back(count);
+          break;
+        case 1:
+          SingleIndex.push_back(count);
+          SingleHole.push_back(h[0]);
+          SingleParticle.push_back(p[0]);
+          break;
+        case 2:
+          DoubleIndex.push_back(count);
+          DoubleMinor.push_back(findMinor(h[0],h[1],p[0],p[1],s));
+          DoubleSign.push_back(s);
+          break;
+        case 3:
+          // expansion along the first hole
+          TripleIndex.push_back(count);
+          TripleHole.push_back(h[0]);
+          for(int k=0; k<3; k++)
+          {
+            const int a=(k==0)?1:0;
+            const int b=(k==2)?1:2;
+            TripleParticle[k].push_back(p[k]);
+            TripleMinor[k].push_back(findMinor(h[1],h[2],p[a],p[b],s));
+            TripleSign[k].push_back((k==1)?-s:s);
+          }
+          break;
+        default:
+          HigherIndex.push_back(count);
+          HigherOffset.push_back(offset);
+      }
+    }
+    offset+=3*n+1;
+  }
+}
+
 //erase
 void out1(int n, std::string str="NULL") {}
 //{ std::cout <<"MDD: " <<str <<"  " <<n << std::endl; std::cout.flush(); }
@@ -330,6 +434,7 @@ MultiDiracDeterminant::MultiDiracDeterminant(const MultiDiracDeterminant& s):
   detData = s.detData;
   uniquePairs = s.uniquePairs;
   DetSigns = s.DetSigns;
+  detGroups = s.detGroups;
 
   registerTimers();
   Phi = (s.Phi->makeClone());
@@ -375,6 +480,7 @@ MultiDiracDeterminant::MultiDiracDeterminant(SPOSetPtr const &spos, int first):
   detData=new std::vector<int>;
   uniquePairs=new std::vector<std::pair<int,int> >;
   DetSigns=new std::vector<RealType>;
+  detGroups=new ExcitationGroups;
 
   registerTimers();
 }
@@ -396,6 +502,7 @@ MultiDiracDeterminant& MultiDiracDeterminant::operator=(const MultiDiracDetermin
   uniquePairs=s.uniquePairs;
   FirstIndex=s.FirstIndex;
   DetSigns=s.DetSigns;
+  detGroups=s.detGroups;
 
   resize(s.NumPtcls, s.NumOrbitals);
   this->DetCalculator.resize(s.NumPtcls);
@@ -484,6 +591,7 @@ void MultiDiracDeterminant::resize(int nel, int morb)
   //}
   if(!IsCloned)
     createDetData((*ciConfigList)[ReferenceDeterminant], *detData,*uniquePairs,*DetSigns);
+  MinorValues.resize(detGroups->MinorI.size());
 }
 
 void MultiDiracDeterminant::registerTimers()
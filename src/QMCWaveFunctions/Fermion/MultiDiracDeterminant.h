@@ -261,6 +261,34 @@ public:
     return 0.0;
   }
 
+  /** determinants grouped by the excitation order, built from detData by createDetData
+   *
+   * The 2x2 sub-determinants of the doubles and of the Laplace expansion of the triples
+   * along their first hole are stored once in Minors, in a canonical order of the holes
+   * and of the particles. The groups are stored as SoA so that the determinants of the
+   * same order are evaluated in one loop. Higher orders keep their offset in detData.
+   */
+  struct ExcitationGroups
+  {
+    ///0-th order excitations other than the reference: index
+    std::vector<int> Zeros;
+    ///singles: index, hole and particle
+    std::vector<int> SingleIndex, SingleHole, SingleParticle;
+    ///unique 2x2 minors: holes i<j and particles a<b
+    std::vector<int> MinorI, MinorJ, MinorA, MinorB;
+    ///doubles: index, minor and the sign of the canonical ordering
+    std::vector<int> DoubleIndex, DoubleMinor;
+    std::vector<RealType> DoubleSign;
+    ///triples: index, first hole, particles and the signed minors of the expansion
+    std::vector<int> TripleIndex, TripleHole;
+    std::vector<int> TripleParticle[3], TripleMinor[3];
+    std::vector<RealType> TripleSign[3];
+    ///higher orders: index and offset of the excitation in detData
+    std::vector<int> HigherIndex, HigherOffset;
+
+    void build(const std::vector<int>& data, int ref);
+  };
+
   void BuildDotProductsAndCalculateRatios_impl(int ref, ValueType det0,
       ValueType* restrict ratios, const ValueMatrix_t &psiinv, const ValueMatrix_t &psi, ValueMatrix_t& dotProducts, 
       const std::vector<int>& data, const std::vector<std::pair<int,int> >& pairs,const std::vector<RealType>& sign);
@@ -381,6 +409,10 @@ public:
   std::vector<int>* detData;
   std::vector<std::pair<int,int> >* uniquePairs;
   std::vector<RealType>* DetSigns;
+  ///excitation groups of detData, shared by the clones
+  ExcitationGroups* detGroups;
+  ///values of the minors of detGroups
+  ValueVector_t MinorValues;
   MyDeterminant<ValueType> DetCalculator;
 
 };
@@ -21,7 +21,7 @@ namespace qmcplusplus
 {
 
 MultiSlaterDeterminantFast::MultiSlaterDeterminantFast(ParticleSet& targetPtcl, MultiDiracDeterminant* up, MultiDiracDeterminant* dn):
-  C2node_up(nullptr),C2node_dn(nullptr),C(nullptr),
+  C2node_up(nullptr),C2node_dn(nullptr),C(nullptr),CIMatrix(nullptr),
   CSFcoeff(nullptr),DetsPerCSF(nullptr),CSFexpansion(nullptr),
   IsCloned(false),
   RatioTimer("MultiSlaterDeterminantFast::ratio"),
@@ -54,6 +54,7 @@ MultiSlaterDeterminantFast::MultiSlaterDeterminantFast(ParticleSet& targetPtcl,
 
   usingBF=false;
   BFTrans=0;
+  ContractionVersion[0]=ContractionVersion[1]=0;
 }
 
 void MultiSlaterDeterminantFast::initialize()
@@ -63,6 +64,7 @@ void MultiSlaterDeterminantFast::initialize()
     C2node_up=new std::vector<size_t>;
     C2node_dn=new std::vector<size_t>;
     C=new std::vector<RealType>;
+    CIMatrix=new SparseCIMatrix<RealType>;
     CSFcoeff=new std::vector<RealType>;
     DetsPerCSF=new std::vector<size_t>;
     CSFexpansion=new std::vector<RealType>;
@@ -71,6 +73,23 @@ void MultiSlaterDeterminantFast::initialize()
   }
 }
 
+void MultiSlaterDeterminantFast::buildCIMatrix()
+{
+  CIMatrix->build(*C,*C2node_up,*C2node_dn,Dets[0]->NumDets,Dets[1]->NumDets);
+  app_log() <<"Number of distinct (up,down) pairs in the MSD expansion: " <<CIMatrix->size() << std::endl;
+}
+
+const WaveFunctionComponent::ValueType* MultiSlaterDeterminantFast::getContraction(int spin)
+{
+  if(ContractionVersion[spin]!=CIMatrix->Version)
+  {
+    CIContraction[spin].resize(Dets[spin]->NumDets);
+    CIMatrix->contract(spin,Dets[1-spin]->detValues.data(),CIContraction[spin].data());
+    ContractionVersion[spin]=CIMatrix->Version;
+  }
+  return CIContraction[spin].data();
+}
+
 WaveFunctionComponentPtr MultiSlaterDeterminantFast::makeClone(ParticleSet& tqp) const
 {
   MultiDiracDeterminant* up_clone = new MultiDiracDeterminant(*Dets[0]);
@@ -89,6 +108,7 @@ WaveFunctionComponentPtr MultiSlaterDeterminantFast::makeClone(ParticleSet& tqp)
   clone->C2node_up=C2node_up;
   clone->C2node_dn=C2node_dn;
   clone->C=C;
+  clone->CIMatrix=CIMatrix;
   clone->myVars=myVars;
 
   clone->Optimizable=Optimizable;
@@ -113,6 +133,7 @@ MultiSlaterDeterminantFast::~MultiSlaterDeterminantFast()
     delete DetsPerCSF;
     delete CSFcoeff;
     delete C;
+    delete CIMatrix;
     delete C2node_dn;
     delete C2node_up;
   }
@@ -216,27 +237,29 @@ WaveFunctionComponent::ValueType MultiSlaterDeterminantFast::evaluate_vgl_impl(P
   g_tmp=czero;
   l_tmp=czero;
 
-  const RealType* restrict cptr=C->data();
-  const size_t nc=C->size();
-  const size_t* restrict upC=C2node_up->data();
-  const size_t* restrict dnC=C2node_dn->data();
-  for(size_t i=0; i<nc; ++i)
+  // the determinants of both spins have changed
+  ContractionVersion[0]=ContractionVersion[1]=0;
+  const ValueType* restrict y_up=getContraction(0);
+  const ValueType* restrict y_dn=getContraction(1);
+  const size_t nup=Dets[0]->NumDets;
+  const size_t ndn=Dets[1]->NumDets;
+  for(size_t up=0; up<nup; ++up)
   {
-    const RealType c=cptr[i];
-    const size_t up=upC[i];
-    const size_t down=dnC[i];
-    psi += c*detValues_up[up]*detValues_dn[down];
-    const ValueType c_up=c*detValues_dn[down];
-    const ValueType c_dn=c*detValues_up[up];
+    const ValueType c_up=y_up[up];
+    psi += c_up*detValues_up[up];
     for(int k=0,n=N1; k<NP1; k++,n++)
     {
-      g_tmp[n] += c_up*grads_up(up,k); //myG[n] += c*grads_up(up,k)*detValues_dn[down];
-      l_tmp[n] += c_up*lapls_up(up,k); //myL[n] += c*lapls_up(up,k)*detValues_dn[down];
+      g_tmp[n] += c_up*grads_up(up,k);
+      l_tmp[n] += c_up*lapls_up(up,k);
     }
+  }
+  for(size_t down=0; down<ndn; ++down)
+  {
+    const ValueType c_dn=y_dn[down];
     for(int k=0,n=N2; k<NP2; k++,n++)
     {
-      g_tmp[n] += c_dn*grads_dn(down,k); //myG[n] += c*grads_dn(down,k)*detValues_up[up];
-      l_tmp[n] += c_dn*lapls_dn(down,k); //myL[n] += c*lapls_dn(down,k)*detValues_up[up];
+      g_tmp[n] += c_dn*grads_dn(down,k);
+      l_tmp[n] += c_dn*lapls_dn(down,k);
     }
   }
   ValueType psiinv = RealType(1)/psi;
@@ -285,22 +308,14 @@ MultiSlaterDeterminantFast::evalGrad_impl(ParticleSet& P, int iat, bool newpos,
 
   const GradMatrix_t& grads = (newpos)? Dets[spin0]->new_grads:Dets[spin0]->grads;
   const ValueType *restrict detValues0 = (newpos)? Dets[spin0]->new_detValues.data(): Dets[spin0]->detValues.data();
-  const ValueType *restrict detValues1 = Dets[spin1]->detValues.data();
-  const size_t *restrict det0=(upspin)? C2node_up->data():C2node_dn->data();
-  const size_t *restrict det1=(upspin)? C2node_dn->data():C2node_up->data();
-  const RealType *restrict cptr=C->data();
-  const size_t nc=C->size();
+  const ValueType *restrict y=getContraction(spin0);
+  const size_t ndets=Dets[spin0]->NumDets;
   const size_t noffset=Dets[spin0]->FirstIndex;
   ValueType psi=ValueType(0);
-  for(size_t i=0; i<nc; ++i)
+  for(size_t i=0; i<ndets; ++i)
   {
-    const size_t d0=det0[i];
-    //const size_t d1=det1[i];
-    //psi +=  cptr[i]*detValues0[d0]        * detValues1[d1];
-    //g_at += cptr[i]*grads(d0,iat-noffset) * detValues1[d1];
-    const ValueType t=cptr[i]*detValues1[ det1[i] ];
-    psi +=  t*detValues0[d0];
-    g_at += t*grads(d0,iat-noffset);
+    psi +=  y[i]*detValues0[i];
+    g_at += y[i]*grads(i,iat-noffset);
   }
   return psi;
 }
@@ -345,15 +360,12 @@ MultiSlaterDeterminantFast::ratio_impl(ParticleSet& P, int iat)
   Dets[spin0]->evaluateDetsForPtclMove(P,iat);
 
   const ValueType *restrict detValues0 = Dets[spin0]->new_detValues.data(); //always new
-  const ValueType *restrict detValues1 = Dets[spin1]->detValues.data();
-  const size_t *restrict det0=(upspin)? C2node_up->data():C2node_dn->data();
-  const size_t *restrict det1=(upspin)? C2node_dn->data():C2node_up->data();
-  const RealType *restrict cptr=C->data();
-  const size_t nc=C->size();
+  const ValueType *restrict y=getContraction(spin0);
+  const size_t ndets=Dets[spin0]->NumDets;
 
   ValueType psi=0;
-  for(size_t i=0; i<nc; ++i)
-    psi += cptr[i]*detValues0[ det0[i] ]*detValues1[ det1[i] ];
+  for(size_t i=0; i<ndets; ++i)
+    psi += y[i]*detValues0[i];
   return psi;
 }
 
@@ -385,6 +397,8 @@ void MultiSlaterDeterminantFast::acceptMove(ParticleSet& P, int iat)
 
   Dets[iat>=nels_up]->acceptMove(P,iat);
   //Dets[DetID[iat]]->acceptMove(P,iat);
+  // the contraction over this spin is outdated
+  ContractionVersion[iat<nels_up]=0;
 
   AccRejTimer.stop();
 }
@@ -445,6 +459,7 @@ void MultiSlaterDeterminantFast::copyFromBuffer(ParticleSet& P, WFBufferType& bu
   }
   Dets[0]->copyFromBuffer(P,buf);
   Dets[1]->copyFromBuffer(P,buf);
+  ContractionVersion[0]=ContractionVersion[1]=0;
 
   buf.get(psiCurrent);
 }
@@ -512,6 +527,7 @@ void MultiSlaterDeterminantFast::resetParameters(const opt_variables_type& activ
       }
       //for(int i=0; i<Dets.size(); i++) Dets[i]->resetParameters(active);
     }
+    buildCIMatrix();
   }
 }
 void MultiSlaterDeterminantFast::reportStatus(std::ostream& os)
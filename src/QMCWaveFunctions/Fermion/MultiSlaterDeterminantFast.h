@@ -20,6 +20,7 @@
 #include <QMCWaveFunctions/Fermion/MultiDiracDeterminant.h>
 #include <QMCWaveFunctions/Fermion/MultiSlaterDeterminant.h>
 #include <QMCWaveFunctions/Fermion/SPOSetProxyForMSD.h>
+#include <QMCWaveFunctions/Fermion/SparseCIMatrix.h>
 #include "Utilities/NewTimer.h"
 #include "QMCWaveFunctions/Fermion/BackflowTransformation.h"
 
@@ -139,6 +140,13 @@ public:
 
   void resize(int,int);
   void initialize();
+  ///compress the expansion into CIMatrix, called whenever C changes
+  void buildCIMatrix();
+  /** expansion contracted with the current determinants of the other spin
+   *
+   * Recomputed only when the determinants of the other spin or C have changed.
+   */
+  const ValueType* getContraction(int spin);
 
   void testMSD(ParticleSet& P, int iat);
 
@@ -160,6 +168,12 @@ public:
   std::vector<size_t>* C2node_up;
   std::vector<size_t>* C2node_dn;
   std::vector<RealType>* C;
+  ///C as a sparse matrix over the unique up and down determinants
+  SparseCIMatrix<RealType>* CIMatrix;
+  ///CIContraction[spin] CIMatrix contracted with the determinants of the other spin
+  ValueVector_t CIContraction[2];
+  ///CIMatrix->Version used by CIContraction, 0 if outdated
+  size_t ContractionVersion[2];
 
   ParticleSet::ParticleGradient_t myG,myG_temp;
   ParticleSet::ParticleLaplacian_t myL,myL_temp;
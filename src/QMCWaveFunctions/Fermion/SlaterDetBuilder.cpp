@@ -47,6 +47,7 @@
 #include "QMCWaveFunctions/Fermion/DiracDeterminantOpt.h"
 
 #include <bitset>
+#include <map>
 #include <unordered_map>
 
 namespace qmcplusplus
@@ -679,6 +680,7 @@ bool SlaterDetBuilder::createMSDFast(MultiSlaterDeterminantFast* multiSD, xmlNod
     app_log() <<"CI coefficients are not optimizable. \n";
     multiSD->Optimizable=false;
   }
+  multiSD->buildCIMatrix();
   return success;
 }
 /*
@@ -1065,50 +1067,32 @@ bool SlaterDetBuilder::readDetList(xmlNodePtr cur, std::vector<ci_configuration>
       sumsq += coeff[i]*coeff[i];
     app_log() <<"Norm of ci vector (sum of ci^2): " <<sumsq << std::endl;
     app_log() <<"Norm of qchem ci vector (sum of qchem_ci^2): " <<sumsq_qc << std::endl;
+    // look up the unique configurations by their occupations instead of scanning the list
+    std::map<std::vector<bool>,size_t> unique_up, unique_dn;
     for(size_t i=0; i<confgList_up.size(); i++)
     {
-      bool found=false;
-      size_t k=-1;
-      for(size_t j=0; j<uniqueConfg_up.size(); j++)
+      auto it=unique_up.find(confgList_up[i].occup);
+      if(it!=unique_up.end())
       {
-        if(confgList_up[i] == uniqueConfg_up[j])
-        {
-          found=true;
-          k=j;
-          break;
-        }
-      }
-      if(found)
-      {
-        C2node_up[i]=k;
+        C2node_up[i]=(*it).second;
       }
       else
       {
         uniqueConfg_up.push_back(confgList_up[i]);
-        C2node_up[i]=uniqueConfg_up.size()-1;
+        C2node_up[i]=unique_up[confgList_up[i].occup]=uniqueConfg_up.size()-1;
       }
     }
     for(size_t i=0; i<confgList_dn.size(); i++)
     {
-      bool found=false;
-      size_t k=-1;
-      for(size_t j=0; j<uniqueConfg_dn.size(); j++)
-      {
-        if(confgList_dn[i] == uniqueConfg_dn[j])
-        {
-          found=true;
-          k=j;
-          break;
-        }
-      }
-      if(found)
+      auto it=unique_dn.find(confgList_dn[i].occup);
+      if(it!=unique_dn.end())
       {
-        C2node_dn[i]=k;
+        C2node_dn[i]=(*it).second;
       }
       else
       {
         uniqueConfg_dn.push_back(confgList_dn[i]);
-        C2node_dn[i]=uniqueConfg_dn.size()-1;
+        C2node_dn[i]=unique_dn[confgList_dn[i].occup]=uniqueConfg_dn.size()-1;
       }
     }
   }
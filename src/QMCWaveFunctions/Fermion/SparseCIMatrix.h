@@ -0,0 +1,133 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2018 Jeongnim Kim and QMCPACK developers.
+//
+// File developed by: Ye Luo, yeluo@anl.gov, Argonne National Laboratory
+//
+// File created by: Ye Luo, yeluo@anl.gov, Argonne National Laboratory
+//////////////////////////////////////////////////////////////////////////////////////
+// -*- C++ -*-
+#ifndef QMCPLUSPLUS_SPARSE_CI_MATRIX_H
+#define QMCPLUSPLUS_SPARSE_CI_MATRIX_H
+#include <config.h>
+#include <vector>
+#include <algorithm>
+
+namespace qmcplusplus
+{
+
+/** CI coefficients of a multi-Slater determinant expansion as a sparse matrix
+ *
+ * The expansion \f$\sum_n c_n D^\uparrow_{u(n)} D^\downarrow_{d(n)}\f$ is stored as
+ * \f$C(u,d)\f$ over the unique up and down determinants, with one entry per distinct
+ * (u,d) pair. The matrix is kept both in compressed rows and in compressed columns so
+ * that the expansion contracted with the determinants of one spin is a sparse
+ * matrix-vector product that only reads the coefficients once.
+ */
+template<typename T>
+struct SparseCIMatrix
+{
+  ///number of unique up and down determinants
+  int NumDets[2];
+  ///incremented by every build, used to invalidate contractions cached by the users
+  size_t Version;
+  ///Start[0] rows, Start[1] columns
+  std::vector<size_t> Start[2];
+  ///Index[0][k] column of the k-th entry in rows, Index[1][k] row of the k-th entry in columns
+  std::vector<int> Index[2];
+  ///Coefs[0] entries in rows, Coefs[1] entries in columns
+  std::vector<T> Coefs[2];
+
+  SparseCIMatrix(): Version(0)
+  {
+    NumDets[0]=NumDets[1]=0;
+  }
+
+  /** build the matrix from the expansion
+   * @param C coefficients of the terms
+   * @param up index of the up determinant of each term
+   * @param dn index of the down determinant of each term
+   * @param nup number of unique up determinants
+   * @param ndn number of unique down determinants
+   */
+  void build(const std::vector<T>& C, const std::vector<size_t>& up, const std::vector<size_t>& dn, int nup, int ndn)
+  {
+    NumDets[0]=nup;
+    NumDets[1]=ndn;
+    const size_t nc=C.size();
+    const size_t* spin_det[2]={up.data(),dn.data()};
+    for(int spin=0; spin<2; ++spin)
+    {
+      const size_t* restrict row=spin_det[spin];
+      const size_t* restrict col=spin_det[1-spin];
+      // bucket the terms by row
+      std::vector<size_t> start(NumDets[spin]+1,0);
+      for(size_t i=0; i<nc; ++i)
+        start[row[i]+1]++;
+      for(int r=0; r<NumDets[spin]; ++r)
+        start[r+1]+=start[r];
+      std::vector<size_t> terms(nc);
+      std::vector<size_t> fill(start.begin(),start.end()-1);
+      for(size_t i=0; i<nc; ++i)
+        terms[fill[row[i]]++]=i;
+      // sort each row by column and merge the terms of the same (row,col)
+      Start[spin].resize(NumDets[spin]+1);
+      Index[spin].clear();
+      Coefs[spin].clear();
+      Index[spin].reserve(nc);
+      Coefs[spin].reserve(nc);
+      for(int r=0; r<NumDets[spin]; ++r)
+      {
+        Start[spin][r]=Index[spin].size();
+        std::sort(terms.begin()+start[r],terms.begin()+start[r+1],
+            [&](size_t a, size_t b) { return col[a]<col[b]; });
+        for(size_t k=start[r]; k<start[r+1]; ++k)
+        {
+          const size_t i=terms[k];
+          if(Index[spin].size()>Start[spin][r] && Index[spin].back()==col[i])
+            Coefs[spin].back()+=C[i];
+          else
+          {
+            Index[spin].push_back(col[i]);
+            Coefs[spin].push_back(C[i]);
+          }
+        }
+      }
+      Start[spin][NumDets[spin]]=Index[spin].size();
+      Index[spin].shrink_to_fit();
+      Coefs[spin].shrink_to_fit();
+    }
+    ++Version;
+  }
+
+  ///number of distinct (up,down) pairs
+  inline size_t size() const
+  {
+    return Index[0].size();
+  }
+
+  /** contract the expansion with the determinants of the other spin
+   * @param spin the spin of the result
+   * @param x determinants of the other spin
+   * @param y y[i]=\f$\sum_j C(i,j) x_j\f$ over the determinants of spin
+   */
+  template<typename VT>
+  inline void contract(int spin, const VT* restrict x, VT* restrict y) const
+  {
+    const size_t* restrict start=Start[spin].data();
+    const int* restrict index=Index[spin].data();
+    const T* restrict coefs=Coefs[spin].data();
+    for(int i=0; i<NumDets[spin]; ++i)
+    {
+      VT sum(0);
+      for(size_t k=start[i]; k<start[i+1]; ++k)
+        sum+=coefs[k]*x[index[k]];
+      y[i]=sum;
+    }
+  }
+};
+
+}
+#endif
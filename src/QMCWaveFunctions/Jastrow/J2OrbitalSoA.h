@@ -20,6 +20,7 @@
 #include <qmc_common.h>
 #endif
 #include "Particle/DistanceTableData.h"
+#include "QMCWaveFunctions/Jastrow/PairFunctorTable.h"
 #include <simd/allocator.hpp>
 #include <simd/algorithm.hpp>
 #include <map>
@@ -42,6 +43,7 @@ namespace qmcplusplus
  * - support simd function
  * - double the loop counts
  * - Memory use is O(N). 
+ * - the functors with a PairFunctorTable are evaluated over all the groups in one loop
  */
 template<class FT>
 struct  J2OrbitalSoA : public WaveFunctionComponent
@@ -85,6 +87,10 @@ struct  J2OrbitalSoA : public WaveFunctionComponent
   std::vector<FT*> F;
   ///Uniquue J2 set for cleanup
   std::map<std::string,FT*> J2Unique;
+  ///packed functors for the fused evaluation of a row
+  PairFunctorTable<FT> FTable;
+  ///true, if FTable is consistent with F
+  bool FTableReady;
 
   J2OrbitalSoA(ParticleSet& p, int tid);
   J2OrbitalSoA(const J2OrbitalSoA& rhs)=delete;
@@ -147,6 +153,7 @@ struct  J2OrbitalSoA : public WaveFunctionComponent
     }
     if(dPsi)
       dPsi->resetParameters( active );
+    FTableReady=false;
     for(int i=0; i<myVars.size(); ++i)
     {
       int ii=myVars.Index[i];
@@ -233,8 +240,26 @@ struct  J2OrbitalSoA : public WaveFunctionComponent
   }
 
   /*@{ internal compute engines*/
+  /** pack the functors into FTable if they have changed
+   * @return true, if the fused evaluation is used
+   */
+  inline bool useFTable(const ParticleSet& P)
+  {
+    if(!FTable.fused) return false;
+    if(!FTableReady)
+    {
+      if(std::find(F.begin(),F.end(),nullptr)!=F.end())
+        return false;
+      FTable.build(F,P);
+      FTableReady=true;
+    }
+    return true;
+  }
+
   inline valT computeU(const ParticleSet& P, int iat, const RealType* restrict dist)
   {
+    if(useFTable(P))
+      return FTable.evaluateV(P.GroupID[iat], iat, N, dist);
     valT curUat(0);
     const int igt=P.GroupID[iat]*NumGroups;
     for(int jg=0; jg<NumGroups; ++jg)
@@ -271,7 +296,7 @@ struct  J2OrbitalSoA : public WaveFunctionComponent
 };
 
 template<typename FT>
-J2OrbitalSoA<FT>::J2OrbitalSoA(ParticleSet& p, int tid) : TaskID(tid)
+J2OrbitalSoA<FT>::J2OrbitalSoA(ParticleSet& p, int tid) : TaskID(tid), FTableReady(false)
 {
   init(p);
   FirstTime =true;
@@ -346,6 +371,7 @@ void J2OrbitalSoA<FT>::addFunc(int ia, int ib, FT* j)
   std::stringstream aname;
   aname<<ia<<ib;
   J2Unique[aname.str()]=j;
+  FTableReady=false;
   //ChiesaKEcorrection();
   FirstTime = false;
 }
@@ -390,6 +416,11 @@ J2OrbitalSoA<FT>::computeU3(const ParticleSet& P, int iat, const RealType* restr
     RealType* restrict u, RealType* restrict du, RealType* restrict d2u, bool triangle)
 {
   const int jelmax=triangle?iat:N;
+  if(useFTable(P))
+  {
+    FTable.evaluateVGL(P.GroupID[iat], iat, jelmax, dist, u, du, d2u);
+    return;
+  }
   constexpr valT czero(0);
   std::fill_n(u,  jelmax,czero);
   std::fill_n(du, jelmax,czero);
@@ -425,17 +456,21 @@ J2OrbitalSoA<FT>::evaluateRatiosAlltoOne(ParticleSet& P, std::vector<ValueType>&
   const DistanceTableData* d_table=P.DistTables[0];
   const auto dist=d_table->Temp_r.data();
 
+  const bool fused=useFTable(P);
   for(int ig=0; ig<NumGroups; ++ig)
   {
     const int igt=ig*NumGroups;
     valT sumU(0);
-    for(int jg=0; jg<NumGroups; ++jg)
-    {
-      const FuncType& f2(*F[igt+jg]);
-      int iStart = P.first(jg);
-      int iEnd = P.last(jg);
-      sumU += f2.evaluateV(-1, iStart, iEnd, dist, DistCompressed.data());
-    }
+    if(fused)
+      sumU=FTable.evaluateV(ig, -1, N, dist);
+    else
+      for(int jg=0; jg<NumGroups; ++jg)
+      {
+        const FuncType& f2(*F[igt+jg]);
+        int iStart = P.first(jg);
+        int iEnd = P.last(jg);
+        sumU += f2.evaluateV(-1, iStart, iEnd, dist, DistCompressed.data());
+      }
 
     for(int i=P.first(ig); i<P.last(ig); ++i)
     {
@@ -31,6 +31,10 @@ namespace qmcplusplus
  *Each pair-type can have distinct function \f$u(r_{ij})\f$.
  *For electrons, distinct pair correlation functions are used
  *for spins up-up/down-down and up-down/down-up.
+ *
+ *Each ion keeps the electrons inside its cutoff sphere and each electron keeps
+ *the ions whose sphere it is in. Both lists are updated on accept, so that
+ *a move only visits the triplets sharing an ion with the moved electron.
  */
 template<class FT>
 class JeeIOrbitalSoA: public WaveFunctionComponent
@@ -77,6 +81,8 @@ class JeeIOrbitalSoA: public WaveFunctionComponent
   Array<std::vector<int>,2> elecs_inside;
   Array<std::vector<valT>,2> elecs_inside_dist;
   Array<std::vector<posT>,2> elecs_inside_displ;
+  /// the ids of ions within the cutoff radius of each electron, the inverse of elecs_inside
+  std::vector<std::vector<int> > ions_inside;
   /// the ids of ions within the cutoff radius of an electron on which a move is proposed
   std::vector<int> ions_nearby_old, ions_nearby_new;
 
@@ -174,6 +180,7 @@ public:
     elecs_inside.resize(eGroups,Nion);
     elecs_inside_dist.resize(eGroups,Nion);
     elecs_inside_displ.resize(eGroups,Nion);
+    ions_inside.resize(Nelec);
     ions_nearby_old.resize(Nion);
     ions_nearby_new.resize(Nion);
     Ion_cutoff.resize(Nion, 0.0);
@@ -380,6 +387,10 @@ public:
     }
   }
 
+  /** build the neighbor lists elecs_inside and ions_inside from scratch
+   *
+   * Both lists are then updated incrementally by acceptMove.
+   */
   void build_compact_list(ParticleSet& P)
   {
     const DistanceTableData& eI_table=(*P.DistTables[myTableID]);
@@ -394,13 +405,26 @@ public:
 
     for(int jg=0; jg<eGroups; ++jg)
       for(int jel=P.first(jg); jel<P.last(jg); jel++)
+      {
+        ions_inside[jel].clear();
         for(int iat=0; iat<Nion; ++iat)
           if(eI_table.Distances[jel][iat]<Ion_cutoff[iat])
           {
             elecs_inside(jg,iat).push_back(jel);
             elecs_inside_dist(jg,iat).push_back(eI_table.Distances[jel][iat]);
             elecs_inside_displ(jg,iat).push_back(eI_table.Displacements[jel][iat]);
+            ions_inside[jel].push_back(iat);
           }
+      }
+  }
+
+  /// find the ions within the cutoff radius of a new electron position
+  inline void findIonsNearby(const RealType* distjI, std::vector<int>& ions_nearby) const
+  {
+    ions_nearby.clear();
+    for(int iat=0; iat<Nion; ++iat)
+      if(distjI[iat]<Ion_cutoff[iat])
+        ions_nearby.push_back(iat);
   }
 
   RealType evaluateLog(ParticleSet& P,
@@ -417,6 +441,7 @@ public:
 
     const DistanceTableData& eI_table=(*P.DistTables[myTableID]);
     const DistanceTableData& ee_table=(*P.DistTables[0]);
+    findIonsNearby(eI_table.Temp_r.data(), ions_nearby_new);
     cur_Uat=computeU(P, iat, P.GroupID[iat], eI_table.Temp_r.data(), ee_table.Temp_r.data(), ions_nearby_new);
     DiffVal=Uat[iat]-cur_Uat;
     return std::exp(DiffVal);
@@ -425,10 +450,13 @@ public:
   void evaluateRatios(VirtualParticleSet& VP, std::vector<ValueType>& ratios)
   {
     for(int k=0; k<ratios.size(); ++k)
+    {
+      findIonsNearby(VP.DistTables[myTableID]->Distances[k], ions_nearby_old);
       ratios[k]=std::exp(Uat[VP.refPtcl] -
                          computeU(VP.refPS, VP.refPtcl, VP.refPS.GroupID[VP.refPtcl],
                                   VP.DistTables[myTableID]->Distances[k],
                                   VP.DistTables[0]->Distances[k], ions_nearby_old));
+    }
   }
 
   void evaluateRatiosAlltoOne(ParticleSet& P, std::vector<ValueType>& ratios)
@@ -437,19 +465,21 @@ public:
     const DistanceTableData& eI_table=(*P.DistTables[myTableID]);
     const DistanceTableData& ee_table=(*P.DistTables[0]);
 
+    findIonsNearby(eI_table.Temp_r.data(), ions_nearby_new);
     for(int jg=0; jg<eGroups; ++jg)
     {
       const valT sumU=computeU(P, -1, jg, eI_table.Temp_r.data(), ee_table.Temp_r.data(), ions_nearby_new);
 
       for(int j=P.first(jg); j<P.last(jg); ++j)
       {
-        // remove self-interaction
+        // remove self-interaction, only the ions around j contribute
         valT Uself(0);
-        for(int iat=0; iat<Nion; ++iat)
+        for(int iind=0; iind<ions_inside[j].size(); ++iind)
         {
+          const int iat=ions_inside[j][iind];
           const valT &r_Ij = eI_table.Temp_r[iat];
           const valT &r_Ik = eI_table.Distances[j][iat];
-          if(r_Ij<Ion_cutoff[iat]&&r_Ik<Ion_cutoff[iat])
+          if(r_Ij<Ion_cutoff[iat])
           {
             const int ig=Ions.GroupID[iat];
             Uself+=F(ig,jg,jg)->evaluate(ee_table.Temp_r[j],r_Ij,r_Ik);
@@ -471,6 +501,7 @@ public:
 
     const DistanceTableData& eI_table=(*P.DistTables[myTableID]);
     const DistanceTableData& ee_table=(*P.DistTables[0]);
+    findIonsNearby(eI_table.Temp_r.data(), ions_nearby_new);
     computeU3(P, iat, eI_table.Temp_r.data(), eI_table.Temp_dr, ee_table.Temp_r.data(), ee_table.Temp_dr,
               cur_Uat, cur_dUat, cur_d2Uat, newUk, newdUk, newd2Uk, ions_nearby_new);
     DiffVal=Uat[iat]-cur_Uat;
@@ -486,7 +517,7 @@ public:
     const DistanceTableData& ee_table=(*P.DistTables[0]);
     // get the old value, grad, lapl
     computeU3(P, iat, eI_table.Distances[iat], eI_table.Displacements[iat], ee_table.Distances[iat], ee_table.Displacements[iat],
-              Uat[iat], dUat_temp, d2Uat[iat], oldUk, olddUk, oldd2Uk, ions_nearby_old);
+              Uat[iat], dUat_temp, d2Uat[iat], oldUk, olddUk, oldd2Uk, ions_inside[iat]);
     if(UpdateMode == ORB_PBYP_RATIO)
     {//ratio-only during the move; need to compute derivatives
       computeU3(P, iat, eI_table.Temp_r.data(), eI_table.Temp_dr, ee_table.Temp_r.data(), ee_table.Temp_dr,
@@ -515,6 +546,9 @@ public:
     d2Uat[iat] = cur_d2Uat;
 
     const int ig = P.GroupID[iat];
+    // update the ions around iat, ions_nearby_new is marked below
+    ions_nearby_old.swap(ions_inside[iat]);
+    ions_inside[iat]=ions_nearby_new;
     // update compact list elecs_inside
     // if the old position exists in elecs_inside
     for (int iind=0; iind<ions_nearby_old.size(); iind++)
@@ -563,7 +597,7 @@ public:
     for(int jel=0; jel<Nelec; ++jel)
     {
       computeU3(P, jel, eI_table.Distances[jel], eI_table.Displacements[jel], ee_table.Distances[jel], ee_table.Displacements[jel],
-                Uat[jel], dUat_temp, d2Uat[jel], newUk, newdUk, newd2Uk, ions_nearby_new, true);
+                Uat[jel], dUat_temp, d2Uat[jel], newUk, newdUk, newd2Uk, ions_inside[jel], true);
       dUat(jel) = dUat_temp;
       // add the contribution from the upper triangle
       #pragma omp simd
@@ -583,17 +617,13 @@ public:
     }
   }
 
+  /** compute the value of jel at a position
+   * @param ions_nearby the ions within the cutoff radius of the position
+   */
   inline valT computeU(const ParticleSet& P, int jel, int jg,
                        const RealType* distjI, const RealType* distjk,
-                       std::vector<int>& ions_nearby)
+                       const std::vector<int>& ions_nearby)
   {
-    const DistanceTableData& eI_table=(*P.DistTables[myTableID]);
-
-    ions_nearby.clear();
-    for(int iat=0; iat<Nion; ++iat)
-      if(distjI[iat]<Ion_cutoff[iat])
-        ions_nearby.push_back(iat);
-
     valT Uj = valT(0);
     for(int kg=0; kg<eGroups; ++kg)
     {
@@ -722,7 +752,7 @@ public:
                         const RealType* distjk, const RowContainer& displjk,
                         valT& Uj, posT& dUj, valT& d2Uj,
                         Vector<valT>& Uk, gContainer_type& dUk, Vector<valT>& d2Uk,
-                        std::vector<int>& ions_nearby, bool triangle=false)
+                        const std::vector<int>& ions_nearby, bool triangle=false)
   {
     constexpr valT czero(0);
 
@@ -738,11 +768,6 @@ public:
     for(int idim=0; idim<OHMMS_DIM; ++idim)
       std::fill_n(dUk.data(idim),kelmax,czero);
 
-    ions_nearby.clear();
-    for(int iat=0; iat<Nion; ++iat)
-      if(distjI[iat]<Ion_cutoff[iat])
-        ions_nearby.push_back(iat);
-
     for(int kg=0; kg<eGroups; ++kg)
     {
       int kel_counter = 0;
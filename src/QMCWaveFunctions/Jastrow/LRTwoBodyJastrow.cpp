@@ -89,6 +89,7 @@ LRTwoBodyJastrow::evaluateLog(ParticleSet& P,
                               ParticleSet::ParticleGradient_t& G,
                               ParticleSet::ParticleLaplacian_t& L)
 {
+  P.SK->checkRhok("LRTwoBodyJastrow::evaluateLog");
   RealType sum(0.0);
 #if defined(USE_REAL_STRUCT_FACTOR)
   std::copy(P.SK->rhok_r[0],P.SK->rhok_r[0]+MaxK,Rhok_r.data());
@@ -460,6 +461,7 @@ LRTwoBodyJastrow::updateBuffer(ParticleSet& P, WFBufferType& buf,
 
 void LRTwoBodyJastrow::copyFromBuffer(ParticleSet& P, WFBufferType& buf)
 {
+  P.SK->checkRhok("LRTwoBodyJastrow::copyFromBuffer");
 #if defined(USE_REAL_STRUCT_FACTOR)
   buf.get(Rhok_r.first_address(), Rhok_r.last_address());
   buf.get(Rhok_i.first_address(), Rhok_i.last_address());
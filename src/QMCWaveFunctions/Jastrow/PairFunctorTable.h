@@ -0,0 +1,192 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2018 Jeongnim Kim and QMCPACK developers.
+//
+// File developed by: Ye Luo, yeluo@anl.gov, Argonne National Laboratory
+//
+// File created by: Ye Luo, yeluo@anl.gov, Argonne National Laboratory
+//////////////////////////////////////////////////////////////////////////////////////
+// -*- C++ -*-
+#ifndef QMCPLUSPLUS_PAIR_FUNCTOR_TABLE_H
+#define QMCPLUSPLUS_PAIR_FUNCTOR_TABLE_H
+#include "Particle/ParticleSet.h"
+#include "QMCWaveFunctions/Jastrow/BsplineFunctor.h"
+#include <simd/allocator.hpp>
+#include <map>
+#include <vector>
+
+namespace qmcplusplus
+{
+
+/** Packed pair functors to evaluate a row of a multi-species pair sum in one loop
+ *
+ * The generic table is disabled and the caller loops over the groups with the functors.
+ * Specializations set fused=true and provide
+ * - build(F, P) with F[ig*P.groups()+jg] the functor of the (ig,jg) pair
+ * - evaluateV(ig, iat, jmax, dist) : \f$\sum_{j<jmax, j\ne iat} u_{ig,G(j)}(r_j)\f$
+ * - evaluateVGL(ig, iat, jmax, dist, u, du, d2u) : set u, du/r and d2u for j<jmax
+ */
+template<typename FT>
+struct PairFunctorTable
+{
+  using real_type=typename FT::real_type;
+  static constexpr bool fused=false;
+
+  inline void build(const std::vector<FT*>& F, const ParticleSet& P) { }
+
+  inline real_type evaluateV(int ig, int iat, int jmax, const real_type* restrict dist) const
+  {
+    return real_type();
+  }
+
+  inline void evaluateVGL(int ig, int iat, int jmax, const real_type* restrict dist,
+      real_type* restrict u, real_type* restrict du, real_type* restrict d2u) const
+  { }
+};
+
+/** PairFunctorTable for BsplineFunctor
+ *
+ * The spline coefficients of all the pairs are packed in Coefs.
+ * For each source group ig, the cutoff, the inverse grid spacing and the offset
+ * of the coefficients of the functor seen by every target particle are stored
+ * in particle order so that one SIMD loop covers all the groups.
+ * The cutoff and self-pair tests are masks instead of a compaction of the distances.
+ */
+template<typename T>
+struct PairFunctorTable<BsplineFunctor<T> >
+{
+  using real_type=T;
+  static constexpr bool fused=true;
+
+  ///spline coefficients of all the functors
+  aligned_vector<T> Coefs;
+  ///Cutoff[ig][j] cutoff radius of the (ig, GroupID[j]) functor
+  std::vector<aligned_vector<T> > Cutoff;
+  ///DeltaRInv[ig][j] inverse grid spacing of the (ig, GroupID[j]) functor
+  std::vector<aligned_vector<T> > DeltaRInv;
+  ///Offset[ig][j] first coefficient of the (ig, GroupID[j]) functor in Coefs
+  std::vector<aligned_vector<int> > Offset;
+  ///basis coefficients of the cubic B-spline, same as BsplineFunctor
+  T A[16], dA[16], d2A[16];
+
+  void build(const std::vector<BsplineFunctor<T>*>& F, const ParticleSet& P)
+  {
+    const int ngroups=P.groups();
+    const int n=P.getTotalNum();
+    std::copy_n(F[0]->A,   16, A);
+    std::copy_n(F[0]->dA,  16, dA);
+    std::copy_n(F[0]->d2A, 16, d2A);
+
+    // pack the coefficients of the distinct functors
+    std::map<const BsplineFunctor<T>*,int> packed;
+    std::vector<int> offsets(F.size());
+    Coefs.clear();
+    for(int ij=0; ij<F.size(); ++ij)
+    {
+      auto it=packed.find(F[ij]);
+      if(it==packed.end())
+      {
+        offsets[ij]=packed[F[ij]]=Coefs.size();
+        Coefs.insert(Coefs.end(),F[ij]->SplineCoefs.begin(),F[ij]->SplineCoefs.end());
+      }
+      else
+        offsets[ij]=(*it).second;
+    }
+
+    Cutoff.resize(ngroups);
+    DeltaRInv.resize(ngroups);
+    Offset.resize(ngroups);
+    for(int ig=0; ig<ngroups; ++ig)
+    {
+      Cutoff[ig].resize(n);
+      DeltaRInv[ig].resize(n);
+      Offset[ig].resize(n);
+      for(int jg=0; jg<ngroups; ++jg)
+      {
+        const int ij=ig*ngroups+jg;
+        for(int j=P.first(jg); j<P.last(jg); ++j)
+        {
+          Cutoff[ig][j]=F[ij]->cutoff_radius;
+          DeltaRInv[ig][j]=F[ij]->DeltaRInv;
+          Offset[ig][j]=offsets[ij];
+        }
+      }
+    }
+  }
+
+  inline T evaluateV(int ig, int iat, int jmax, const T* restrict dist) const
+  {
+    const T* restrict cut=Cutoff[ig].data();
+    const T* restrict drinv=DeltaRInv[ig].data();
+    const int* restrict offset=Offset[ig].data();
+    const T* restrict coefs=Coefs.data();
+    T d(0);
+    #pragma omp simd reduction(+:d) aligned(cut,drinv,offset)
+    for(int j=0; j<jmax; ++j)
+    {
+      const bool inside=(dist[j]<cut[j]) && (j!=iat);
+      // outside r=0 keeps the gather in the table
+      const T r=inside?dist[j]*drinv[j]:T(0);
+      const int i=static_cast<int>(r);
+      const T t=r-T(i);
+      const T tp0=t*t*t;
+      const T tp1=t*t;
+      const T tp2=t;
+      const T* restrict c=coefs+offset[j]+i;
+      const T v=c[0]*(A[ 0]*tp0 + A[ 1]*tp1 + A[ 2]*tp2 + A[ 3])+
+                c[1]*(A[ 4]*tp0 + A[ 5]*tp1 + A[ 6]*tp2 + A[ 7])+
+                c[2]*(A[ 8]*tp0 + A[ 9]*tp1 + A[10]*tp2 + A[11])+
+                c[3]*(A[12]*tp0 + A[13]*tp1 + A[14]*tp2 + A[15]);
+      d+=inside?v:T(0);
+    }
+    return d;
+  }
+
+  inline void evaluateVGL(int ig, int iat, int jmax, const T* restrict dist,
+      T* restrict u, T* restrict du, T* restrict d2u) const
+  {
+    const T* restrict cut=Cutoff[ig].data();
+    const T* restrict drinv=DeltaRInv[ig].data();
+    const int* restrict offset=Offset[ig].data();
+    const T* restrict coefs=Coefs.data();
+    constexpr T cZero(0);
+    constexpr T cOne(1);
+    #pragma omp simd aligned(cut,drinv,offset)
+    for(int j=0; j<jmax; ++j)
+    {
+      const bool inside=(dist[j]<cut[j]) && (j!=iat);
+      const T rinv=inside?cOne/dist[j]:cZero;
+      const T r=inside?dist[j]*drinv[j]:cZero;
+      const int i=static_cast<int>(r);
+      const T t=r-T(i);
+      const T tp0=t*t*t;
+      const T tp1=t*t;
+      const T tp2=t;
+      const T* restrict c=coefs+offset[j]+i;
+      const T mask=inside?cOne:cZero;
+
+      d2u[j]=mask*drinv[j]*drinv[j]*
+        (c[0]*(d2A[ 2]*tp2 + d2A[ 3])+
+         c[1]*(d2A[ 6]*tp2 + d2A[ 7])+
+         c[2]*(d2A[10]*tp2 + d2A[11])+
+         c[3]*(d2A[14]*tp2 + d2A[15]));
+
+      du[j]=drinv[j]*rinv*
+        (c[0]*(dA[ 1]*tp1 + dA[ 2]*tp2 + dA[ 3])+
+         c[1]*(dA[ 5]*tp1 + dA[ 6]*tp2 + dA[ 7])+
+         c[2]*(dA[ 9]*tp1 + dA[10]*tp2 + dA[11])+
+         c[3]*(dA[13]*tp1 + dA[14]*tp2 + dA[15]));
+
+      u[j]=mask*
+        (c[0]*(A[ 0]*tp0 + A[ 1]*tp1 + A[ 2]*tp2 + A[ 3])+
+         c[1]*(A[ 4]*tp0 + A[ 5]*tp1 + A[ 6]*tp2 + A[ 7])+
+         c[2]*(A[ 8]*tp0 + A[ 9]*tp1 + A[10]*tp2 + A[11])+
+         c[3]*(A[12]*tp0 + A[13]*tp1 + A[14]*tp2 + A[15]));
+    }
+  }
+};
+
+}
+#endif
@@ -302,12 +302,12 @@ kSpaceJastrow::kSpaceJastrow(ParticleSet& ions, ParticleSet& elecs,
   TwoBodyCoefs.resize(nTwo);
   TwoBody_rhoG.resize(nTwo);
   TwoBodyPhase.resize(nTwo);
+  TwoBody_rhoG_new.resize(nTwo);
   TwoBody_e2iGr_new.resize(nTwo);
-  TwoBody_e2iGr_old.resize(nTwo);
-  Delta_e2iGr.resize(nElecs,nTwo);
-  for (int iat=0; iat<nElecs; iat++)
-    for (int i=0; i<nTwo; i++)
-      Delta_e2iGr(iat,i) = ComplexType();
+  TwoBody_e2iGr.resize(nElecs,nTwo);
+  OneBodyU.resize(nElecs);
+  OneBodyGrad.resize(nElecs);
+  OneBodyLap.resize(nElecs);
   // Set Ion_rhoG
   for (int i=0; i<OneBodyGvecs.size(); i++)
   {
@@ -378,23 +378,68 @@ kSpaceJastrow::setCoefficients(std::vector<RealType> &oneBodyCoefs,
 void
 kSpaceJastrow::resetTargetParticleSet(ParticleSet& P)
 {
-  for (int i=0; i<TwoBodyGvecs.size(); i++)
-  {
-    TwoBody_rhoG[i] = ComplexType();
-    for (int iat=0; iat<NumElecs; iat++)
-    {
-      RealType phase, s, c;
-      phase = dot (TwoBodyGvecs[i], P.R[iat]);
-      sincos(phase, &s, &c);
-      TwoBody_rhoG[i] += ComplexType(c,s);
-    }
-  }
+  recompute(P);
 }
 
 ///////////////////////////////////////////////////////////////
 //                  Evaluation functions                     //
 ///////////////////////////////////////////////////////////////
 
+void
+kSpaceJastrow::evaluateOneBody(const PosType& r, RealType& u, PosType& grad, RealType& lap)
+{
+  const ComplexType eye(0.0, 1.0);
+  const int nOne = OneBodyGvecs.size();
+  for (int i=0; i<nOne; i++)
+    OneBodyPhase[i] = dot(OneBodyGvecs[i], r);
+  eval_e2iphi (nOne, OneBodyPhase.data(), OneBody_e2iGr.data());
+  u = RealType();
+  grad = PosType();
+  lap = RealType();
+  for (int i=0; i<nOne; i++)
+  {
+    ComplexType z = OneBodyCoefs[i] * qmcplusplus::conj(OneBody_e2iGr[i]);
+    u += Prefactor*real(z);
+    grad += -Prefactor*real(z*eye)*OneBodyGvecs[i];
+    lap += -Prefactor*dot(OneBodyGvecs[i],OneBodyGvecs[i])*real(z);
+  }
+}
+
+void
+kSpaceJastrow::evaluateTwoBodyE2iGr(const PosType& r, ComplexType* restrict z)
+{
+  const int nTwo = TwoBodyGvecs.size();
+  for (int i=0; i<nTwo; i++)
+    TwoBodyPhase[i] = dot(TwoBodyGvecs[i], r);
+  eval_e2iphi (nTwo, TwoBodyPhase.data(), z);
+}
+
+kSpaceJastrow::PosType
+kSpaceJastrow::evaluateTwoBodyGrad(const ComplexType* restrict rhoG, const ComplexType* restrict z)
+{
+  PosType grad;
+  const int nTwo = TwoBodyGvecs.size();
+  for (int i=0; i<nTwo; i++)
+    grad += -Prefactor*2.0*TwoBodyGvecs[i]*TwoBodyCoefs[i]*imag(qmcplusplus::conj(rhoG[i])*z[i]);
+  return grad;
+}
+
+void
+kSpaceJastrow::recompute(ParticleSet& P)
+{
+  const int nTwo = TwoBodyGvecs.size();
+  for (int i=0; i<nTwo; i++)
+    TwoBody_rhoG[i] = ComplexType();
+  for (int iat=0; iat<NumElecs; iat++)
+  {
+    evaluateOneBody(P.R[iat], OneBodyU[iat], OneBodyGrad[iat], OneBodyLap[iat]);
+    ComplexType* restrict z=TwoBody_e2iGr[iat];
+    evaluateTwoBodyE2iGr(P.R[iat], z);
+    for (int i=0; i<nTwo; i++)
+      TwoBody_rhoG[i] += z[i];
+  }
+}
+
 kSpaceJastrow::RealType
 kSpaceJastrow::evaluateLog(ParticleSet& P,
                            ParticleSet::ParticleGradient_t& G,
@@ -402,53 +447,25 @@ kSpaceJastrow::evaluateLog(ParticleSet& P,
 {
   RealType J1(0.0), J2(0.0);
   int N = P.getTotalNum();
-  ComplexType eye(0.0, 1.0);
-  int nOne = OneBodyGvecs.size();
+  recompute(P);
   for (int iat=0; iat<N; iat++)
   {
-    PosType r(P.R[iat]);
-    for (int i=0; i<nOne; i++)
-      OneBodyPhase[i] = dot(OneBodyGvecs[i], r);
-    eval_e2iphi (OneBodyPhase, OneBody_e2iGr);
-    for (int i=0; i<nOne; i++)
-    {
-      ComplexType z = OneBodyCoefs[i] * qmcplusplus::conj(OneBody_e2iGr[i]);
-      J1 += Prefactor*real(z);
-      G[iat] += -Prefactor*real(z*eye)*OneBodyGvecs[i];
-      L[iat] += -Prefactor*dot(OneBodyGvecs[i],OneBodyGvecs[i])*real(z);
-    }
+    J1 += OneBodyU[iat];
+    G[iat] += OneBodyGrad[iat];
+    L[iat] += OneBodyLap[iat];
   }
   // Do two-body part
   int nTwo = TwoBodyGvecs.size();
-  for (int i=0; i<nTwo; i++)
-    TwoBody_rhoG[i] = ComplexType();
-  for (int iat=0; iat<N; iat++)
-  {
-    PosType r(P.R[iat]);
-    for (int iG=0; iG<nTwo; iG++)
-      TwoBodyPhase[iG] = dot(TwoBodyGvecs[iG], r);
-    eval_e2iphi (TwoBodyPhase, TwoBody_e2iGr_new);
-    for (int iG=0; iG<nTwo; iG++)
-      TwoBody_rhoG[iG] += TwoBody_e2iGr_new[iG];
-  }
-//     std::cerr << "TwoBody_rhoG = ";
-//     for (int i=0; i<nTwo; i++)
-//       std::cerr << TwoBody_rhoG[i]  << "  ";
-//     std::cerr << std::endl;
   for (int i=0; i<nTwo; i++)
     J2 += Prefactor*TwoBodyCoefs[i]*norm(TwoBody_rhoG[i]);
   for (int iat=0; iat<N; iat++)
   {
-    PosType r(P.R[iat]);
-    for (int i=0; i<nTwo; i++)
-      TwoBodyPhase[i] = dot(TwoBodyGvecs[i], r);
-    eval_e2iphi (TwoBodyPhase, TwoBody_e2iGr_new);
+    const ComplexType* restrict z=TwoBody_e2iGr[iat];
+    G[iat] += evaluateTwoBodyGrad(TwoBody_rhoG.data(), z);
     for (int i=0; i<nTwo; i++)
     {
       PosType Gvec(TwoBodyGvecs[i]);
-      ComplexType z = TwoBody_e2iGr_new[i];
-      G[iat] += -Prefactor*2.0*Gvec*TwoBodyCoefs[i]*imag(qmcplusplus::conj(TwoBody_rhoG[i])*z);
-      L[iat] += Prefactor*2.0*TwoBodyCoefs[i]*dot(Gvec,Gvec)*(-real(z*qmcplusplus::conj(TwoBody_rhoG[i])) + 1.0);
+      L[iat] += Prefactor*2.0*TwoBodyCoefs[i]*dot(Gvec,Gvec)*(-real(z[i]*qmcplusplus::conj(TwoBody_rhoG[i])) + 1.0);
     }
   }
   return J1 + J2;
@@ -457,106 +474,37 @@ kSpaceJastrow::evaluateLog(ParticleSet& P,
 
 kSpaceJastrow::GradType kSpaceJastrow::evalGrad(ParticleSet& P, int iat)
 {
-//     RealType J1(0.0), J2(0.0);
-  kSpaceJastrow::GradType G;
-  int N = P.getTotalNum();
-  ComplexType eye(0.0, 1.0);
-  int nOne = OneBodyGvecs.size();
-//     for (int iat=0; iat<N; iat++) {
-  PosType r(P.R[iat]);
-  for (int i=0; i<nOne; i++)
-    OneBodyPhase[i] = dot(OneBodyGvecs[i], r);
-  eval_e2iphi (OneBodyPhase, OneBody_e2iGr);
-  for (int i=0; i<nOne; i++)
-  {
-    ComplexType z = OneBodyCoefs[i] * qmcplusplus::conj(OneBody_e2iGr[i]);
-//    J1 += Prefactor*real(z);
-    G += -Prefactor*real(z*eye)*OneBodyGvecs[i];
-//    L[iat] += -Prefactor*dot(OneBodyGvecs[i],OneBodyGvecs[i])*real(z);
-  }
-//     }
-  // Do two-body part
-  int nTwo = TwoBodyGvecs.size();
-  for (int i=0; i<nTwo; i++)
-    TwoBody_rhoG[i] = ComplexType();
-  for (int iat2=0; iat2<N; iat2++)
-  {
-    PosType rp(P.R[iat2]);
-    for (int iG=0; iG<nTwo; iG++)
-      TwoBodyPhase[iG] = dot(TwoBodyGvecs[iG], rp);
-    eval_e2iphi (TwoBodyPhase, TwoBody_e2iGr_new);
-    for (int iG=0; iG<nTwo; iG++)
-      TwoBody_rhoG[iG] += TwoBody_e2iGr_new[iG];
-  }
-//     std::cerr << "TwoBody_rhoG = ";
-//     for (int i=0; i<nTwo; i++)
-//       std::cerr << TwoBody_rhoG[i]  << "  ";
-//     std::cerr << std::endl;
-//     for (int i=0; i<nTwo; i++)
-//       J2 += Prefactor*TwoBodyCoefs[i]*norm(TwoBody_rhoG[i]);
-//     for (int iat=0; iat<N; iat++) {
-//       PosType r(P.R[iat]);
-  for (int i=0; i<nTwo; i++)
-    TwoBodyPhase[i] = dot(TwoBodyGvecs[i], r);
-  eval_e2iphi (TwoBodyPhase, TwoBody_e2iGr_new);
+  return GradType(OneBodyGrad[iat] + evaluateTwoBodyGrad(TwoBody_rhoG.data(), TwoBody_e2iGr[iat]));
+}
+
+/** compute the one-body value and the \f$e^{iG\cdot r}\f$ of the proposed move
+ * @return \f$J(r_{new})-J(r_{old})\f$
+ *
+ * TwoBody_rhoG and the cached row of iat are used for the old position,
+ * the cost is O(N_G) independent of the number of electrons.
+ */
+kSpaceJastrow::RealType
+kSpaceJastrow::computeDelta(const PosType& rnew, int iat)
+{
+  evaluateOneBody(rnew, curOneBodyU, curOneBodyGrad, curOneBodyLap);
+  evaluateTwoBodyE2iGr(rnew, TwoBody_e2iGr_new.data());
+  const int nTwo = TwoBodyGvecs.size();
+  const ComplexType* restrict z_old=TwoBody_e2iGr[iat];
+  RealType dJ2(0.0);
   for (int i=0; i<nTwo; i++)
   {
-    PosType Gvec(TwoBodyGvecs[i]);
-    ComplexType z = TwoBody_e2iGr_new[i];
-    G += -Prefactor*2.0*Gvec*TwoBodyCoefs[i]*imag(qmcplusplus::conj(TwoBody_rhoG[i])*z);
-//    L[iat] += Prefactor*2.0*TwoBodyCoefs[i]*dot(Gvec,Gvec)*(-real(z*qmcplusplus::conj(TwoBody_rhoG[i])) + 1.0);
+    TwoBody_rhoG_new[i] = TwoBody_rhoG[i] + TwoBody_e2iGr_new[i] - z_old[i];
+    dJ2 += TwoBodyCoefs[i]*(std::norm(TwoBody_rhoG_new[i]) - std::norm(TwoBody_rhoG[i]));
   }
-//     }
-  return G;
+  return curOneBodyU - OneBodyU[iat] + Prefactor*dJ2;
 }
 
 kSpaceJastrow::ValueType
 kSpaceJastrow::ratioGrad(ParticleSet& P, int iat, GradType& grad_iat)
 {
-  ComplexType eye(0.0, 1.0);
-  RealType J1new(0.0), J1old(0.0), J2new(0.0), J2old(0.0);
-  const PosType &rnew(P.activePos), &rold(P.R[iat]);
-  // Compute one-body contribution
-  int nOne = OneBodyGvecs.size();
-  for (int i=0; i<nOne; i++)
-    OneBodyPhase[i] = dot(OneBodyGvecs[i], rnew);
-  eval_e2iphi (OneBodyPhase, OneBody_e2iGr);
-  for (int i=0; i<nOne; i++)
-  {
-    ComplexType z = OneBodyCoefs[i] * qmcplusplus::conj(OneBody_e2iGr[i]);
-    J1new += Prefactor*real(z);
-    grad_iat += -Prefactor*real(z*eye)*OneBodyGvecs[i];
-  }
-  for (int i=0; i<nOne; i++)
-    OneBodyPhase[i] = dot(OneBodyGvecs[i], rold);
-  eval_e2iphi (OneBodyPhase, OneBody_e2iGr);
-  for (int i=0; i<nOne; i++)
-    J1old += Prefactor*real(OneBodyCoefs[i] * qmcplusplus::conj(OneBody_e2iGr[i]));
-  // Now, do two-body part
-  int nTwo = TwoBodyGvecs.size();
-  for (int i=0; i<nTwo; i++)
-    TwoBodyPhase[i] = dot(TwoBodyGvecs[i], rold);
-  eval_e2iphi (TwoBodyPhase, TwoBody_e2iGr_old);
-  for (int i=0; i<nTwo; i++)
-    TwoBodyPhase[i] = dot(TwoBodyGvecs[i], rnew);
-  eval_e2iphi (TwoBodyPhase, TwoBody_e2iGr_new);
-  for (int i=0; i<nTwo; i++)
-  {
-    ComplexType rho_G = TwoBody_rhoG[i];
-    J2old += Prefactor*TwoBodyCoefs[i]*std::norm(rho_G);
-  }
-  for (int i=0; i<nTwo; i++)
-  {
-    ComplexType rho_G = TwoBody_rhoG[i] + TwoBody_e2iGr_new[i] - TwoBody_e2iGr_old[i];
-    J2new += Prefactor*TwoBodyCoefs[i]*std::norm(rho_G);
-  }
-  for (int i=0; i<nTwo; i++)
-  {
-    PosType Gvec(TwoBodyGvecs[i]);
-    ComplexType z = TwoBody_e2iGr_new[i];
-    grad_iat += -Prefactor*2.0*TwoBodyGvecs[i]*TwoBodyCoefs[i]*imag(qmcplusplus::conj(TwoBody_rhoG[i])*TwoBody_e2iGr_new[i]);
-  }
-  return std::exp(J1new+J2new - (J1old + J2old));
+  const RealType dJ = computeDelta(P.activePos, iat);
+  grad_iat += curOneBodyGrad + evaluateTwoBodyGrad(TwoBody_rhoG_new.data(), TwoBody_e2iGr_new.data());
+  return std::exp(dJ);
 }
 
 /* evaluate the ratio with P.R[iat]
@@ -565,80 +513,32 @@ kSpaceJastrow::ratioGrad(ParticleSet& P, int iat, GradType& grad_iat)
 kSpaceJastrow::ValueType
 kSpaceJastrow::ratio(ParticleSet& P, int iat)
 {
-  RealType J1new(0.0), J1old(0.0), J2new(0.0), J2old(0.0);
-  const PosType &rnew(P.activePos), &rold(P.R[iat]);
-  // Compute one-body contribution
-  int nOne = OneBodyGvecs.size();
-  for (int i=0; i<nOne; i++)
-    OneBodyPhase[i] = dot(OneBodyGvecs[i], rnew);
-  eval_e2iphi (OneBodyPhase, OneBody_e2iGr);
-  for (int i=0; i<nOne; i++)
-    J1new += Prefactor*real(OneBodyCoefs[i] * qmcplusplus::conj(OneBody_e2iGr[i]));
-  for (int i=0; i<nOne; i++)
-    OneBodyPhase[i] = dot(OneBodyGvecs[i], rold);
-  eval_e2iphi (OneBodyPhase, OneBody_e2iGr);
-  for (int i=0; i<nOne; i++)
-    J1old += Prefactor*real(OneBodyCoefs[i] * qmcplusplus::conj(OneBody_e2iGr[i]));
-  // Now, do two-body part
-  int nTwo = TwoBodyGvecs.size();
-  for (int i=0; i<nTwo; i++)
-    TwoBodyPhase[i] = dot(TwoBodyGvecs[i], rold);
-  eval_e2iphi (TwoBodyPhase, TwoBody_e2iGr_old);
-  for (int i=0; i<nTwo; i++)
-    TwoBodyPhase[i] = dot(TwoBodyGvecs[i], rnew);
-  eval_e2iphi (TwoBodyPhase, TwoBody_e2iGr_new);
-  for (int i=0; i<nTwo; i++)
-  {
-    ComplexType rho_G = TwoBody_rhoG[i];
-    J2old += Prefactor*TwoBodyCoefs[i]*std::norm(rho_G);
-  }
-  for (int i=0; i<nTwo; i++)
-  {
-    ComplexType rho_G = TwoBody_rhoG[i] + TwoBody_e2iGr_new[i] - TwoBody_e2iGr_old[i];
-    J2new += Prefactor*TwoBodyCoefs[i]*std::norm(rho_G);
-  }
-  return std::exp(J1new+J2new - (J1old + J2old));
+  return std::exp(computeDelta(P.activePos, iat));
 }
 
 /** evaluate the ratio
 */
 void kSpaceJastrow::evaluateRatiosAlltoOne(ParticleSet& P, std::vector<kSpaceJastrow::ValueType>& ratios)
 {
-  RealType J1new(0.0);
+  RealType J1new(0.0), L1new(0.0);
+  PosType G1new;
   const PosType &rnew(P.activePos);
-//     Compute one-body contribution
-  int nOne = OneBodyGvecs.size();
-  for (int i=0; i<nOne; i++)
-    OneBodyPhase[i] = dot(OneBodyGvecs[i], rnew);
-  eval_e2iphi (OneBodyPhase, OneBody_e2iGr);
-// //
-  for (int i=0; i<nOne; i++)
-    J1new += Prefactor*real(OneBodyCoefs[i] * qmcplusplus::conj(OneBody_e2iGr[i]));
+  evaluateOneBody(rnew, J1new, G1new, L1new);
   // Now, do two-body part
   int nTwo = TwoBodyGvecs.size();
-  for (int i=0; i<nTwo; i++)
-    TwoBodyPhase[i] = dot(TwoBodyGvecs[i], rnew);
-  eval_e2iphi (TwoBodyPhase, TwoBody_e2iGr_new);
+  evaluateTwoBodyE2iGr(rnew, TwoBody_e2iGr_new.data());
   int N = P.getTotalNum();
   for (int n=0; n<N; n++)
   {
-    RealType J1old(0.0), J2Rat(0.0);
-    const PosType &rold(P.R[n]);
-    for (int i=0; i<nOne; i++)
-      OneBodyPhase[i] = dot(OneBodyGvecs[i], rold);
-    eval_e2iphi (OneBodyPhase, OneBody_e2iGr);
-    for (int i=0; i<nOne; i++)
-      J1old += Prefactor*real(OneBodyCoefs[i] * qmcplusplus::conj(OneBody_e2iGr[i]));
-    for (int i=0; i<nTwo; i++)
-      TwoBodyPhase[i] = dot(TwoBodyGvecs[i], rold);
-    eval_e2iphi (TwoBodyPhase, TwoBody_e2iGr_old);
+    RealType J2Rat(0.0);
+    const ComplexType* restrict z_old=TwoBody_e2iGr[n];
     for (int i=0; i<nTwo; i++)
     {
-      ComplexType rho_G_new = TwoBody_rhoG[i] + TwoBody_e2iGr_new[i] - TwoBody_e2iGr_old[i];
+      ComplexType rho_G_new = TwoBody_rhoG[i] + TwoBody_e2iGr_new[i] - z_old[i];
       ComplexType rho_G_old = TwoBody_rhoG[i];
       J2Rat += Prefactor*TwoBodyCoefs[i]*(std::norm(rho_G_new) - std::norm(rho_G_old));
     }
-    ratios[n]=std::exp(J1new-J1old + J2Rat);
+    ratios[n]=std::exp(J1new-OneBodyU[n] + J2Rat);
   }
 }
 
@@ -646,20 +546,22 @@ void kSpaceJastrow::evaluateRatiosAlltoOne(ParticleSet& P, std::vector<kSpaceJas
 void
 kSpaceJastrow::restore(int iat)
 {
-  //substract the addition in logRatio
-  //if(NeedToRestore) Rhok -= delta_eikr;
 }
 
 void
 kSpaceJastrow::acceptMove(ParticleSet& P, int iat)
 {
-  for (int i=0; i<TwoBody_e2iGr_new.size(); i++)
-    TwoBody_rhoG[i] += Delta_e2iGr(iat,i);
-  //TwoBody_e2iGr_new[i] - TwoBody_e2iGr_old[i];
-  // copy(eikr_new.data(),eikr_new.data()+MaxK,eikr[iat]);
-  // U += offU;
-  // dU += offdU;
-  // d2U += offd2U;
+  // TwoBody_e2iGr_new and the one-body terms are set by ratio or ratioGrad
+  const int nTwo = TwoBodyGvecs.size();
+  ComplexType* restrict z=TwoBody_e2iGr[iat];
+  for (int i=0; i<nTwo; i++)
+  {
+    TwoBody_rhoG[i] = TwoBody_rhoG_new[i];
+    z[i] = TwoBody_e2iGr_new[i];
+  }
+  OneBodyU[iat] = curOneBodyU;
+  OneBodyGrad[iat] = curOneBodyGrad;
+  OneBodyLap[iat] = curOneBodyLap;
 }
 
 void
@@ -696,16 +598,7 @@ kSpaceJastrow::updateBuffer(ParticleSet& P, WFBufferType& buf,
 void
 kSpaceJastrow::copyFromBuffer(ParticleSet& P, WFBufferType& buf)
 {
-  for (int i=0; i<TwoBodyCoefs.size(); i++)
-    TwoBody_rhoG[i] = ComplexType();
-  for (int iat=0; iat<NumElecs; iat++)
-  {
-    for (int i=0; i<TwoBodyCoefs.size(); i++)
-      TwoBodyPhase[i] = dot(TwoBodyGvecs[i],P.R[iat]);
-    eval_e2iphi(TwoBodyPhase, TwoBody_e2iGr_new);
-    for (int i=0; i<TwoBodyCoefs.size(); i++)
-      TwoBody_rhoG[i] += TwoBody_e2iGr_new[i];
-  }
+  recompute(P);
 }
 
 void kSpaceJastrow::checkInVariables(opt_variables_type& active)
@@ -852,9 +745,12 @@ void kSpaceJastrow::copyFrom(const kSpaceJastrow& old)
   OneBodyPhase=old.OneBodyPhase;
   TwoBodyPhase=old.TwoBodyPhase;
   OneBody_e2iGr=old.OneBody_e2iGr;
+  TwoBody_rhoG_new=old.TwoBody_rhoG_new;
   TwoBody_e2iGr_new=old.TwoBody_e2iGr_new;
-  TwoBody_e2iGr_old=old.TwoBody_e2iGr_old;
-  Delta_e2iGr=old.Delta_e2iGr;
+  TwoBody_e2iGr=old.TwoBody_e2iGr;
+  OneBodyU=old.OneBodyU;
+  OneBodyGrad=old.OneBodyGrad;
+  OneBodyLap=old.OneBodyLap;
   OneBodyID=old.OneBodyID;
   TwoBodyID=old.TwoBodyID;
   //copy the variable map
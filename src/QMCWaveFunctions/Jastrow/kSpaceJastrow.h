@@ -110,9 +110,17 @@ private:
   // OneBodyGvecs, and TwoBodyGvecs, respectively
   std::vector<RealType> OneBodyPhase, TwoBodyPhase;
   //
-  std::vector<ComplexType> OneBody_e2iGr,
-      TwoBody_e2iGr_new, TwoBody_e2iGr_old;
-  Matrix<ComplexType> Delta_e2iGr;
+  std::vector<ComplexType> OneBody_e2iGr, TwoBody_e2iGr_new;
+  // TwoBody_e2iGr(iat,iG) = e^{iG.r_iat}, the row of iat is updated on accept
+  Matrix<ComplexType> TwoBody_e2iGr;
+  // TwoBody_rhoG for the proposed move
+  std::vector<ComplexType> TwoBody_rhoG_new;
+  // One-body value, gradient and laplacian of each electron
+  std::vector<RealType> OneBodyU, OneBodyLap;
+  std::vector<PosType> OneBodyGrad;
+  // One-body value, gradient and laplacian for the proposed move
+  RealType curOneBodyU, curOneBodyLap;
+  PosType curOneBodyGrad;
 
   // Map of the optimizable variables:
   //std::map<std::string,RealType*> VarMap;
@@ -136,6 +144,17 @@ private:
   bool Equivalent (PosType G1, PosType G2);
   void StructureFactor(PosType G, std::vector<ComplexType>& rho_G);
 
+  // One-body value, gradient and laplacian at r
+  void evaluateOneBody(const PosType& r, RealType& u, PosType& grad, RealType& lap);
+  // z[iG] = e^{iG.r} for the two-body G-vectors
+  void evaluateTwoBodyE2iGr(const PosType& r, ComplexType* restrict z);
+  // Two-body gradient of an electron with e^{iG.r}=z[iG] for the structure factor rhoG
+  PosType evaluateTwoBodyGrad(const ComplexType* restrict rhoG, const ComplexType* restrict z);
+  // Rebuild TwoBody_rhoG, TwoBody_e2iGr and the one-body terms from the positions
+  void recompute(ParticleSet& P);
+  // Change of the log for a move of iat to rnew, sets the data used by acceptMove
+  RealType computeDelta(const PosType& rnew, int iat);
+
   const ParticleSet &Ions;
   ParticleSet &Elecs;
   std::string OneBodyID;
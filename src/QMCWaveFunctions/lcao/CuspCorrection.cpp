@@ -18,6 +18,8 @@
 #include "QMCWaveFunctions/lcao/SoaAtomicBasisSet.h"
 #include "QMCWaveFunctions/lcao/MultiQuinticSpline1D.h"
 #include "QMCWaveFunctions/lcao/SoaCartesianTensor.h"
+#include <cstdint>
+#include <sstream>
 
 
 namespace qmcplusplus
@@ -199,5 +201,123 @@ void computeRadialPhiBar(ParticleSet* targetP,
   }
 }
 
+void computeRadialPhiBar(ParticleSet* targetP,
+                         ParticleSet* sourceP,
+                         int curCenter_,
+                         SPOSet* Phi,
+                         const Vector<QMCTraits::RealType>& xgrid,
+                         int first,
+                         int last,
+                         std::vector<double>& rad_orbs,
+                         const Matrix<CuspCorrectionParameters>& info)
+{
+  CuspCorrection cusp(targetP, sourceP);
+  cusp.setPsi(Phi);
+  cusp.curCenter = curCenter_;
+
+  const int ngrid = xgrid.size();
+  const int norb  = Phi->OrbitalSetSize;
+  for (int ig = first; ig < last; ig++)
+  {
+    const QMCTraits::RealType r = xgrid[ig];
+    // phi() evaluates every orbital, the values are kept in val1
+    cusp.phi(r);
+    for (int mo_idx = 0; mo_idx < norb; mo_idx++)
+    {
+      cusp.cparam                     = info(curCenter_, mo_idx);
+      rad_orbs[mo_idx * ngrid + ig] = (r <= cusp.cparam.Rc) ? cusp.cparam.C + cusp.Rr(r) : cusp.val1[mo_idx];
+    }
+  }
+}
+
+namespace
+{
+/// 64-bit FNV-1a hash
+struct CuspInputHash
+{
+  uint64_t h;
+  CuspInputHash() : h(14695981039346656037ULL) {}
+  void add(const void* p, size_t n)
+  {
+    const unsigned char* c = static_cast<const unsigned char*>(p);
+    for (size_t i = 0; i < n; i++)
+    {
+      h ^= c[i];
+      h *= 1099511628211ULL;
+    }
+  }
+};
+} // namespace
+
+std::string hashCuspInputs(ParticleSet& targetP, ParticleSet& sourceP, LCAOrbitalSet& Phi)
+{
+  typedef QMCTraits::RealType RealType;
+  CuspInputHash hash;
+
+  const int num_centers = sourceP.getTotalNum();
+  const int norb        = Phi.OrbitalSetSize;
+  const int bss         = Phi.BasisSetSize;
+  hash.add(&num_centers, sizeof(int));
+  hash.add(&norb, sizeof(int));
+  hash.add(&bss, sizeof(int));
+  for (int ic = 0; ic < num_centers; ic++)
+  {
+    hash.add(&sourceP.GroupID[ic], sizeof(int));
+    hash.add(&sourceP.R[ic][0], OHMMS_DIM * sizeof(RealType));
+  }
+  if (Phi.C != nullptr)
+    hash.add(Phi.C->data(), Phi.C->size() * sizeof(LCAOrbitalSet::ValueType));
+
+  // the probes move an electron of a copy, targetP is left as is
+  ParticleSet probeP(targetP);
+  // two probe points at different distances sample both the tight and the diffuse functions
+  const TinyVector<RealType, 3> probes[2] = {TinyVector<RealType, 3>(0.13, 0.07, -0.05),
+                                            TinyVector<RealType, 3>(0.61, -0.37, 0.29)};
+  typedef LCAOrbitalSet::basis_type::value_type basis_value_type;
+  std::vector<basis_value_type> vals(bss);
+  for (int ic = 0; ic < num_centers; ic++)
+    for (int ip = 0; ip < 2; ip++)
+    {
+      probeP.R[0] = sourceP.R[ic];
+      probeP.makeMove(0, probes[ip]);
+      Phi.myBasisSet->evaluateV(probeP, 0, vals.data());
+      hash.add(vals.data(), bss * sizeof(basis_value_type));
+    }
+
+  std::ostringstream o;
+  o << std::hex << hash.h;
+  return o.str();
+}
+
+void packCuspInfo(const Matrix<CuspCorrectionParameters>& info, std::vector<double>& params)
+{
+  params.resize(info.size() * 9);
+  for (int i = 0; i < info.size(); i++)
+  {
+    const CuspCorrectionParameters& p(info(i));
+    double* restrict out = params.data() + i * 9;
+    out[0]               = p.redo;
+    out[1]               = p.C;
+    out[2]               = p.sg;
+    out[3]               = p.Rc;
+    for (int k = 0; k < 5; k++)
+      out[4 + k] = p.alpha[k];
+  }
+}
+
+void unpackCuspInfo(const std::vector<double>& params, Matrix<CuspCorrectionParameters>& info)
+{
+  for (int i = 0; i < info.size(); i++)
+  {
+    CuspCorrectionParameters& p(info(i));
+    const double* restrict in = params.data() + i * 9;
+    p.redo                    = in[0];
+    p.C                       = in[1];
+    p.sg                      = in[2];
+    p.Rc                      = in[3];
+    for (int k = 0; k < 5; k++)
+      p.alpha[k] = in[4 + k];
+  }
+}
 
 }; // namespace qmcplusplus
@@ -158,6 +158,36 @@ void computeRadialPhiBar(ParticleSet* targetP,
                          Vector<QMCTraits::RealType>& rad_orb,
                          const CuspCorrectionParameters& data);
 
+/** Compute the radial part of the corrected wavefunction of all the orbitals on a center
+ * @param first first grid point computed
+ * @param last one past the last grid point computed
+ * @param rad_orbs rad_orbs[mo_idx*xgrid.size()+ig], only [first,last) of each orbital is set
+ *
+ * All the orbitals are evaluated at once on each grid point.
+ */
+void computeRadialPhiBar(ParticleSet* targetP,
+                         ParticleSet* sourceP,
+                         int curCenter_,
+                         SPOSet* Phi,
+                         const Vector<QMCTraits::RealType>& xgrid,
+                         int first,
+                         int last,
+                         std::vector<double>& rad_orbs,
+                         const Matrix<CuspCorrectionParameters>& info);
+
+/** Hash of the inputs of the cusp correction, the cache key
+ *
+ * The basis set enters through its values on probe points around each center,
+ * the MO coefficients and the geometry are hashed exactly.
+ */
+std::string hashCuspInputs(ParticleSet& targetP, ParticleSet& sourceP, LCAOrbitalSet& Phi);
+
+/// Pack the cusp parameters of all the centers and orbitals, nine per orbital
+void packCuspInfo(const Matrix<CuspCorrectionParameters>& info, std::vector<double>& params);
+
+/// Unpack the cusp parameters, inverse of packCuspInfo
+void unpackCuspInfo(const std::vector<double>& params, Matrix<CuspCorrectionParameters>& info);
+
 
 } // namespace qmcplusplus
 
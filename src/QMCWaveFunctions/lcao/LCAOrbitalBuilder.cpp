@@ -34,6 +34,7 @@
 #include "io/hdf_archive.h"
 #include "Message/CommOperators.h"
 #include "Utilities/ProgressReportEngine.h"
+#include "Utilities/FairDivide.h"
 
 namespace qmcplusplus
 {
@@ -104,7 +105,8 @@ namespace qmcplusplus
 
 
   LCAOrbitalBuilder::LCAOrbitalBuilder(ParticleSet& els, ParticleSet& ions, Communicate *comm, xmlNodePtr cur)
-    : SPOSetBuilder(comm), targetPtcl(els), sourcePtcl(ions), myBasisSet(nullptr), h5_path(""), doCuspCorrection(false)
+    : SPOSetBuilder(comm), targetPtcl(els), sourcePtcl(ions), myBasisSet(nullptr), h5_path(""), ScreeningTolerance(0),
+      doCuspCorrection(false)
   {
     ClassName="LCAOrbitalBuilder";
     ReportEngine PRE(ClassName,"createBasisSet");
@@ -121,6 +123,7 @@ namespace qmcplusplus
     aAttrib.add(cuspInfo,"cuspInfo");
     aAttrib.add(h5_path,"href");
     aAttrib.add(PBCImages,"PBCimages");
+    aAttrib.add(ScreeningTolerance,"screening_tolerance");
     aAttrib.put(cur);
 
     if(cur != NULL) aAttrib.put(cur);
@@ -139,6 +142,9 @@ namespace qmcplusplus
 
     if (cuspC == "yes") doCuspCorrection = true;
 
+    if(ScreeningTolerance>0)
+      app_log() << "  LCAO: skip the basis functions smaller than " << ScreeningTolerance << std::endl;
+
     // no need to wait but load the basis set
     if(h5_path!="") loadBasisSetFromH5();
   }
@@ -310,6 +316,7 @@ namespace qmcplusplus
         if(it == ao_built_centers.end())
         {
           AOBasisBuilder<ao_type> any(elementType, myComm);
+          any.radFuncBuilder.CutoffTolerance=ScreeningTolerance;
           any.put(cur);
           ao_type* aoBasis = any.createAOSet(cur);
           if(aoBasis)
@@ -325,7 +332,8 @@ namespace qmcplusplus
     } // done with basis set
 
     mBasisSet->setBasisSetSize(-1);
-    mBasisSet->setPBCImages(PBCImages);
+    mBasisSet->setPBCImages(PBCImages,targetPtcl.Lattice);
+    mBasisSet->setScreening(ScreeningTolerance>0);
     return mBasisSet;
   }
 
@@ -389,6 +397,7 @@ namespace qmcplusplus
       if(it == ao_built_centers.end())
       {
         AOBasisBuilder<ao_type> any(elementType,myComm);
+        any.radFuncBuilder.CutoffTolerance=ScreeningTolerance;
         any.putH5(hin);
         ao_type* aoBasis = any.createAOSetH5(hin);
         if(aoBasis)
@@ -411,14 +420,22 @@ namespace qmcplusplus
     }
 
     mBasisSet->setBasisSetSize(-1);
-    mBasisSet->setPBCImages(PBCImages);
+    mBasisSet->setPBCImages(PBCImages,targetPtcl.Lattice);
+    mBasisSet->setScreening(ScreeningTolerance>0);
     return mBasisSet;
   }
 
-  // Modifies orbital set lcwc
-  void createCuspCorrection(const Matrix<CuspCorrectionParameters> &info, int num_centers,
+  /** Modifies orbital set lcwc
+   * @param info cusp parameters, read from the cache when have_info is false
+   * @param have_info true if info is read from a cuspInfo file
+   *
+   * The radial tables of the corrected orbitals are cached in id.cusp.h5, in a group named by hashCuspInputs.
+   * The cache is used when the hash and the parameters match. Otherwise the grid points are
+   * distributed over the ranks and the threads and the tables are saved by the root.
+   */
+  void createCuspCorrection(Matrix<CuspCorrectionParameters> &info, bool have_info, int num_centers,
                             int orbital_set_size, ParticleSet& targetPtcl, ParticleSet& sourcePtcl,
-                            LCAOrbitalSetWithCorrection& lcwc, const std::string &id)
+                            LCAOrbitalSetWithCorrection& lcwc, const std::string &id, Communicate* comm)
   {
     typedef QMCTraits::RealType RealType;
 
@@ -437,15 +454,80 @@ namespace qmcplusplus
 
     LogGrid<RealType>* radial_grid = new LogGrid<RealType>;
     radial_grid->set(0.000001, 100.0, 1001);
+    const int ngrid = radial_grid->size();
 
     Vector<RealType> xgrid;
     Vector<RealType> rad_orb;
-    xgrid.resize(radial_grid->size());
-    rad_orb.resize(radial_grid->size());
-    for (int ig=0; ig < radial_grid->size(); ig++) {
+    xgrid.resize(ngrid);
+    rad_orb.resize(ngrid);
+    for (int ig=0; ig < ngrid; ig++) {
       xgrid[ig] = radial_grid->r(ig);
     }
 
+    const bool root = (comm->rank() == 0);
+    const std::string hash = hashCuspInputs(targetPtcl, sourcePtcl, lcwc);
+    const std::string cachefile = id + ".cusp.h5";
+    std::vector<double> params;
+    if (have_info) packCuspInfo(info, params);
+
+    // each set of inputs has its own group, named by the hash
+    hdf_archive h5f;
+    int foundcache = 0;
+    bool writecache = false;
+    if (root)
+    {
+      writecache = h5f.open(cachefile, H5F_ACC_RDWR) || h5f.create(cachefile);
+      if (writecache && h5f.is_group(hash))
+      {
+        h5f.push(hash, false);
+        int complete = 0;
+        std::vector<double> cached_params;
+        foundcache = h5f.read(complete, "complete") && complete;
+        foundcache = foundcache && h5f.read(cached_params, "parameters");
+        foundcache = foundcache && (cached_params.size() == info.size() * 9);
+        // the parameters of cuspInfo are never replaced by the cached ones
+        if (have_info)
+          foundcache = foundcache && (cached_params == params);
+        else if (foundcache)
+          params = cached_params;
+        h5f.pop();
+        if (!foundcache) h5f.unlink(hash);
+      }
+      if (writecache) h5f.push(hash, true);
+    }
+    comm->bcast(foundcache);
+    if (!foundcache && !have_info)
+      APP_ABORT("cusp file required, no matching cusp cache in " + cachefile);
+    if (foundcache)
+    {
+      app_log() << "  Use existing cusp correction tables in " << cachefile << std::endl;
+      if (!have_info)
+      {
+        comm->bcast(params);
+        unpackCuspInfo(params, info);
+      }
+    }
+    else
+    {
+      app_log() << "  Computing cusp correction tables, hash " << hash << std::endl;
+      if (writecache) h5f.write(params, "parameters");
+    }
+
+    // grid points of this rank
+    std::vector<int> rank_grid(comm->size() + 1);
+    FairDivideLow(ngrid, comm->size(), rank_grid);
+    const int num_threads = omp_get_max_threads();
+    // the clones of phi share the coefficients split for each center
+    std::vector<ParticleSet*> targetPtcls(num_threads, nullptr);
+    std::vector<SPOSet*> phis(num_threads, nullptr);
+    if (!foundcache)
+      for (int ip = 0; ip < num_threads; ip++)
+      {
+        targetPtcls[ip] = new ParticleSet(targetPtcl);
+        phis[ip] = phi.makeClone();
+      }
+    std::vector<double> rad_orbs(orbital_set_size * ngrid);
+
     for (int ic = 0; ic < num_centers; ic++)
     {
       *(eta.C) = *(lcwc.C);
@@ -453,6 +535,28 @@ namespace qmcplusplus
 
       splitPhiEta(ic, corrCenter, phi, eta);
 
+      const std::string center_name = "center_" + std::to_string(ic);
+      if (foundcache)
+      {
+        if (root) h5f.read(rad_orbs, center_name);
+        comm->bcast(rad_orbs);
+      }
+      else
+      {
+        std::fill(rad_orbs.begin(), rad_orbs.end(), 0.0);
+        #pragma omp parallel
+        {
+          const int ip = omp_get_thread_num();
+          std::vector<int> thread_grid(num_threads + 1);
+          FairDivideLow(rank_grid[comm->rank() + 1] - rank_grid[comm->rank()], num_threads, thread_grid);
+          const int first = rank_grid[comm->rank()];
+          computeRadialPhiBar(targetPtcls[ip], &sourcePtcl, ic, phis[ip], xgrid,
+                              first + thread_grid[ip], first + thread_grid[ip + 1], rad_orbs, info);
+        }
+        comm->allreduce(rad_orbs);
+        if (writecache) h5f.write(rad_orbs, center_name);
+      }
+
       // loop over MO index - cot must be an array (of len MO size)
       //   the loop is inside cot - in the multiqunitic
       SoaCuspCorrection::COT *cot = new CuspCorrectionAtomicBasis<RealType>();
@@ -463,7 +567,7 @@ namespace qmcplusplus
       }
 
       for (int mo_idx = 0; mo_idx < orbital_set_size; mo_idx++) {
-        computeRadialPhiBar(&targetPtcl, &sourcePtcl, mo_idx, ic, &phi, xgrid, rad_orb, info(ic, mo_idx));
+        std::copy_n(rad_orbs.data() + mo_idx * ngrid, ngrid, rad_orb.data());
         OneDimQuinticSpline<RealType> radial_spline(radial_grid, rad_orb);
         RealType yprime_i = (rad_orb[1] - rad_orb[0])/(radial_grid->r(1) - radial_grid->r(0));
         radial_spline.spline(0, yprime_i, rad_orb.size()-1, 0.0);
@@ -496,6 +600,21 @@ namespace qmcplusplus
       }
       lcwc.cusp.add(ic, cot);
     }
+
+    // the flag is written last, an incomplete cache never matches
+    if (writecache)
+    {
+      int complete = 1;
+      if (!foundcache) h5f.write(complete, "complete");
+      h5f.close();
+    }
+    for (int ip = 0; ip < num_threads; ip++)
+    {
+      if (phis[ip] != nullptr)
+        delete static_cast<LCAOrbitalSet*>(phis[ip])->myBasisSet;
+      delete phis[ip];
+      delete targetPtcls[ip];
+    }
     removeSTypeOrbitals(corrCenter, lcwc);
   }
 
@@ -524,10 +643,6 @@ namespace qmcplusplus
     loadMO(*lcos, cur);
 
     if (doCuspCorrection) {
-      if (cusp_file == "") {
-          APP_ABORT("cusp file required for now");
-      }
-
       int num_centers = sourcePtcl.getTotalNum();
 
       // Sometimes sposet attribute is 'name' and sometimes it is 'id'
@@ -535,13 +650,17 @@ namespace qmcplusplus
 
       int orbital_set_size = lcos->OrbitalSetSize;
 
+      // without a cusp file, the parameters must come from the cache
       Matrix<CuspCorrectionParameters> info(num_centers, orbital_set_size);
-      bool okay = readCuspInfo(cusp_file, id, orbital_set_size, info);
-      if (!okay) {
-          APP_ABORT("failure in reading cusp info file");
+      bool have_info = (cusp_file != "");
+      if (have_info) {
+        bool okay = readCuspInfo(cusp_file, id, orbital_set_size, info);
+        if (!okay) {
+            APP_ABORT("failure in reading cusp info file");
+        }
       }
 
-      createCuspCorrection(info, num_centers, orbital_set_size, targetPtcl, sourcePtcl, *lcwc, id);
+      createCuspCorrection(info, have_info, num_centers, orbital_set_size, targetPtcl, sourcePtcl, *lcwc, id, myComm);
     }
 
 
@@ -59,6 +59,8 @@ namespace qmcplusplus
     std::string h5_path;
     ///Number of periodic Images for Orbital evaluation
     TinyVector<int,3> PBCImages;
+    ///if positive, the basis functions below this tolerance are skipped
+    RealType ScreeningTolerance;
 
     /// Enable cusp correction
     bool doCuspCorrection;
@@ -15,6 +15,8 @@
 
 namespace qmcplusplus
 {
+  const int LCAOrbitalSet::BatchSize;
+
   LCAOrbitalSet::LCAOrbitalSet(basis_type* bs,int rl):
     myBasisSet(nullptr), C(nullptr), ReportLevel(rl),
     BasisSetSize(0), Identity(true), IsCloned(false)
@@ -62,6 +64,85 @@ namespace qmcplusplus
     return myclone;
   }
 
+  /** b=A*x using only the ranges of x above the screening tolerance
+   * @param A matrix(OrbitalSetSize,BasisSetSize)
+   * @param ranges [first,last) ranges of the significant elements of x
+   */
+  template<typename T>
+    inline void Product_sparse(const Matrix<T>& A, const std::vector<std::pair<int,int> >& ranges,
+        const T* restrict x, T* restrict b)
+    {
+      constexpr char transa = 't';
+      constexpr T zone(1);
+      constexpr T zero(0);
+      if(ranges.empty())
+      {
+        std::fill_n(b,A.rows(),zero);
+        return;
+      }
+      T beta=zero;
+      for(const auto& r : ranges)
+      {
+        BLAS::gemv(transa, r.second-r.first, A.rows(),
+            zone, A.data()+r.first, A.cols(), x+r.first, 1,
+            beta, b, 1);
+        beta=zone;
+      }
+    }
+
+  /** C=A*B^t using only the columns of A in the ranges
+   * @param nrows number of rows of A and C in use
+   */
+  template<typename T>
+    inline void Product_ABt_ranges(const Matrix<T>& A, const Matrix<T>& B,
+        const std::vector<std::pair<int,int> >& ranges, Matrix<T>& C, int nrows)
+    {
+      constexpr char transa = 't';
+      constexpr char transb = 'n';
+      constexpr T zone(1);
+      constexpr T zero(0);
+      if(ranges.empty())
+      {
+        std::fill_n(C.data(),nrows*C.cols(),zero);
+        return;
+      }
+      T beta=zero;
+      for(const auto& r : ranges)
+      {
+        BLAS::gemm(transa, transb, B.rows(), nrows, r.second-r.first,
+            zone, B.data()+r.first, B.cols(), A.data()+r.first, A.cols(),
+            beta, C.data(), C.cols());
+        beta=zone;
+      }
+    }
+
+  void LCAOrbitalSet::markSignificant()
+  {
+    if(!myBasisSet->Screening) return;
+    batchMask.resize(BasisSetSize,0);
+    for(const auto& r : myBasisSet->SignificantRanges)
+      std::fill(batchMask.begin()+r.first,batchMask.begin()+r.second,1);
+  }
+
+  void LCAOrbitalSet::collectSignificant()
+  {
+    batchRanges.clear();
+    if(!myBasisSet->Screening)
+    {
+      batchRanges.push_back(std::make_pair(0,BasisSetSize));
+      return;
+    }
+    for(int ib=0; ib<batchMask.size(); ib++)
+    {
+      if(!batchMask[ib]) continue;
+      if(batchRanges.size() && batchRanges.back().second==ib)
+        batchRanges.back().second=ib+1;
+      else
+        batchRanges.push_back(std::make_pair(ib,ib+1));
+      batchMask[ib]=0;
+    }
+  }
+
   void LCAOrbitalSet::evaluate(const ParticleSet& P, 
       int iat, ValueVector_t& psi)
   {
@@ -73,7 +154,10 @@ namespace qmcplusplus
     {
       Vector<ValueType> vTemp(Temp.data(0),BasisSetSize);
       myBasisSet->evaluateV(P,iat,vTemp.data());
-      simd::gemv(*C,Temp.data(0),psi.data());
+      if(myBasisSet->Screening)
+        Product_sparse(*C,myBasisSet->SignificantRanges,Temp.data(0),psi.data());
+      else
+        simd::gemv(*C,Temp.data(0),psi.data());
     }
   }
 
@@ -90,6 +174,31 @@ namespace qmcplusplus
           zero, C.data(), C.capacity());
     }
 
+  /** Product_ABt using only the significant ranges of the basis functions */
+  template<typename T,unsigned D>
+    inline void Product_ABt_sparse(const VectorSoaContainer<T,D>& A, const Matrix<T>& B,
+        const std::vector<std::pair<int,int> >& ranges, VectorSoaContainer<T,D>& C)
+    {
+      constexpr char transa = 't';
+      constexpr char transb = 'n';
+      constexpr T zone(1);
+      constexpr T zero(0);
+      if(ranges.empty())
+      {
+        for(int i=0; i<D; i++)
+          std::fill_n(C.data(i),C.size(),zero);
+        return;
+      }
+      T beta=zero;
+      for(const auto& r : ranges)
+      {
+        BLAS::gemm(transa, transb, B.rows(), D, r.second-r.first,
+            zone, B.data()+r.first, B.cols(), A.data()+r.first, A.capacity(),
+            beta, C.data(), C.capacity());
+        beta=zone;
+      }
+    }
+
   inline void LCAOrbitalSet::evaluate_vgl_impl(const vgl_type& temp,
       ValueVector_t& psi, GradVector_t& dpsi, ValueVector_t& d2psi) const
   {
@@ -115,7 +224,10 @@ namespace qmcplusplus
         evaluate_vgl_impl(Temp,psi,dpsi,d2psi);
       else
       {
-        Product_ABt(Temp,*C,Tempv);
+        if(myBasisSet->Screening)
+          Product_ABt_sparse(Temp,*C,myBasisSet->SignificantRanges,Tempv);
+        else
+          Product_ABt(Temp,*C,Tempv);
         evaluate_vgl_impl(Tempv,psi,dpsi,d2psi);
       }
     }
@@ -128,8 +240,16 @@ namespace qmcplusplus
     {
       Vector<RealType> vTemp(basisM[j],BasisSetSize);
       myBasisSet->evaluateV(VP,j,vTemp.data());
+      markSignificant();
     }
-    MatrixOperators::product_ABt(basisM,*C,psiM);
+    if(myBasisSet->Screening)
+    {
+      // the knots share most of their significant basis functions
+      collectSignificant();
+      Product_ABt_ranges(basisM,*C,batchRanges,psiM,nVP);
+    }
+    else
+      MatrixOperators::product_ABt(basisM,*C,psiM);
   }
 
   size_t LCAOrbitalSet::estimateMemory(const int nP) { return BasisSetSize*nP; }
@@ -176,11 +296,39 @@ namespace qmcplusplus
     }
     else
     {
-      for(size_t i=0, iat=first; iat<last; i++,iat++)
+      // multiply the basis functions of BatchSize particles by C with one gemm
+      constexpr int D=OHMMS_DIM+2;
+      batchTemp.resize(BatchSize*D,BasisSetSize);
+      batchTempv.resize(BatchSize*D,OrbitalSetSize);
+      for(int iat_first=first; iat_first<last; iat_first+=BatchSize)
       {
-        myBasisSet->evaluateVGL(P,iat,Temp);
-        Product_ABt(Temp,*C,Tempv);
-        evaluate_vgl_impl(Tempv,i,logdet,dlogdet,d2logdet);
+        const int nw=std::min(BatchSize,last-iat_first);
+        for(int iw=0; iw<nw; iw++)
+        {
+          myBasisSet->evaluateVGL(P,iat_first+iw,Temp);
+          for(int k=0; k<D; k++)
+            simd::copy_n(Temp.data(k),BasisSetSize,batchTemp[iw*D+k]);
+          markSignificant();
+        }
+        collectSignificant();
+        Product_ABt_ranges(batchTemp,*C,batchRanges,batchTempv,nw*D);
+
+        for(int iw=0, i=iat_first-first; iw<nw; iw++, i++)
+        {
+          const ValueType* restrict v=batchTempv[iw*D];
+          const ValueType* restrict gx=batchTempv[iw*D+1];
+          const ValueType* restrict gy=batchTempv[iw*D+2];
+          const ValueType* restrict gz=batchTempv[iw*D+3];
+          const ValueType* restrict l=batchTempv[iw*D+4];
+          simd::copy_n(v,OrbitalSetSize,logdet[i]);
+          for(size_t j=0; j<OrbitalSetSize; j++)
+          {
+            dlogdet[i][j][0]=gx[j];
+            dlogdet[i][j][1]=gy[j];
+            dlogdet[i][j][2]=gz[j];
+          }
+          simd::copy_n(l,OrbitalSetSize,d2logdet[i]);
+        }
       }
     }
   }
@@ -48,6 +48,16 @@ namespace qmcplusplus
     vgl_type Temp; 
     ///Tempv(OrbitalSetSize) Tempv=C*Temp
     vgl_type Tempv; 
+    ///number of particles whose basis functions are multiplied by C at once
+    static const int BatchSize=32;
+    ///basis functions of a batch of particles, row 5*i+k holds the component k=V,Gx,Gy,Gz,L of particle i
+    ValueMatrix_t batchTemp;
+    ///batchTempv=batchTemp*C^t
+    ValueMatrix_t batchTempv;
+    ///true for the basis functions significant for any particle of the batch
+    std::vector<char> batchMask;
+    ///[first,last) ranges of batchMask
+    std::vector<std::pair<int,int> > batchRanges;
 
     /** constructor
      * @param bs pointer to the BasisSet
@@ -121,6 +131,11 @@ namespace qmcplusplus
 
     void evaluateThirdDeriv(const ParticleSet& P, int first, int last , GGGMatrix_t& grad_grad_grad_logdet);
 
+    ///add the significant basis functions of the last evaluated particle to batchMask
+    void markSignificant();
+    ///convert batchMask to batchRanges and clear batchMask, all the basis functions without screening
+    void collectSignificant();
+
     //helper functions to handl Identity
     void evaluate_vgl_impl(const vgl_type& temp,
         ValueVector_t& psi, GradVector_t& dpsi, ValueVector_t& d2psi) const;
@@ -70,6 +70,126 @@ namespace qmcplusplus
           d2u[i]=Rnl[i]->d2Y;
         }
       }
+
+      ///nothing to prepare
+      inline void finalize() { }
+    };
+
+  /** MultiFunctorAdapter for contracted Gaussians
+   *
+   * finalize() packs the exponents and the contraction coefficients of all the
+   * radial functions of a center in SoA arrays, the primitives of Rnl[i] being
+   * [First[i],First[i+1]). The primitives are evaluated in one SIMD loop
+   * and summed per radial function.
+   */
+  template<typename T>
+    struct MultiFunctorAdapter<GaussianCombo<T> >
+    {
+      typedef typename GaussianCombo<T>::real_type value_type;
+      typedef LogGridLight<value_type> grid_type;
+      typedef GaussianCombo<T> single_type;
+      aligned_vector<single_type*> Rnl;
+      ///exponents of the primitives
+      aligned_vector<value_type> Alpha;
+      ///normalized contraction coefficients of the primitives
+      aligned_vector<value_type> Coeff;
+      ///index of the first primitive of each radial function
+      aligned_vector<int> First;
+      ///value, first and second derivatives of the primitives
+      VectorSoaContainer<value_type,3> tempP;
+
+      MultiFunctorAdapter<single_type>* makeClone() const
+      {
+        MultiFunctorAdapter<single_type>* clone=new MultiFunctorAdapter<single_type>(*this);
+        for(size_t i=0; i<Rnl.size(); ++i)
+          clone->Rnl[i]=new single_type(*Rnl[i]);
+        return clone;
+      }
+
+      ~MultiFunctorAdapter()
+      {
+        for(size_t i=0; i<Rnl.size(); ++i) delete Rnl[i];
+      }
+
+      inline value_type rmax() const
+      {
+        constexpr value_type r0(100);
+        return r0;
+      }
+
+      inline void finalize()
+      {
+        Alpha.clear();
+        Coeff.clear();
+        First.resize(Rnl.size()+1);
+        First[0]=0;
+        for(size_t i=0; i<Rnl.size(); ++i)
+        {
+          for(const auto& g : Rnl[i]->gset)
+          {
+            Alpha.push_back(g.Sigma);
+            Coeff.push_back(g.Coeff);
+          }
+          First[i+1]=Alpha.size();
+        }
+        tempP.resize(Alpha.size());
+      }
+
+      inline void evaluate(value_type r, value_type* restrict u)
+      {
+        const value_type mrr=-r*r;
+        const size_t np=Alpha.size();
+        const value_type* restrict alpha=Alpha.data();
+        const value_type* restrict coeff=Coeff.data();
+        value_type* restrict v=tempP.data(0);
+        #pragma omp simd aligned(alpha,coeff,v)
+        for(size_t p=0; p<np; ++p)
+          v[p]=coeff[p]*std::exp(alpha[p]*mrr);
+
+        for(size_t i=0, n=Rnl.size(); i<n; ++i)
+        {
+          value_type sum(0);
+          for(int p=First[i]; p<First[i+1]; ++p)
+            sum+=v[p];
+          u[i]=sum;
+        }
+      }
+
+      inline void evaluate(value_type r, value_type* restrict u, value_type* restrict du, value_type* restrict d2u)
+      {
+        constexpr value_type ctwo(2);
+        constexpr value_type cfour(4);
+        const value_type rr=r*r;
+        const size_t np=Alpha.size();
+        const value_type* restrict alpha=Alpha.data();
+        const value_type* restrict coeff=Coeff.data();
+        value_type* restrict v=tempP.data(0);
+        value_type* restrict dv=tempP.data(1);
+        value_type* restrict d2v=tempP.data(2);
+        #pragma omp simd aligned(alpha,coeff,v,dv,d2v)
+        for(size_t p=0; p<np; ++p)
+        {
+          const value_type a=alpha[p];
+          const value_type e=coeff[p]*std::exp(-a*rr);
+          v[p]=e;
+          dv[p]=-ctwo*a*r*e;
+          d2v[p]=(cfour*a*a*rr-ctwo*a)*e;
+        }
+
+        for(size_t i=0, n=Rnl.size(); i<n; ++i)
+        {
+          value_type sum(0), dsum(0), d2sum(0);
+          for(int p=First[i]; p<First[i+1]; ++p)
+          {
+            sum+=v[p];
+            dsum+=dv[p];
+            d2sum+=d2v[p];
+          }
+          u[i]=sum;
+          du[i]=dsum;
+          d2u[i]=d2sum;
+        }
+      }
     };
 
   template<typename FN, typename SH>
@@ -86,10 +206,12 @@ namespace qmcplusplus
       COT* m_orbitals;
       ///temporary
       RadialOrbital_t* m_multiset;
+      ///if positive, the tolerance of the cutoff radius of each radial orbital
+      double CutoffTolerance;
 
       ///constructor
       RadialOrbitalSetBuilder(Communicate* comm)
-        : m_multiset(nullptr), Normalized(true), MPIObjectBase(comm)
+        : m_multiset(nullptr), Normalized(true), CutoffTolerance(0), MPIObjectBase(comm)
       { }
 
       ///implement functions used by AOBasisBuilder
@@ -119,6 +241,9 @@ namespace qmcplusplus
 
         m_orbitals->RnlID.push_back(nlms);
         m_multiset->Rnl.push_back(radorb);
+        m_orbitals->RnlCutoff.resize(m_orbitals->RnlID.size(),-1);
+        if(CutoffTolerance>0)
+          m_orbitals->RnlCutoff.back()=radial_cutoff(*radorb,nlms[q_l],CutoffTolerance);
         return true;
       }
 
@@ -132,12 +257,16 @@ namespace qmcplusplus
 
         m_orbitals->RnlID.push_back(nlms);
         m_multiset->Rnl.push_back(radorb);
+        m_orbitals->RnlCutoff.resize(m_orbitals->RnlID.size(),-1);
+        if(CutoffTolerance>0)
+          m_orbitals->RnlCutoff.back()=radial_cutoff(*radorb,nlms[q_l],CutoffTolerance);
 
         return true;
       }
 
       void finalize() 
       {
+        m_multiset->finalize();
         m_orbitals->MultiRnl=m_multiset;
         m_orbitals->setRmax(m_multiset->rmax()); //set Rmax
       }
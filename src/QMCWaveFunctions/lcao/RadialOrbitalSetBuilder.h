@@ -16,6 +16,7 @@
 #ifndef QMCPLUSPLUS_RADIAL_NUMERICALGRIDORBITALBUILDER_H
 #define QMCPLUSPLUS_RADIAL_NUMERICALGRIDORBITALBUILDER_H
 
+#include <limits>
 #include "Configuration.h"
 #include "OhmmsData/HDFAttribIO.h"
 #include <HDFVersion.h>
@@ -56,6 +57,53 @@ namespace qmcplusplus
       return static_cast<double>(r);
     }
 
+  /** compute the cutoff radius of a contracted Gaussian from its exponents
+   * @param in contracted Gaussian \f$ \sum_i c_i \exp(-\alpha_i r^2) \f$
+   * @param l angular momentum
+   * @param eps tolerance
+   * @return r_c such that \f$ r^l \sum_i |c_i| \exp(-\alpha_i r^2) < eps \f$ for \f$ r>r_c \f$
+   */
+  template<typename T>
+    inline double radial_cutoff(const GaussianCombo<T>& in, int l, double eps)
+    {
+      double alpha_min=std::numeric_limits<double>::max();
+      for(const auto& g : in.gset)
+        alpha_min=std::min(alpha_min,static_cast<double>(g.Sigma));
+      auto bound=[&](double r)
+      {
+        double res=0;
+        for(const auto& g : in.gset)
+          res+=std::abs(g.Coeff)*std::exp(-g.Sigma*r*r);
+        return res*std::pow(r,l);
+      };
+
+      // every primitive decays beyond the maximum of the most diffuse one
+      double r_lo=std::sqrt(0.5*l/alpha_min);
+      if(bound(r_lo)<eps) return r_lo;
+      double r_hi=std::max(2*r_lo,1.0);
+      while(bound(r_hi)>=eps)
+      {
+        r_lo=r_hi;
+        r_hi*=2;
+      }
+      for(int i=0; i<40; i++)
+      {
+        const double r=0.5*(r_lo+r_hi);
+        if(bound(r)<eps)
+          r_hi=r;
+        else
+          r_lo=r;
+      }
+      return r_hi;
+    }
+
+  /// the cutoff radius of the other radial functors is unknown
+  template<typename FN>
+    inline double radial_cutoff(const FN& in, int l, double eps)
+    {
+      return -1.0;
+    }
+
   /** abstract class to defer generation of spline functors
    * @tparam T precision of the final result
   */
@@ -125,6 +173,8 @@ public:
   RealType m_rcut;
   ///the quantum number of this node
   QuantumNumberType m_nlms;
+  ///if positive, the tolerance of the cutoff radius of each Gaussian radial orbital
+  RealType CutoffTolerance;
 
   ///constructor
   RadialOrbitalSetBuilder(Communicate* comm);
@@ -179,7 +229,7 @@ private:
   template<typename COT>
     RadialOrbitalSetBuilder<COT>::RadialOrbitalSetBuilder(Communicate* comm)
     : Normalized(true), m_orbitals(nullptr), input_grid(nullptr),
-      m_rcut(-1.0), MPIObjectBase(comm)
+      m_rcut(-1.0), CutoffTolerance(0), MPIObjectBase(comm)
     { }
 
   template<typename COT>
@@ -408,6 +458,9 @@ private:
     m_rcut_safe=std::max(m_rcut_safe,r0);
     radTemp.push_back(new A2NTransformer<RealType,gto_type>(gset));
     m_orbitals->RnlID.push_back(m_nlms);
+    m_orbitals->RnlCutoff.resize(m_orbitals->RnlID.size(),-1);
+    if(CutoffTolerance>0)
+      m_orbitals->RnlCutoff.back()=radial_cutoff(*gset,L,CutoffTolerance);
   }
 
 
@@ -423,6 +476,9 @@ private:
     m_rcut_safe=std::max(m_rcut_safe,r0);
     radTemp.push_back(new A2NTransformer<RealType,gto_type>(gset));
     m_orbitals->RnlID.push_back(m_nlms);
+    m_orbitals->RnlCutoff.resize(m_orbitals->RnlID.size(),-1);
+    if(CutoffTolerance>0)
+      m_orbitals->RnlCutoff.back()=radial_cutoff(*gset,L,CutoffTolerance);
   }
 
 
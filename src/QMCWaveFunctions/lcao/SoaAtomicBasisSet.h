@@ -34,6 +34,8 @@ namespace qmcplusplus
       int BasisSetSize;
       ///Number of Cell images for the evaluation of the orbital with PBC. If No PBC, should be 0;
       TinyVector<int,3>  PBCImages; 
+      ///translations of the cell images which can be within RcutMax of a minimum-image displacement
+      std::vector<TinyVector<value_type,3> > ImageShifts;
       ///maximum radius of this center
       value_type Rmax;
       ///spherical harmonics
@@ -46,6 +48,12 @@ namespace qmcplusplus
       aligned_vector<int> NL;
       ///container for the quantum-numbers
       std::vector<QuantumNumberType> RnlID;
+      ///cutoff radius of each radial orbital, Rmax if not positive
+      aligned_vector<value_type> RnlCutoff;
+      ///largest RnlCutoff
+      value_type RcutMax;
+      ///the basis functions [ShellStart[s],ShellStart[s+1]) share the radial orbital NL[ShellStart[s]]
+      aligned_vector<int> ShellStart;
       ///temporary storage 
       VectorSoaContainer<value_type,4> tempS;
 
@@ -53,7 +61,7 @@ namespace qmcplusplus
       std::vector<grid_type*> Grids;
       ///the constructor
       explicit SoaAtomicBasisSet(int lmax, bool addsignforM=false)
-        :Ylm(lmax,addsignforM){}
+        :Ylm(lmax,addsignforM), ImageShifts(1,TinyVector<value_type,3>(0)){}
 
       SoaAtomicBasisSet(const SoaAtomicBasisSet& in)=default;
 
@@ -92,8 +100,50 @@ namespace qmcplusplus
         return BasisSetSize;
       }
 
-      // Set the number of periodic image for the evaluation of the orbitals. 
-      void setPBCImages(const TinyVector<int,3>& pbc_images) { PBCImages = pbc_images; }
+      /** Set the number of periodic image for the evaluation of the orbitals.
+       *
+       * Only the images which can be within RcutMax of the center are kept in ImageShifts.
+       * The displacements from the distance table are minimum images, no longer than
+       * the vectors with reduced coordinates in [-1/2,1/2]. Their length is bounded by
+       * the longest half diagonal of the cell. Must be called after setBasisSetSize.
+       */
+      template<typename LAT>
+      void setPBCImages(const TinyVector<int,3>& pbc_images, const LAT& lattice)
+      {
+        PBCImages = pbc_images;
+        value_type rbound=0;
+        for(int corner=0; corner<8; corner++)
+        {
+          TinyVector<value_type,3> half_diag(0);
+          for(int i=0; i<3; i++)
+          {
+            const value_type s=(corner&(1<<i))? 0.5: -0.5;
+            for(int d=0; d<3; d++)
+              half_diag[d]+=s*lattice.R(i,d);
+          }
+          rbound=std::max(rbound,std::sqrt(dot(half_diag,half_diag)));
+        }
+
+        ImageShifts.clear();
+        for (int i=0; i<=PBCImages[0]; i++ ) //loop Translation over X 
+        {
+          //Allows to increment cells from 0,1,-1,2,-2,3,-3 etc...
+          const int TransX=(( i%2 ) * 2 -1) * ( (i+1)/2 ) ;
+          for (int j=0; j<=PBCImages[1]; j++ ) //loop Translation over Y
+          {
+            const int TransY=(( j%2 ) * 2 -1) * ( (j+1)/2 ); 
+            for (int k=0; k<=PBCImages[2]; k++ ) //loop Translation over Z
+            {
+              const int TransZ=(( k%2 ) * 2 -1) * ( (k+1)/2 ); 
+              TinyVector<value_type,3> shift;
+              for(int d=0; d<3; d++)
+                shift[d]=TransX*lattice.R(0,d)+TransY*lattice.R(1,d)+TransZ*lattice.R(2,d);
+              if((i==0 && j==0 && k==0) || std::sqrt(dot(shift,shift))<RcutMax+rbound)
+                ImageShifts.push_back(shift);
+            }
+          }
+        }
+      }
 
       /** implement a BasisSetBase virtual function
        *
@@ -104,6 +154,19 @@ namespace qmcplusplus
       {
         BasisSetSize=LM.size();
         tempS.resize(std::max(Ylm.size(),RnlID.size()));
+
+        RnlCutoff.resize(RnlID.size(),value_type(-1));
+        RcutMax=0;
+        for(size_t nl=0; nl<RnlCutoff.size(); nl++)
+        {
+          if(RnlCutoff[nl]<=0 || RnlCutoff[nl]>Rmax) RnlCutoff[nl]=Rmax;
+          RcutMax=std::max(RcutMax,RnlCutoff[nl]);
+        }
+
+        ShellStart.clear();
+        for(int ib=0; ib<BasisSetSize; ib++)
+          if(ib==0 || NL[ib]!=NL[ib-1]) ShellStart.push_back(ib);
+        ShellStart.push_back(BasisSetSize);
       }
 
       /** Set Rmax */
@@ -123,6 +186,26 @@ namespace qmcplusplus
       inline void setCenter(int c, int offset)
       { }
 
+      /** append the blocks of basis functions which are not negligible at distance r
+       * @param r distance to the center, the minimum image with PBC
+       * @param offset index of the first basis function of this center
+       * @param ranges [first,last) ranges, a block contiguous to the last range extends it
+       */
+      template<typename T, typename RV>
+      inline void addSignificantRanges(T r, int offset, RV& ranges) const
+      {
+        for(size_t s=0; s+1<ShellStart.size(); s++)
+        {
+          if(r>=RnlCutoff[NL[ShellStart[s]]]) continue;
+          const int first=offset+ShellStart[s];
+          const int last=offset+ShellStart[s+1];
+          if(ranges.size() && ranges.back().second==first)
+            ranges.back().second=last;
+          else
+            ranges.push_back(std::make_pair(first,last));
+        }
+      }
+
       /// Sets a boolean vector for S-type orbitals.  Used for cusp correction.
       void queryOrbitalsForSType(std::vector<bool> &s_orbitals) const {
         for (int i = 0; i < BasisSetSize; i++) {
@@ -137,8 +220,6 @@ namespace qmcplusplus
         evaluateVGL(const LAT& lattice, const T r, const PosType& dr, const size_t offset,  VGL& vgl)
         {
 
-          int TransX,TransY,TransZ;
-
           PosType dr_new;
           T r_new;
          // T psi_new, dpsi_x_new, dpsi_y_new, dpsi_z_new,d2psi_new;  
@@ -167,71 +248,50 @@ namespace qmcplusplus
                d2psi[ib] =0; 
           }
 
-          for (int i=0; i<=PBCImages[0]; i++ ) //loop Translation over X 
+          for (size_t im=0; im<ImageShifts.size(); im++) //loop over the contributing images
           {
-              //Allows to increment cells from 0,1,-1,2,-2,3,-3 etc...
-              TransX=(( i%2 ) * 2 -1) * ( (i+1)/2 ) ;
-              for (int j=0; j<=PBCImages[1]; j++ ) //loop Translation over Y
-              {
-                 //Allows to increment cells from 0,1,-1,2,-2,3,-3 etc...
-                 TransY=(( j%2 ) * 2 -1) * ( (j+1)/2 ); 
-                 for (int k=0; k<=PBCImages[2]; k++ ) //loop Translation over Z
-                 {
-                    //Allows to increment cells from 0,1,-1,2,-2,3,-3 etc...
-                    TransZ=(( k%2 ) * 2 -1) * ( (k+1)/2 ); 
-                    dr_new[0]=dr[0]+TransX*lattice.R(0,0)+TransY*lattice.R(1,0)+TransZ*lattice.R(2,0);
-                    dr_new[1]=dr[1]+TransX*lattice.R(0,1)+TransY*lattice.R(1,1)+TransZ*lattice.R(2,1);
-                    dr_new[2]=dr[2]+TransX*lattice.R(0,2)+TransY*lattice.R(1,2)+TransZ*lattice.R(2,2);
-                    r_new=std::sqrt(dot(dr_new,dr_new));
-         
-
-
-                    //const size_t ib_max=NL.size();
-                    if(r_new>Rmax) continue; 
-  
-                    //SIGN Change!!
-                    const T x=-dr_new[0], y=-dr_new[1], z=-dr_new[2];
-                    Ylm.evaluateVGL(x,y,z);
-  
-  
-  
-                    MultiRnl->evaluate(r_new,phi,dphi,d2phi);
-  
-  
-                    const T rinv=cone/r_new;
-  
-                    for(size_t ib=0; ib<BasisSetSize; ++ib)
-                    {
-                         const int nl(NL[ib]);
-                         const int lm(LM[ib]);
-                         const T drnloverr=rinv*dphi[nl];
-                         const T ang=ylm_v[lm];
-                         const T gr_x=drnloverr*x;
-                         const T gr_y=drnloverr*y;
-                         const T gr_z=drnloverr*z;
-                         const T ang_x=ylm_x[lm];
-                         const T ang_y=ylm_y[lm];
-                         const T ang_z=ylm_z[lm];
-                         const T vr=phi[nl];
-                                  
-                         psi[ib]    += ang*vr;
-                         dpsi_x[ib] += ang*gr_x+vr*ang_x;
-                         dpsi_y[ib] += ang*gr_y+vr*ang_y;
-                         dpsi_z[ib] += ang*gr_z+vr*ang_z;
-                         d2psi[ib]  += ang*(ctwo*drnloverr+d2phi[nl]) + ctwo*(gr_x*ang_x+gr_y*ang_y+gr_z*ang_z)+vr*ylm_l[lm];
-                    }
-                 }
-              }
-          } 
+            const TinyVector<value_type,3>& shift=ImageShifts[im];
+            dr_new[0]=dr[0]+shift[0];
+            dr_new[1]=dr[1]+shift[1];
+            dr_new[2]=dr[2]+shift[2];
+            r_new=std::sqrt(dot(dr_new,dr_new));
+
+            if(r_new>RcutMax) continue;
+
+            //SIGN Change!!
+            const T x=-dr_new[0], y=-dr_new[1], z=-dr_new[2];
+            Ylm.evaluateVGL(x,y,z);
+            MultiRnl->evaluate(r_new,phi,dphi,d2phi);
+
+            const T rinv=cone/r_new;
+
+            for(size_t ib=0; ib<BasisSetSize; ++ib)
+            {
+                 const int nl(NL[ib]);
+                 const int lm(LM[ib]);
+                 const T drnloverr=rinv*dphi[nl];
+                 const T ang=ylm_v[lm];
+                 const T gr_x=drnloverr*x;
+                 const T gr_y=drnloverr*y;
+                 const T gr_z=drnloverr*z;
+                 const T ang_x=ylm_x[lm];
+                 const T ang_y=ylm_y[lm];
+                 const T ang_z=ylm_z[lm];
+                 const T vr=phi[nl];
+
+                 psi[ib]    += ang*vr;
+                 dpsi_x[ib] += ang*gr_x+vr*ang_x;
+                 dpsi_y[ib] += ang*gr_y+vr*ang_y;
+                 dpsi_z[ib] += ang*gr_z+vr*ang_z;
+                 d2psi[ib]  += ang*(ctwo*drnloverr+d2phi[nl]) + ctwo*(gr_x*ang_x+gr_y*ang_y+gr_z*ang_z)+vr*ylm_l[lm];
+            }
+          }
         }
 
       template<typename LAT, typename T, typename PosType>
       inline void
         evaluateV(const LAT& lattice, const T r, const PosType& dr, T* restrict psi) 
         {
-         
-          int TransX,TransY,TransZ;
-
           PosType dr_new;
           T r_new;
           T psi_new;
@@ -239,35 +299,23 @@ namespace qmcplusplus
           value_type* restrict phi_r=tempS.data(1);
           for(size_t ib=0; ib<BasisSetSize; ++ib)
               psi[ib]=0;
-          for (int i=0; i<=PBCImages[0]; i++ ) //loop Translation over X 
+          for (size_t im=0; im<ImageShifts.size(); im++) //loop over the contributing images
           {
-              //Allows to increment cells from 0,1,-1,2,-2,3,-3 etc...
-              TransX=(( i%2 ) * 2 -1) * ( (i+1)/2 ) ;
-              for (int j=0; j<=PBCImages[1]; j++ ) //loop Translation over Y
-              {
-                 //Allows to increment cells from 0,1,-1,2,-2,3,-3 etc...
-                 TransY=(( j%2 ) * 2 -1) * ( (j+1)/2 ); 
-                 for (int k=0; k<=PBCImages[2]; k++ ) //loop Translation over Z
-                 {
-                    //Allows to increment cells from 0,1,-1,2,-2,3,-3 etc...
-                    TransZ=(( k%2 ) * 2 -1) * ( (k+1)/2 ); 
-                    dr_new[0]=dr[0]+TransX*lattice.R(0,0)+TransY*lattice.R(1,0)+TransZ*lattice.R(2,0);
-                    dr_new[1]=dr[1]+TransX*lattice.R(0,1)+TransY*lattice.R(1,1)+TransZ*lattice.R(2,1);
-                    dr_new[2]=dr[2]+TransX*lattice.R(0,2)+TransY*lattice.R(1,2)+TransZ*lattice.R(2,2);
-
-                    r_new=std::sqrt(dot(dr_new,dr_new));
-              
-                    if(r_new>Rmax)   continue;
-
-                    Ylm.evaluateV(-dr_new[0],-dr_new[1],-dr_new[2],ylm_v);
-                    MultiRnl->evaluate(r_new,phi_r);
-           
-                    for(size_t ib=0; ib<BasisSetSize; ++ib)
-                       psi[ib] += ylm_v[ LM[ib] ]*phi_r[ NL[ib] ];
-                 }
-              }
-           }
-          
+            const TinyVector<value_type,3>& shift=ImageShifts[im];
+            dr_new[0]=dr[0]+shift[0];
+            dr_new[1]=dr[1]+shift[1];
+            dr_new[2]=dr[2]+shift[2];
+            r_new=std::sqrt(dot(dr_new,dr_new));
+
+            if(r_new>RcutMax) continue;
+
+            Ylm.evaluateV(-dr_new[0],-dr_new[1],-dr_new[2],ylm_v);
+            MultiRnl->evaluate(r_new,phi_r);
+
+            for(size_t ib=0; ib<BasisSetSize; ++ib)
+               psi[ib] += ylm_v[ LM[ib] ]*phi_r[ NL[ib] ];
+          }
+
         }
     };
 
@@ -40,6 +40,8 @@ struct SoaLocalizedBasisSet: public RealBasisSetBase<typename COT::value_type>
   typedef typename RealBasisSetBase<value_type>::vgl_type vgl_type;
 
   using RealBasisSetBase<value_type>::BasisSetSize;
+  using RealBasisSetBase<value_type>::Screening;
+  using RealBasisSetBase<value_type>::SignificantRanges;
 
   ///number of centers, e.g., ions
   size_t NumCenters;
@@ -90,13 +92,28 @@ struct SoaLocalizedBasisSet: public RealBasisSetBase<typename COT::value_type>
   }
   /** set Number of periodic Images to evaluate the orbitals. 
       Set to 0 for non-PBC, and set manually in the input.
+      Each center type keeps the images within its cutoff, after setBasisSetSize.
   */
-  void setPBCImages(const TinyVector<int,3>& PBCImages)
+  template<typename LAT>
+  void setPBCImages(const TinyVector<int,3>& PBCImages, const LAT& lattice)
   {
     for(int i=0; i<LOBasisSet.size(); ++i)
-      LOBasisSet[i]->setPBCImages(PBCImages);
-
+    {
+      LOBasisSet[i]->setPBCImages(PBCImages,lattice);
+      if(PBCImages[0]+PBCImages[1]+PBCImages[2]>0)
+        app_log() << "  Center type " << i << " evaluates " << LOBasisSet[i]->ImageShifts.size() << " of "
+                  << (PBCImages[0]+1)*(PBCImages[1]+1)*(PBCImages[2]+1) << " periodic images" << std::endl;
+    }
+  }
+  /** skip the basis functions beyond the cutoff radius of their radial orbital
+   *
+   * The centers beyond all their cutoffs are not evaluated and their basis functions are zero.
+   */
+  void setScreening(bool screen)
+  {
+    Screening=screen;
   }
+
   /** set BasisSetSize and allocate mVGL container
    */
   void setBasisSetSize(int nbs)
@@ -160,6 +177,23 @@ struct SoaLocalizedBasisSet: public RealBasisSetBase<typename COT::value_type>
     const DistanceTableData* d_table=P.DistTables[myTableIndex];
     const value_type* restrict  dist = (P.activePtcl==iat)? d_table->Temp_r.data(): d_table->Distances[iat];
     const auto& displ= (P.activePtcl==iat)? d_table->Temp_dr: d_table->Displacements[iat];
+    if(Screening)
+    {
+      SignificantRanges.clear();
+      for(int c=0; c<NumCenters; c++)
+      {
+        const COT& aos=*LOBasisSet[IonID[c]];
+        if(dist[c]<aos.RcutMax)
+        {
+          aos.addSignificantRanges(dist[c],BasisOffset[c],SignificantRanges);
+          LOBasisSet[IonID[c]]->evaluateVGL(P.Lattice,dist[c],displ[c],BasisOffset[c],vgl);
+        }
+        else
+          for(int i=0; i<OHMMS_DIM+2; i++)
+            std::fill_n(vgl.data(i)+BasisOffset[c],aos.BasisSetSize,value_type());
+      }
+      return;
+    }
     for(int c=0; c<NumCenters; c++)
     {
       LOBasisSet[IonID[c]]->evaluateVGL(P.Lattice,dist[c],displ[c],BasisOffset[c],vgl);
@@ -175,6 +209,22 @@ struct SoaLocalizedBasisSet: public RealBasisSetBase<typename COT::value_type>
     const DistanceTableData* d_table=P.DistTables[myTableIndex];
     const value_type* restrict  dist = (P.activePtcl==iat)? d_table->Temp_r.data(): d_table->Distances[iat];
     const auto& displ= (P.activePtcl==iat)? d_table->Temp_dr: d_table->Displacements[iat];
+    if(Screening)
+    {
+      SignificantRanges.clear();
+      for(int c=0; c<NumCenters; c++)
+      {
+        const COT& aos=*LOBasisSet[IonID[c]];
+        if(dist[c]<aos.RcutMax)
+        {
+          aos.addSignificantRanges(dist[c],BasisOffset[c],SignificantRanges);
+          LOBasisSet[IonID[c]]->evaluateV(P.Lattice,dist[c],displ[c],vals+BasisOffset[c]);
+        }
+        else
+          std::fill_n(vals+BasisOffset[c],aos.BasisSetSize,value_type());
+      }
+      return;
+    }
     for(int c=0; c<NumCenters; c++)
     {
       LOBasisSet[IonID[c]]->evaluateV(P.Lattice,dist[c],displ[c],vals+BasisOffset[c]);
@@ -20,6 +20,12 @@
 #include "Numerics/GaussianBasisSet.h"
 #ifdef ENABLE_SOA
 #include "QMCWaveFunctions/lcao/LCAOrbitalBuilder.h"
+#include "QMCWaveFunctions/lcao/MultiQuinticSpline1D.h"
+#include "QMCWaveFunctions/lcao/SoaCartesianTensor.h"
+#include "QMCWaveFunctions/lcao/SoaAtomicBasisSet.h"
+#include "QMCWaveFunctions/lcao/SoaLocalizedBasisSet.h"
+#include "QMCWaveFunctions/lcao/RadialOrbitalSetBuilder.h"
+#include "QMCWaveFunctions/lcao/MultiFunctorBuilder.h"
 #else
 #include "QMCWaveFunctions/MolecularOrbitals/LocalizedBasisSet.h"
 #include "QMCWaveFunctions/MolecularOrbitals/LCOrbitalSet.h"
@@ -460,5 +466,308 @@ TEST_CASE("ReadMolecularOrbital Numerical HCN","[wavefunction]")
   test_HCN(true);
 }
 
+#ifdef ENABLE_SOA
+TEST_CASE("ReadMolecularOrbital screened HCN","[wavefunction]")
+{
+  OHMMS::Controller->initialize(0, NULL);
+  Communicate *c = OHMMS::Controller;
+
+  Libxml2Document doc;
+  bool okay = doc.parse("hcn.structure.xml");
+  REQUIRE(okay);
+  Tensor<int, 3> tmat;
+  tmat(0,0) = 1;
+  tmat(1,1) = 1;
+  tmat(2,2) = 1;
+
+  ParticleSet ions;
+  XMLParticleParser parse_ions(ions, tmat);
+  OhmmsXPathObject particleset_ion("//particleset[@name='ion0']", doc.getXPathContext());
+  parse_ions.put(particleset_ion[0]);
+  ions.update();
+
+  ParticleSet elec;
+  XMLParticleParser parse_elec(elec, tmat);
+  OhmmsXPathObject particleset_elec("//particleset[@name='e']", doc.getXPathContext());
+  parse_elec.put(particleset_elec[0]);
+  elec.R = 0.0;
+  elec.addTable(ions,DT_SOA);
+  elec.update();
+
+  Libxml2Document doc2;
+  okay = doc2.parse("hcn.wfnoj.xml");
+  REQUIRE(okay);
+
+  TrialWaveFunction psi(c);
+  WaveFunctionComponentBuilder::PtclPoolType particle_set_map;
+  particle_set_map["e"] = &elec;
+  particle_set_map["ion0"] = &ions;
+  SPOSetBuilderFactory bf(elec, psi, particle_set_map);
+
+  OhmmsXPathObject MO_base("//determinantset", doc2.getXPathContext());
+  OhmmsXPathObject slater_base("//determinant", doc2.getXPathContext());
+  SPOSetBuilder *bb = bf.createSPOSetBuilder(MO_base[0]);
+  bb->loadBasisSetFromXML(MO_base[0]);
+  SPOSet *sposet = bb->createSPOSet(slater_base[0]);
+
+  // the same orbitals, skipping the basis functions below 1e-10
+  xmlSetProp(MO_base[0], (const xmlChar *)"name", (const xmlChar *)"LCAOBSet_screened");
+  xmlSetProp(MO_base[0], (const xmlChar *)"screening_tolerance", (const xmlChar *)"1e-10");
+  SPOSetBuilder *bb_screened = bf.createSPOSetBuilder(MO_base[0]);
+  bb_screened->loadBasisSetFromXML(MO_base[0]);
+  SPOSet *sposet_screened = bb_screened->createSPOSet(slater_base[0]);
+  LCAOrbitalSet *lcao_screened = dynamic_cast<LCAOrbitalSet *>(sposet_screened);
+  REQUIRE(lcao_screened != NULL);
+  REQUIRE(lcao_screened->myBasisSet->Screening);
+
+  const int norb = 7;
+  SPOSet::ValueVector_t values(norb), values_screened(norb);
+  SPOSet::GradVector_t dpsi(norb), dpsi_screened(norb);
+  SPOSet::ValueVector_t d2psi(norb), d2psi_screened(norb);
+
+  // far from the H and C cores
+  ParticleSet::SingleParticlePos_t newpos(-6.0, 0.5, 0.0);
+  elec.makeMove(0, newpos);
+
+  sposet->evaluate(elec, 0, values);
+  sposet_screened->evaluate(elec, 0, values_screened);
+  int num_significant = 0;
+  for (const auto& r : lcao_screened->myBasisSet->SignificantRanges)
+    num_significant += r.second - r.first;
+  REQUIRE(num_significant > 0);
+  REQUIRE(num_significant < lcao_screened->getBasisSetSize());
+  for (int j = 0; j < norb; j++)
+    REQUIRE(values_screened[j] == Approx(values[j]).epsilon(1e-6).margin(1e-7));
+
+  sposet->evaluate(elec, 0, values, dpsi, d2psi);
+  sposet_screened->evaluate(elec, 0, values_screened, dpsi_screened, d2psi_screened);
+  for (int j = 0; j < norb; j++)
+  {
+    REQUIRE(values_screened[j] == Approx(values[j]).epsilon(1e-6).margin(1e-7));
+    for (int d = 0; d < 3; d++)
+      REQUIRE(dpsi_screened[j][d] == Approx(dpsi[j][d]).epsilon(1e-6).margin(1e-7));
+    REQUIRE(d2psi_screened[j] == Approx(d2psi[j]).epsilon(1e-6).margin(1e-7));
+  }
+  elec.rejectMove(0);
+
+  // all the electrons at once, spread along the molecule
+  const int nel = elec.getTotalNum();
+  for (int iel = 0; iel < nel; iel++)
+  {
+    elec.R[iel][0] = -6.0 + iel;
+    elec.R[iel][1] = 0.1 * iel;
+    elec.R[iel][2] = -0.05 * iel;
+  }
+  elec.update();
+
+  SPOSet::ValueMatrix_t psiM(nel, norb), psiM_screened(nel, norb);
+  SPOSet::GradMatrix_t dpsiM(nel, norb), dpsiM_screened(nel, norb);
+  SPOSet::ValueMatrix_t d2psiM(nel, norb), d2psiM_screened(nel, norb);
+  sposet->evaluate_notranspose(elec, 0, nel, psiM, dpsiM, d2psiM);
+  sposet_screened->evaluate_notranspose(elec, 0, nel, psiM_screened, dpsiM_screened, d2psiM_screened);
+  for (int iel = 0; iel < nel; iel++)
+  {
+    sposet->evaluate(elec, iel, values, dpsi, d2psi);
+    for (int j = 0; j < norb; j++)
+    {
+      REQUIRE(psiM[iel][j] == Approx(values[j]).margin(1e-10));
+      REQUIRE(d2psiM[iel][j] == Approx(d2psi[j]).margin(1e-10));
+      REQUIRE(psiM_screened[iel][j] == Approx(values[j]).epsilon(1e-6).margin(1e-7));
+      REQUIRE(d2psiM_screened[iel][j] == Approx(d2psi[j]).epsilon(1e-6).margin(1e-7));
+      for (int d = 0; d < 3; d++)
+      {
+        REQUIRE(dpsiM[iel][j][d] == Approx(dpsi[j][d]).margin(1e-10));
+        REQUIRE(dpsiM_screened[iel][j][d] == Approx(dpsi[j][d]).epsilon(1e-6).margin(1e-7));
+      }
+    }
+  }
+
+  SPOSetBuilderFactory::clear();
+}
+
+TEST_CASE("ReadMolecularOrbital GTO Ne radial functions","[wavefunction]")
+{
+  typedef MultiFunctorAdapter<GaussianCombo<QMCTraits::RealType> > radial_type;
+  typedef SoaAtomicBasisSet<radial_type, SoaCartesianTensor<QMCTraits::RealType> > ao_type;
+  typedef SoaLocalizedBasisSet<ao_type> basis_type;
+
+  OHMMS::Controller->initialize(0, NULL);
+  Communicate *c = OHMMS::Controller;
+
+  ParticleSet elec;
+  std::vector<int> agroup(2);
+  agroup[0] = 1;
+  agroup[1] = 1;
+  elec.setName("e");
+  elec.create(agroup);
+  elec.R = 0.0;
+
+  ParticleSet ions;
+  ions.setName("ion0");
+  ions.create(1);
+  ions.R[0] = 0.0;
+  SpeciesSet &ispecies = ions.getSpeciesSet();
+  ispecies.addSpecies("Ne");
+  ions.update();
+
+  elec.addTable(ions,DT_SOA);
+  elec.update();
+
+  Libxml2Document doc;
+  bool okay = doc.parse("ne_def2_svp.wfnoj.xml");
+  REQUIRE(okay);
+
+  TrialWaveFunction psi(c);
+  WaveFunctionComponentBuilder::PtclPoolType particle_set_map;
+  particle_set_map["e"] = &elec;
+  particle_set_map["ion0"] = &ions;
+  SPOSetBuilderFactory bf(elec, psi, particle_set_map);
+
+  // direct evaluation of the GTO's by MultiFunctorAdapter<GaussianCombo>
+  OhmmsXPathObject MO_base("//determinantset", doc.getXPathContext());
+  REQUIRE(MO_base.size() == 1);
+  xmlSetProp(MO_base[0], (const xmlChar *)"name", (const xmlChar *)"LCAOBSet_radial");
+  xmlSetProp(MO_base[0], (const xmlChar *)"transform", (const xmlChar *)"no");
+  xmlSetProp(MO_base[0], (const xmlChar *)"key", (const xmlChar *)"GTO");
+  SPOSetBuilder *bb = bf.createSPOSetBuilder(MO_base[0]);
+  REQUIRE(bb != NULL);
+  bb->loadBasisSetFromXML(MO_base[0]);
+  OhmmsXPathObject slater_base("//determinant", doc.getXPathContext());
+  SPOSet *sposet = bb->createSPOSet(slater_base[0]);
+  LCAOrbitalSet *lcao = dynamic_cast<LCAOrbitalSet *>(sposet);
+  REQUIRE(lcao != NULL);
+  basis_type *basis = dynamic_cast<basis_type *>(lcao->myBasisSet);
+  REQUIRE(basis != NULL);
+  REQUIRE(basis->LOBasisSet[0] != NULL);
+
+  radial_type *rnl = basis->LOBasisSet[0]->MultiRnl;
+  REQUIRE(rnl != NULL);
+  // Ne00, Ne10, Ne20, Ne31, Ne41 and Ne52
+  const int nrnl = rnl->Rnl.size();
+  REQUIRE(nrnl == 6);
+  REQUIRE(rnl->First.size() == nrnl + 1);
+  REQUIRE(rnl->Alpha.size() == 12);
+
+  // the clone packs the primitives of its own copies of Rnl
+  radial_type *rnl_clone = rnl->makeClone();
+  rnl_clone->finalize();
+  REQUIRE(rnl_clone->Alpha.size() == rnl->Alpha.size());
+
+  std::vector<QMCTraits::RealType> u(nrnl), du(nrnl), d2u(nrnl), u_only(nrnl);
+  const QMCTraits::RealType rs[] = {0.01, 0.1, 0.5, 1.0, 2.0, 5.0};
+  for (radial_type *radial : {rnl, rnl_clone})
+  {
+    for (QMCTraits::RealType r : rs)
+    {
+      radial->evaluate(r, u_only.data());
+      radial->evaluate(r, u.data(), du.data(), d2u.data());
+      for (int i = 0; i < nrnl; i++)
+      {
+        GaussianCombo<QMCTraits::RealType> &g = *rnl->Rnl[i];
+        g.evaluateAll(r, 1.0 / r);
+        REQUIRE(u_only[i] == Approx(g.Y));
+        REQUIRE(u[i] == Approx(g.Y));
+        REQUIRE(du[i] == Approx(g.dY));
+        REQUIRE(d2u[i] == Approx(g.d2Y));
+      }
+    }
+  }
+  delete rnl_clone;
+
+  SPOSetBuilderFactory::clear();
+}
+
+TEST_CASE("ReadMolecularOrbital periodic diamond","[wavefunction]")
+{
+  OHMMS::Controller->initialize(0, NULL);
+  Communicate *c = OHMMS::Controller;
+
+  ParticleSet ions;
+  ParticleSet elec;
+  // diamondC_1x1x1
+  const double a = 3.37316115;
+  for (ParticleSet* p : {&ions, &elec})
+  {
+    p->Lattice.BoxBConds = true;
+    p->Lattice.R(0,0) = a;   p->Lattice.R(0,1) = a;   p->Lattice.R(0,2) = 0.0;
+    p->Lattice.R(1,0) = 0.0; p->Lattice.R(1,1) = a;   p->Lattice.R(1,2) = a;
+    p->Lattice.R(2,0) = a;   p->Lattice.R(2,1) = 0.0; p->Lattice.R(2,2) = a;
+    p->Lattice.reset();
+  }
+
+  ions.setName("ion0");
+  ions.create(2);
+  ions.R[0] = 0.0;
+  ions.R[1] = 0.5 * a;
+  SpeciesSet &ispecies = ions.getSpeciesSet();
+  int cIdx = ispecies.addSpecies("C");
+  ispecies(ispecies.addAttribute("charge"), cIdx) = 4;
+  ions.update();
+
+  elec.setName("e");
+  elec.create(2);
+  elec.R[0] = ParticleSet::SingleParticlePos_t(0.3, 0.1, -0.2);
+  elec.R[1] = ParticleSet::SingleParticlePos_t(2.9, 3.1, 0.4);
+  SpeciesSet &tspecies = elec.getSpeciesSet();
+  int upIdx = tspecies.addSpecies("u");
+  tspecies(tspecies.addAttribute("charge"), upIdx) = -1;
+  elec.addTable(ions,DT_SOA);
+  elec.update();
+
+  const char *wf_xml =
+"<tmp> \
+<determinantset type=\"MolecularOrbital\" name=\"LCAOBSet\" source=\"ion0\" transform=\"yes\" href=\"C_Diamond.h5\" PBCimages=\"5 5 5\" screening_tolerance=\"1e-12\"> \
+  <determinant id=\"updet\" size=\"4\"> \
+    <occupation mode=\"ground\"/> \
+    <coefficient size=\"58\" spindataset=\"0\"/> \
+  </determinant> \
+</determinantset> \
+</tmp>";
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(wf_xml);
+  REQUIRE(okay);
+  xmlNodePtr MO_base = xmlFirstElementChild(doc.getRoot());
+  xmlNodePtr slater_base = xmlFirstElementChild(MO_base);
+
+  TrialWaveFunction psi(c);
+  WaveFunctionComponentBuilder::PtclPoolType particle_set_map;
+  particle_set_map["e"] = &elec;
+  particle_set_map["ion0"] = &ions;
+  SPOSetBuilderFactory bf(elec, psi, particle_set_map);
+  SPOSetBuilder *bb = bf.createSPOSetBuilder(MO_base);
+  bb->loadBasisSetFromXML(MO_base);
+  SPOSet *sposet = bb->createSPOSet(slater_base);
+  REQUIRE(sposet != NULL);
+
+  // only the images within the cutoff are evaluated, the reference sums over all 6x6x6 images
+  const int norb = 4;
+  SPOSet::ValueVector_t values(norb);
+  SPOSet::GradVector_t dpsi(norb);
+  SPOSet::ValueVector_t d2psi(norb);
+  const double ref_values[2][4][5] = {
+    {{1.0975986372e-01, 8.3529056682e-02, 2.6151376338e-02, -5.5271125071e-02, 6.2332300374e-01},
+     {-1.0450043926e-01, -3.8197564544e-01, -5.1160936327e-01, -6.9765235565e-01, 1.9290004978e+00},
+     {2.8950990557e-01, -1.1986140137e-01, 2.3769784812e-01, -4.6069900276e-01, -5.2952939534e+00},
+     {-1.6219822801e-01, -4.9716170882e-01, 7.5198290184e-01, -6.7228976414e-02, 2.8578423339e+00}},
+    {{1.3978064527e-01, -4.6564292536e-02, -3.1758335514e-02, 4.0993976404e-02, -1.0761098561e-01},
+     {1.2430691558e-01, -1.7122251149e-01, -2.2125148151e-01, -3.5657101694e-01, -8.4170549027e-01},
+     {-3.7322223107e-01, -1.8817998509e-01, 8.2089502671e-02, -1.1159844435e-01, 2.5371937876e+00},
+     {9.3941423684e-02, -2.1778562060e-01, 3.8291718929e-01, -9.4568565579e-02, -6.6110927900e-01}}};
+  for (int iel = 0; iel < 2; iel++)
+  {
+    sposet->evaluate(elec, iel, values, dpsi, d2psi);
+    for (int j = 0; j < norb; j++)
+    {
+      REQUIRE(values[j] == Approx(ref_values[iel][j][0]).epsilon(1e-8).margin(1e-10));
+      for (int d = 0; d < 3; d++)
+        REQUIRE(dpsi[j][d] == Approx(ref_values[iel][j][d + 1]).epsilon(1e-8).margin(1e-10));
+      REQUIRE(d2psi[j] == Approx(ref_values[iel][j][4]).epsilon(1e-8).margin(1e-10));
+    }
+  }
+
+  SPOSetBuilderFactory::clear();
+}
+#endif
+
 }
 
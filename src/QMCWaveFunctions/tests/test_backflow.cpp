@@ -0,0 +1,231 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2018 Jeongnim Kim and QMCPACK developers.
+//
+// File developed by: Mark Dewing, mdewing@anl.gov, Argonne National Laboratory
+//
+// File created by: Mark Dewing, mdewing@anl.gov, Argonne National Laboratory
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include "Configuration.h"
+#include "Particle/ParticleSet.h"
+#include "Particle/DistanceTableData.h"
+#include "Particle/DistanceTable.h"
+#include "Numerics/DeterminantOperators.h"
+#include "QMCWaveFunctions/SPOSet.h"
+#include "QMCWaveFunctions/Fermion/BackflowTransformation.h"
+#include "QMCWaveFunctions/Fermion/DiracDeterminantWithBackflow.h"
+
+#include <cmath>
+#include <vector>
+
+namespace qmcplusplus
+{
+
+/// the determinant is filled by hand, the orbitals are never evaluated
+class NullSPO : public SPOSet
+{
+public:
+  virtual void resetParameters(const opt_variables_type& optVariables) {}
+  virtual void resetTargetParticleSet(ParticleSet& P) {}
+  virtual void setOrbitalSetSize(int norbs) { OrbitalSetSize = norbs; }
+  virtual void evaluate(const ParticleSet& P, int iat, ValueVector_t& psi) {}
+  virtual void evaluate(const ParticleSet& P, int iat,
+                        ValueVector_t& psi, GradVector_t& dpsi, ValueVector_t& d2psi) {}
+  virtual void evaluate(const ParticleSet& P, int iat,
+                        ValueVector_t& psi, GradVector_t& dpsi, HessVector_t& grad_grad_psi) {}
+  virtual void evaluate_notranspose(const ParticleSet& P, int first, int last,
+                                    ValueMatrix_t& logdet, GradMatrix_t& dlogdet, ValueMatrix_t& d2logdet) {}
+};
+
+void setup_backflow_particles(ParticleSet& ions, ParticleSet& elec)
+{
+  ions.setName("ion0");
+  ions.create(1);
+  ions.R[0] = 0.0;
+  SpeciesSet &ispecies = ions.getSpeciesSet();
+  ispecies.addSpecies("H");
+  ions.update();
+
+  elec.setName("e");
+  std::vector<int> agroup(2, 3);
+  elec.create(agroup);
+  for (int i = 0; i < elec.getTotalNum(); i++)
+  {
+    elec.R[i][0] = 0.3 * i;
+    elec.R[i][1] = -0.2 + 0.1 * i * i;
+    elec.R[i][2] = std::sin(0.7 * i);
+  }
+  SpeciesSet &tspecies = elec.getSpeciesSet();
+  int upIdx = tspecies.addSpecies("u");
+  int downIdx = tspecies.addSpecies("d");
+  int chargeIdx = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx) = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+  // the backflow transformation works with AoS tables
+  elec.addTable(elec, DT_AOS);
+  elec.addTable(ions, DT_AOS);
+  elec.update();
+}
+
+void check_low_rank_inverse(const std::vector<int>& moved)
+{
+  typedef DiracDeterminantWithBackflow::ValueMatrix_t ValueMatrix_t;
+  typedef QMCTraits::RealType RealType;
+  typedef QMCTraits::ValueType ValueType;
+
+  ParticleSet ions;
+  ParticleSet elec;
+  setup_backflow_particles(ions, elec);
+  const int n = elec.getTotalNum();
+
+  BackflowTransformation bf(elec);
+  NullSPO spo;
+  spo.setOrbitalSetSize(n);
+  DiracDeterminantWithBackflow ddb(elec, &spo, &bf, 0);
+  ddb.resize(n, n);
+
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++)
+      ddb.psiM(i, j) = ValueType(1.0 / (1.0 + std::abs(i - j)) + 0.1 * std::sin(i + 2.0 * j) + (i == j ? 1.0 : 0.0));
+  ddb.psiMinv = ddb.psiM;
+  ddb.LogValue = InvertWithLog(ddb.psiMinv.data(), n, n, ddb.WorkSpace.data(), ddb.Pivot.data(), ddb.PhaseValue);
+
+  // the columns of the moved quasiparticles change
+  ddb.psiM_temp = ddb.psiM;
+  ddb.movedQP = moved;
+  for (int s = 0; s < moved.size(); s++)
+    for (int i = 0; i < n; i++)
+      ddb.psiM_temp(i, moved[s]) = ValueType(std::cos(0.7 * i + s) + (i == moved[s] ? 1.5 : 0.0));
+
+  RealType new_phase;
+  RealType new_log = ddb.updateInverse(new_phase);
+
+  ValueMatrix_t psiMinv_ref(ddb.psiM_temp);
+  RealType phase_ref;
+  RealType log_ref = InvertWithLog(psiMinv_ref.data(), n, n, ddb.WorkSpace.data(), ddb.Pivot.data(), phase_ref);
+
+  REQUIRE(new_log == Approx(log_ref));
+  REQUIRE(std::exp(new_log - ddb.LogValue) * std::cos(new_phase - ddb.PhaseValue) ==
+          Approx(std::exp(log_ref - ddb.LogValue) * std::cos(phase_ref - ddb.PhaseValue)));
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++)
+      REQUIRE(ddb.psiMinv_temp(i, j) == ValueApprox(psiMinv_ref(i, j)));
+}
+
+TEST_CASE("DiracDeterminantWithBackflow updateInverse", "[wavefunction][fermion]")
+{
+  OHMMS::Controller->initialize(0, NULL);
+
+  SECTION("Woodbury update")
+  {
+    std::vector<int> moved = {1, 4};
+    check_low_rank_inverse(moved);
+  }
+
+  SECTION("full inversion")
+  {
+    std::vector<int> moved = {0, 2, 3, 5};
+    check_low_rank_inverse(moved);
+  }
+}
+
+void copy_tables(ParticleSet& P, std::vector<std::vector<QMCTraits::RealType> >& r,
+                 std::vector<std::vector<QMCTraits::PosType> >& dr)
+{
+  r.resize(P.DistTables.size());
+  dr.resize(P.DistTables.size());
+  for (int t = 0; t < P.DistTables.size(); t++)
+  {
+    const DistanceTableData &dt = *P.DistTables[t];
+    if (dt.DTType == DT_SOA)
+    {
+      r[t].clear();
+      dr[t].clear();
+      for (int i = 0; i < dt.targets(); i++)
+        for (int j = 0; j < dt.centers(); j++)
+        {
+          r[t].push_back(dt.Distances[i][j]);
+          dr[t].push_back(dt.Displacements[i][j]);
+        }
+    }
+    else
+    {
+      r[t] = dt.r_m;
+      dr[t] = dt.dr_m;
+    }
+  }
+}
+
+void check_qp_tables(const std::vector<int>& moved)
+{
+  ParticleSet ions;
+  ParticleSet elec;
+  setup_backflow_particles(ions, elec);
+  const int n = elec.getTotalNum();
+
+  BackflowTransformation bf(elec);
+  bf.UpdateMode = WaveFunctionComponent::ORB_PBYP_RATIO;
+  REQUIRE(bf.QP.DistTables.size() == 2);
+
+  for (int i = 0; i < n; i++)
+    bf.newQP[i] = bf.QP.R[i];
+  bf.indexQP = moved;
+  for (int s = 0; s < moved.size(); s++)
+  {
+    bf.newQP[moved[s]][0] += 0.1 * (s + 1);
+    bf.newQP[moved[s]][2] -= 0.05;
+  }
+  bf.acceptMove(elec, moved[0]);
+  REQUIRE(bf.indexQP.size() == 0);
+
+  for (int i = 0; i < n; i++)
+    for (int d = 0; d < 3; d++)
+      REQUIRE(bf.QP.R[i][d] == Approx(bf.newQP[i][d]));
+
+  // the rows of a SoA A-A table are completed by setActive
+  if (bf.QP.DistTables[0]->DTType == DT_SOA)
+    for (int i = 0; i < n; i++)
+      bf.QP.DistTables[0]->evaluate(bf.QP, i);
+  std::vector<std::vector<QMCTraits::RealType> > r, r_ref;
+  std::vector<std::vector<QMCTraits::PosType> > dr, dr_ref;
+  copy_tables(bf.QP, r, dr);
+
+  bf.QP.update();
+  copy_tables(bf.QP, r_ref, dr_ref);
+  for (int t = 0; t < r.size(); t++)
+  {
+    REQUIRE(r[t].size() > 0);
+    REQUIRE(r[t].size() == r_ref[t].size());
+    for (int ij = 0; ij < r[t].size(); ij++)
+    {
+      REQUIRE(r[t][ij] == Approx(r_ref[t][ij]));
+      for (int d = 0; d < 3; d++)
+        REQUIRE(dr[t][ij][d] == Approx(dr_ref[t][ij][d]));
+    }
+  }
+}
+
+TEST_CASE("BackflowTransformation acceptMove", "[wavefunction][fermion]")
+{
+  OHMMS::Controller->initialize(0, NULL);
+
+  SECTION("one quasiparticle at a time")
+  {
+    std::vector<int> moved = {2, 5};
+    check_qp_tables(moved);
+  }
+
+  SECTION("full update")
+  {
+    std::vector<int> moved = {0, 1, 3, 4};
+    check_qp_tables(moved);
+  }
+}
+
+}
@@ -25,6 +25,7 @@
 #include "QMCWaveFunctions/Jastrow/TwoBodyJastrowOrbital.h"
 #include "QMCWaveFunctions/Jastrow/OneBodyJastrowOrbital.h"
 #include "QMCWaveFunctions/Jastrow/BsplineFunctor.h"
+#include "QMCWaveFunctions/Jastrow/PairFunctorTable.h"
 #include "QMCWaveFunctions/Jastrow/RadialJastrowBuilder.h"
 #include "ParticleBase/ParticleAttribOps.h"
 #ifdef ENABLE_SOA
@@ -259,6 +260,68 @@ const char *particles = \
 
 }
 
+TEST_CASE("BSpline pair functor table", "[wavefunction]")
+{
+  typedef BsplineFunctor<double> FT;
+
+  ParticleSet elec_;
+  std::vector<int> ud(2); ud[0]=3; ud[1]=2;
+  elec_.create(ud);
+
+  // distinct cutoffs and sizes for the uu, ud and dd pairs
+  FT uu, ud_, dd;
+  const double rcut[3]={2.5, 3.0, 2.0};
+  const int nparam[3]={6, 8, 5};
+  FT* f[3]={&uu, &ud_, &dd};
+  for(int k=0; k<3; ++k)
+  {
+    f[k]->cutoff_radius=rcut[k];
+    f[k]->resize(nparam[k]);
+    for(int i=0; i<nparam[k]; ++i)
+      f[k]->Parameters[i]=0.3*std::cos(1.0+k+0.7*i);
+    f[k]->reset();
+  }
+  std::vector<FT*> F(4);
+  F[0]=&uu; F[1]=&ud_; F[2]=&ud_; F[3]=&dd;
+
+  PairFunctorTable<FT> table;
+  REQUIRE(table.fused);
+  table.build(F,elec_);
+
+  const int n=5;
+  aligned_vector<double> dist(n), u(n), du(n), d2u(n);
+  aligned_vector<double> u_ref(n), du_ref(n), d2u_ref(n), scratch(n);
+  aligned_vector<int> indices(n);
+  const double r[n]={0.05, 1.3, 2.7, 0.4, 1.9};
+  for(int j=0; j<n; ++j)
+    dist[j]=r[j];
+
+  for(int iat=0; iat<n; ++iat)
+  {
+    const int ig=elec_.GroupID[iat];
+    std::fill(u_ref.begin(),u_ref.end(),0.0);
+    std::fill(du_ref.begin(),du_ref.end(),0.0);
+    std::fill(d2u_ref.begin(),d2u_ref.end(),0.0);
+    double v_ref=0.0;
+    for(int jg=0; jg<2; ++jg)
+    {
+      const FT& f2=*F[ig*2+jg];
+      v_ref+=f2.evaluateV(iat, elec_.first(jg), elec_.last(jg), dist.data(), scratch.data());
+      f2.evaluateVGL(iat, elec_.first(jg), elec_.last(jg), dist.data(),
+          u_ref.data(), du_ref.data(), d2u_ref.data(), scratch.data(), indices.data());
+    }
+
+    REQUIRE(table.evaluateV(ig, iat, n, dist.data()) == Approx(v_ref));
+    table.evaluateVGL(ig, iat, n, dist.data(), u.data(), du.data(), d2u.data());
+    for(int j=0; j<n; ++j)
+    {
+      REQUIRE(u[j] == Approx(u_ref[j]));
+      REQUIRE(du[j] == Approx(du_ref[j]));
+      REQUIRE(d2u[j] == Approx(d2u_ref[j]));
+    }
+  }
+}
+
 TEST_CASE("BSpline builder Jastrow J1", "[wavefunction]")
 {
 
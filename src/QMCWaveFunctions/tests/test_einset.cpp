@@ -23,6 +23,7 @@
 #include "QMCWaveFunctions/WaveFunctionComponent.h"
 #include "QMCWaveFunctions/TrialWaveFunction.h"
 #include "QMCWaveFunctions/EinsplineSetBuilder.h"
+#include "QMCWaveFunctions/BsplineFactory/BsplineReaderBase.h"
 
 
 #include <stdio.h>
@@ -207,6 +208,133 @@ const char *particles =
 
 }
 
+// the hybrid representation uses SoA distance tables
+#ifdef ENABLE_SOA
+TEST_CASE("Einspline SPO hybrid tuning", "[wavefunction]")
+{
+
+  Communicate *c;
+  OHMMS::Controller->initialize(0, NULL);
+  c = OHMMS::Controller;
+
+  ParticleSet ions_;
+  ParticleSet elec_;
+
+  ions_.setName("ion");
+  ions_.create(2);
+  ions_.R[0][0] = 0.0;
+  ions_.R[0][1] = 0.0;
+  ions_.R[0][2] = 0.0;
+  ions_.R[1][0] = 1.68658058;
+  ions_.R[1][1] = 1.68658058;
+  ions_.R[1][2] = 1.68658058;
+  SpeciesSet &ispecies = ions_.getSpeciesSet();
+  ispecies.addSpecies("C");
+
+  elec_.setName("elec");
+  elec_.create(2);
+  elec_.R[0][0] = 0.0;
+  elec_.R[0][1] = 0.5;
+  elec_.R[0][2] = 0.0;
+  elec_.R[1][0] = 0.0;
+  elec_.R[1][1] = 1.0;
+  elec_.R[1][2] = 0.0;
+
+  // diamondC_1x1x1
+  elec_.Lattice.R(0,0) = 3.37316115;
+  elec_.Lattice.R(0,1) = 3.37316115;
+  elec_.Lattice.R(0,2) = 0.0;
+  elec_.Lattice.R(1,0) = 0.0;
+  elec_.Lattice.R(1,1) = 3.37316115;
+  elec_.Lattice.R(1,2) = 3.37316115;
+  elec_.Lattice.R(2,0) = 3.37316115;
+  elec_.Lattice.R(2,1) = 0.0;
+  elec_.Lattice.R(2,2) = 3.37316115;
+  ions_.Lattice = elec_.Lattice;
+  ions_.addTable(ions_,DT_SOA);
+  ions_.update();
+
+  SpeciesSet &tspecies =  elec_.getSpeciesSet();
+  int upIdx = tspecies.addSpecies("u");
+  int downIdx = tspecies.addSpecies("d");
+  int chargeIdx = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx) = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+
+  elec_.addTable(ions_,DT_SOA);
+  elec_.resetGroups();
+  elec_.update();
+
+  ParticleSetPool ptcl = ParticleSetPool(c);
+  ptcl.addParticleSet(&elec_);
+  ptcl.addParticleSet(&ions_);
+
+  // the plane wave sums at the electron positions
+  const char *particles_pw =
+"<tmp> \
+<determinantset type=\"einspline\" href=\"pwscf.pwscf.h5\" tilematrix=\"1 0 0 0 1 0 0 0 1\" twistnum=\"0\" source=\"ion\" meshfactor=\"2.0\" precision=\"double\" size=\"4\"/> \
+</tmp> \
+";
+  const char *particles_hybrid =
+"<tmp> \
+<determinantset type=\"einspline\" href=\"pwscf.pwscf.h5\" tilematrix=\"1 0 0 0 1 0 0 0 1\" twistnum=\"0\" source=\"ion\" meshfactor=\"1.0\" precision=\"double\" size=\"4\" hybridrep=\"yes\" hybrid_tuning=\"yes\" hybrid_tolerance=\"0.002\"/> \
+</tmp> \
+";
+
+  Libxml2Document doc_pw;
+  REQUIRE(doc_pw.parseFromString(particles_pw));
+  xmlNodePtr ein_pw = xmlFirstElementChild(doc_pw.getRoot());
+  EinsplineSetBuilder einSet_pw(elec_, ptcl.getPool(), c, ein_pw);
+  SPOSet *spo_pw = einSet_pw.createSPOSetFromXML(ein_pw);
+  REQUIRE(spo_pw != NULL);
+
+  Libxml2Document doc;
+  REQUIRE(doc.parseFromString(particles_hybrid));
+  xmlNodePtr ein1 = xmlFirstElementChild(doc.getRoot());
+  EinsplineSetBuilder einSet(elec_, ptcl.getPool(), c, ein1);
+  SPOSet *spo = einSet.createSPOSetFromXML(ein1);
+  REQUIRE(spo != NULL);
+
+  // the tuning keeps an atomic region and never refines the mesh
+  const auto& ACInfo = einSet.AtomicCentersInfo;
+  REQUIRE(ACInfo.cutoff[0] > 0.0);
+  REQUIRE(ACInfo.cutoff[0] <= ACInfo.non_overlapping_radius[0]);
+  REQUIRE(ACInfo.lmax[0] >= 0);
+  for (int d = 0; d < 3; d++)
+    REQUIRE(einSet.MixedSplineReader->MeshSize[d] <= einSet.MeshSize[d]);
+
+#if !defined(QMC_CUDA)
+  SPOSet::ValueVector_t psi_pw(spo->getOrbitalSetSize());
+  SPOSet::ValueVector_t psi(spo->getOrbitalSetSize());
+  for (int iel = 0; iel < elec_.getTotalNum(); iel++)
+  {
+    spo_pw->evaluate(elec_, iel, psi_pw);
+    spo->evaluate(elec_, iel, psi);
+    for (int j = 0; j < psi.size(); j++)
+      REQUIRE(std::abs(psi[j] - psi_pw[j]) < 0.01);
+  }
+
+  // the gradients and laplacians contracted in the atomic regions
+  SPOSet::ValueMatrix_t psiM_pw(elec_.R.size(), spo->getOrbitalSetSize());
+  SPOSet::GradMatrix_t dpsiM_pw(elec_.R.size(), spo->getOrbitalSetSize());
+  SPOSet::ValueMatrix_t d2psiM_pw(elec_.R.size(), spo->getOrbitalSetSize());
+  SPOSet::ValueMatrix_t psiM(elec_.R.size(), spo->getOrbitalSetSize());
+  SPOSet::GradMatrix_t dpsiM(elec_.R.size(), spo->getOrbitalSetSize());
+  SPOSet::ValueMatrix_t d2psiM(elec_.R.size(), spo->getOrbitalSetSize());
+  spo_pw->evaluate_notranspose(elec_, 0, elec_.R.size(), psiM_pw, dpsiM_pw, d2psiM_pw);
+  spo->evaluate_notranspose(elec_, 0, elec_.R.size(), psiM, dpsiM, d2psiM);
+  for (int iel = 0; iel < elec_.getTotalNum(); iel++)
+    for (int j = 0; j < psiM.cols(); j++)
+    {
+      REQUIRE(std::abs(psiM[iel][j] - psiM_pw[iel][j]) < 0.01);
+      for (int d = 0; d < 3; d++)
+        REQUIRE(std::abs(dpsiM[iel][j][d] - dpsiM_pw[iel][j][d]) < 0.05);
+      REQUIRE(std::abs(d2psiM[iel][j] - d2psiM_pw[iel][j]) < 0.5);
+    }
+#endif
+}
+#endif
+
 TEST_CASE("EinsplineSetBuilder CheckLattice", "[wavefunction]")
 {
 
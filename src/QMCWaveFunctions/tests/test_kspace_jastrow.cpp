@@ -0,0 +1,115 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2018 Jeongnim Kim and QMCPACK developers.
+//
+// File developed by: Mark Dewing, mdewing@anl.gov, Argonne National Laboratory
+//
+// File created by: Mark Dewing, mdewing@anl.gov, Argonne National Laboratory
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include "Particle/ParticleSet.h"
+#include "QMCWaveFunctions/Jastrow/kSpaceJastrow.h"
+#include "ParticleBase/ParticleAttribOps.h"
+
+#include <stdio.h>
+#include <string>
+
+namespace qmcplusplus
+{
+
+TEST_CASE("kSpace Jastrow incremental update", "[wavefunction]")
+{
+  OHMMS::Controller->initialize(0, NULL);
+
+  typedef QMCTraits::RealType RealType;
+  typedef QMCTraits::PosType PosType;
+
+  ParticleSet ions_;
+  ParticleSet elec_;
+
+  ions_.setName("ion");
+  ions_.create(1);
+  ions_.R[0]=0.0;
+  ions_.getSpeciesSet().addSpecies("H");
+
+  elec_.setName("elec");
+  std::vector<int> ud(2); ud[0]=ud[1]=2;
+  elec_.create(ud);
+  elec_.R[0]=PosType(0.1, 0.2, 0.3);
+  elec_.R[1]=PosType(2.1, 0.4, 1.3);
+  elec_.R[2]=PosType(1.0, 3.2, 4.1);
+  elec_.R[3]=PosType(3.7, 2.2, 0.6);
+
+  const RealType L=5.0;
+  ions_.Lattice.BoxBConds=true;
+  ions_.Lattice.R=0.0;
+  ions_.Lattice.R(0,0)=ions_.Lattice.R(1,1)=ions_.Lattice.R(2,2)=L;
+  ions_.Lattice.reset();
+  elec_.Lattice=ions_.Lattice;
+
+  kSpaceJastrow jk(ions_, elec_,
+                   kSpaceJastrow::CRYSTAL, 2.0, "cG1", false,
+                   kSpaceJastrow::CRYSTAL, 2.0, "cG2", false);
+
+  // give every coefficient a distinct value
+  opt_variables_type active;
+  jk.checkInVariables(active);
+  active.resetIndex();
+  jk.checkOutVariables(active);
+  for(int i=0; i<active.size(); i++)
+    active[i]=0.1*std::cos(0.3+1.7*i);
+  jk.resetParameters(active);
+
+  const int nel=elec_.getTotalNum();
+  elec_.G=0.0;
+  elec_.L=0.0;
+  RealType logpsi=jk.evaluateLog(elec_, elec_.G, elec_.L);
+
+  const PosType moves[3]={PosType(0.4, 4.6, 2.2), PosType(2.5, 2.5, 2.5), PosType(4.9, 0.2, 3.3)};
+  const int movers[3]={1, 3, 1};
+  for(int imove=0; imove<3; imove++)
+  {
+    const int iel=movers[imove];
+    elec_.makeMove(iel, moves[imove]-elec_.R[iel]);
+    kSpaceJastrow::GradType grad_new;
+    RealType ratio=std::real(jk.ratioGrad(elec_, iel, grad_new));
+    REQUIRE(std::real(jk.ratio(elec_, iel)) == Approx(ratio));
+    jk.acceptMove(elec_, iel);
+    elec_.acceptMove(iel);
+
+    // reference from scratch at the new configuration
+    ParticleSet::ParticleGradient_t G(nel);
+    ParticleSet::ParticleLaplacian_t Lap(nel);
+    G=0.0;
+    Lap=0.0;
+    kSpaceJastrow jk_ref(ions_, elec_,
+                         kSpaceJastrow::CRYSTAL, 2.0, "cG1", false,
+                         kSpaceJastrow::CRYSTAL, 2.0, "cG2", false);
+    opt_variables_type active_ref;
+    jk_ref.checkInVariables(active_ref);
+    active_ref.resetIndex();
+    jk_ref.checkOutVariables(active_ref);
+    for(int i=0; i<active_ref.size(); i++)
+      active_ref[i]=active[i];
+    jk_ref.resetParameters(active_ref);
+    RealType logpsi_new=jk_ref.evaluateLog(elec_, G, Lap);
+
+    REQUIRE(ratio == Approx(std::exp(logpsi_new-logpsi)));
+    for(int idim=0; idim<OHMMS_DIM; idim++)
+      REQUIRE(std::real(grad_new[idim]) == Approx(std::real(G[iel][idim])));
+    // the incrementally updated structure factor gives the same gradients
+    for(int jel=0; jel<nel; jel++)
+    {
+      kSpaceJastrow::GradType grad=jk.evalGrad(elec_, jel);
+      for(int idim=0; idim<OHMMS_DIM; idim++)
+        REQUIRE(std::real(grad[idim]) == Approx(std::real(G[jel][idim])));
+    }
+    logpsi=logpsi_new;
+  }
+}
+}
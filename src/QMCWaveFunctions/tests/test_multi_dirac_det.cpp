@@ -0,0 +1,126 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2018 Jeongnim Kim and QMCPACK developers.
+//
+// File developed by: Mark Dewing, mdewing@anl.gov, Argonne National Laboratory
+//
+// File created by: Mark Dewing, mdewing@anl.gov, Argonne National Laboratory
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include "OhmmsPETE/OhmmsMatrix.h"
+#include "Particle/ParticleSet.h"
+#include "QMCWaveFunctions/Fermion/MultiDiracDeterminant.h"
+#include "QMCWaveFunctions/Fermion/SparseCIMatrix.h"
+#include "Numerics/DeterminantOperators.h"
+
+#include <stdio.h>
+#include <string>
+#include <algorithm>
+
+namespace qmcplusplus
+{
+
+typedef QMCTraits::ValueType ValueType;
+
+TEST_CASE("MultiDiracDeterminant excitation groups", "[wavefunction][fermion]")
+{
+  OHMMS::Controller->initialize(0, NULL);
+
+  const int nel=4;
+  const int norb=9;
+  // reference, singles, doubles, triples and a quadruple, out of order
+  const size_t occ[][nel]={{0,1,2,3},
+                           {0,1,5,6}, {0,1,2,5}, {0,5,6,7}, {5,6,7,8},
+                           {1,2,3,4}, {2,3,4,5}, {0,2,4,6}, {3,4,5,6},
+                           {1,4,7,8}, {0,1,3,8}, {0,2,6,7}};
+  const int ndets=sizeof(occ)/sizeof(occ[0]);
+  std::vector<ci_configuration2> confgList(ndets);
+  for(int i=0; i<ndets; i++)
+    confgList[i].occup.assign(occ[i],occ[i]+nel);
+
+  SPOSetPtr spo=nullptr;
+  MultiDiracDeterminant det(spo,0);
+  det.setDetInfo(0,&confgList);
+  det.set(0,nel,norb);
+
+  const MultiDiracDeterminant::ExcitationGroups& groups=*det.detGroups;
+  REQUIRE(groups.SingleIndex.size() == 3);
+  REQUIRE(groups.DoubleIndex.size() == 4);
+  REQUIRE(groups.TripleIndex.size() == 3);
+  REQUIRE(groups.HigherIndex.size() == 1);
+
+  for(int i=0; i<nel; i++)
+    for(int j=0; j<norb; j++)
+    {
+      det.psiM(i,j)=std::cos(0.7*i+1.3*j+0.1*i*j)+((i==j)?1.0:0.0);
+      det.dpsiM(i,j)=1.0+0.1*i+0.2*j;
+      det.d2psiM(i,j)=std::sin(0.5*i+0.3*j);
+    }
+
+  ParticleSet elec;
+  det.evaluateForWalkerMove(elec,false);
+
+  // every determinant from scratch
+  Matrix<ValueType> a(nel,nel);
+  std::vector<int> pivot(nel);
+  for(int k=0; k<ndets; k++)
+  {
+    std::vector<size_t> sorted(occ[k],occ[k]+nel);
+    std::sort(sorted.begin(),sorted.end());
+    for(int i=0; i<nel; i++)
+      for(int j=0; j<nel; j++)
+        a(i,j)=det.psiM(i,sorted[j]);
+    ValueType ref=Determinant(a.data(),nel,nel,pivot.data());
+    REQUIRE(det.detValues[k] == ValueApprox(ref));
+  }
+}
+
+TEST_CASE("SparseCIMatrix contraction", "[wavefunction][fermion]")
+{
+  typedef QMCTraits::RealType RealType;
+  const int nup=4;
+  const int ndn=3;
+  // terms of the expansion, (2,1) appears twice
+  std::vector<RealType> C={0.9, -0.3, 0.2, 0.1, -0.05, 0.4, 0.02};
+  std::vector<size_t> up={0, 1, 2, 2, 3, 1, 2};
+  std::vector<size_t> dn={0, 0, 1, 2, 2, 2, 1};
+
+  SparseCIMatrix<RealType> cimat;
+  cimat.build(C,up,dn,nup,ndn);
+  REQUIRE(cimat.Version == 1);
+  REQUIRE(cimat.size() == C.size()-1);
+
+  std::vector<ValueType> det_up={1.1, -0.7, 0.3, 2.0};
+  std::vector<ValueType> det_dn={0.5, 1.5, -0.9};
+  std::vector<ValueType> y_up(nup), y_dn(ndn);
+  cimat.contract(0,det_dn.data(),y_up.data());
+  cimat.contract(1,det_up.data(),y_dn.data());
+
+  std::vector<ValueType> ref_up(nup,0.0), ref_dn(ndn,0.0);
+  ValueType psi(0);
+  for(int i=0; i<C.size(); i++)
+  {
+    ref_up[up[i]]+=C[i]*det_dn[dn[i]];
+    ref_dn[dn[i]]+=C[i]*det_up[up[i]];
+    psi+=C[i]*det_up[up[i]]*det_dn[dn[i]];
+  }
+  ValueType psi_up(0), psi_dn(0);
+  for(int i=0; i<nup; i++)
+  {
+    REQUIRE(y_up[i] == ValueApprox(ref_up[i]));
+    psi_up+=y_up[i]*det_up[i];
+  }
+  for(int i=0; i<ndn; i++)
+  {
+    REQUIRE(y_dn[i] == ValueApprox(ref_dn[i]));
+    psi_dn+=y_dn[i]*det_dn[i];
+  }
+  REQUIRE(psi_up == ValueApprox(psi));
+  REQUIRE(psi_dn == ValueApprox(psi));
+}
+}
@@ -209,6 +209,38 @@ const char *particles = \
 
   REQUIRE(ratios2[0] == ComplexApprox(1.0357541137).compare_real_only());
   REQUIRE(ratios2[1] == ComplexApprox(1.0257141422).compare_real_only());
+
+#ifdef ENABLE_SOA
+  // accept moves in and out of the ion spheres, the neighbor lists are updated incrementally
+  PosType moves[4]={PosType(0.0,0.0,6.5), PosType(-0.4,0.3,0.1), PosType(6.0,1.0,0.0), PosType(1.5,-0.5,0.2)};
+  const int movers[4]={3, 0, 1, 3};
+  for(int imove=0; imove<4; imove++)
+  {
+    const int iel=movers[imove];
+    elec_.setActive(iel);
+    elec_.makeMove(iel, moves[imove]-elec_.R[iel]);
+    J3Type::GradType grad_iel;
+    j3->ratioGrad(elec_, iel, grad_iel);
+    j3->acceptMove(elec_, iel);
+    elec_.acceptMove(iel);
+  }
+
+  const int nel=elec_.getTotalNum();
+  ParticleSet::ParticleGradient_t G_inc(nel), G_ref(nel);
+  ParticleSet::ParticleLaplacian_t L_inc(nel), L_ref(nel);
+  G_inc=0.0; L_inc=0.0; G_ref=0.0; L_ref=0.0;
+  j3->evaluateGL(elec_, G_inc, L_inc, false);
+  const double logpsi_inc=j3->LogValue;
+  elec_.update();
+  j3->evaluateGL(elec_, G_ref, L_ref, true);
+  REQUIRE(logpsi_inc == Approx(j3->LogValue));
+  for(int iel=0; iel<nel; iel++)
+  {
+    REQUIRE(L_inc[iel] == Approx(L_ref[iel]));
+    for(int idim=0; idim<OHMMS_DIM; idim++)
+      REQUIRE(G_inc[iel][idim] == Approx(G_ref[iel][idim]));
+  }
+#endif
 }
 }
 
@@ -25,6 +25,9 @@
 #include "QMCWaveFunctions/lcao/CuspCorrection.h"
 
 #include "QMCWaveFunctions/SPOSetBuilderFactory.h"
+#include "io/hdf_archive.h"
+
+#include <cstdio>
 
 namespace qmcplusplus
 {
@@ -308,6 +311,22 @@ TEST_CASE("HCN MO with cusp", "[wavefunction]")
 
   OhmmsXPathObject slater_base("//determinant", doc2.getXPathContext());
   bb->loadBasisSetFromXML(MO_base[0]);
+
+  // this test case has its own cusp cache, id.cusp.h5, and a cuspInfo file with the same id
+  const std::string cache_id("hcn_cache_updet");
+  const std::string cache_file(cache_id + ".cusp.h5");
+  const std::string cache_info(cache_id + ".cuspInfo.xml");
+  std::remove(cache_file.c_str());
+  {
+    Libxml2Document cusp_doc;
+    REQUIRE(cusp_doc.parse("hcn_updet.cuspInfo.xml"));
+    OhmmsXPathObject cusp_sposet("//sposet", cusp_doc.getXPathContext());
+    REQUIRE(cusp_sposet.size() == 1);
+    xmlSetProp(cusp_sposet[0], (const xmlChar*)"name", (const xmlChar*)cache_id.c_str());
+    cusp_doc.dump(cache_info);
+  }
+  xmlSetProp(slater_base[0], (const xmlChar*)"id", (const xmlChar*)cache_id.c_str());
+  xmlSetProp(slater_base[0], (const xmlChar*)"cuspInfo", (const xmlChar*)cache_info.c_str());
   SPOSet* sposet = bb->createSPOSet(slater_base[0]);
 
 
@@ -426,6 +445,80 @@ TEST_CASE("HCN MO with cusp", "[wavefunction]")
   REQUIRE(all_grad[0][1][2] == Approx(0.0000000000));
   REQUIRE(all_lap[0][1] == Approx(19.8720529007));
 
+  // Without the cusp file, the parameters and the tables come from the cache
+  xmlUnsetProp(slater_base[0], (const xmlChar*)"cuspInfo");
+  SPOSet* sposet_cached = bb->createSPOSet(slater_base[0]);
+
+  elec.R       = 0.0;
+  elec.R[0][0] = -1.09;
+  elec.update();
+  elec.makeMove(0, newpos);
+
+  values = 0.0;
+  sposet_cached->evaluate(elec, 0, values, dpsi, d2psi);
+
+  REQUIRE(values[0] == Approx(9.5150713253));
+  REQUIRE(values[1] == Approx(-0.0086731542));
+  REQUIRE(values[2] == Approx(-1.6426151116));
+  REQUIRE(dpsi[0][0] == Approx(-66.5007223213));
+  REQUIRE(d2psi[0] == Approx(-21540.9990552510));
+
+  // the cache group is named by the hash of the inputs, i.e. of the uncorrected orbitals
+  std::string hash;
+  {
+    Libxml2Document doc3;
+    REQUIRE(doc3.parse("hcn.wfnoj.xml"));
+    OhmmsXPathObject MO_plain("//determinantset", doc3.getXPathContext());
+    REQUIRE(MO_plain.size() == 1);
+    xmlSetProp(MO_plain[0], (const xmlChar*)"name", (const xmlChar*)"LCAOBSet_nocusp");
+    SPOSetBuilder* bb_plain = bf.createSPOSetBuilder(MO_plain[0]);
+    REQUIRE(bb_plain != NULL);
+    bb_plain->loadBasisSetFromXML(MO_plain[0]);
+    OhmmsXPathObject slater_plain("//determinant", doc3.getXPathContext());
+    LCAOrbitalSet* sposet_plain = dynamic_cast<LCAOrbitalSet*>(bb_plain->createSPOSet(slater_plain[0]));
+    REQUIRE(sposet_plain != NULL);
+    hash = hashCuspInputs(elec, ions, *sposet_plain);
+  }
+
+  // An incomplete entry with wrong parameters is recomputed from the cusp file
+  hdf_archive h5f;
+  REQUIRE(h5f.open(cache_file, H5F_ACC_RDWR));
+  REQUIRE(h5f.is_group(hash));
+  h5f.push(hash, false);
+  h5f.unlink("complete");
+  h5f.unlink("parameters");
+  std::vector<double> wrong_params(3, 0.0);
+  h5f.write(wrong_params, "parameters");
+  h5f.pop();
+  h5f.close();
+
+  xmlSetProp(slater_base[0], (const xmlChar*)"cuspInfo", (const xmlChar*)cache_info.c_str());
+  SPOSet* sposet_redo = bb->createSPOSet(slater_base[0]);
+  values = 0.0;
+  sposet_redo->evaluate(elec, 0, values);
+  REQUIRE(values[0] == Approx(9.5150713253));
+
+  Matrix<CuspCorrectionParameters> info(3, 7);
+  REQUIRE(readCuspInfo(cache_info, cache_id, 7, info));
+  std::vector<double> params;
+  packCuspInfo(info, params);
+  REQUIRE(h5f.open(cache_file, H5F_ACC_RDONLY));
+  REQUIRE(h5f.is_group(hash));
+  h5f.push(hash, false);
+  int complete = 0;
+  REQUIRE(h5f.read(complete, "complete"));
+  REQUIRE(complete == 1);
+  std::vector<double> stored_params;
+  REQUIRE(h5f.read(stored_params, "parameters"));
+  REQUIRE(stored_params.size() == params.size());
+  for (int i = 0; i < params.size(); i++)
+    REQUIRE(stored_params[i] == Approx(params[i]));
+  h5f.pop();
+  h5f.close();
+
+  std::remove(cache_file.c_str());
+  std::remove(cache_info.c_str());
+
   SPOSetBuilderFactory::clear();
 }
 
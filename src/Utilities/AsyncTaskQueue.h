@@ -0,0 +1,115 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2018 Jeongnim Kim and QMCPACK developers.
+//
+// File developed by: Mark Dewing, mdewing@anl.gov, Argonne National Laboratory
+//
+// File created by: Mark Dewing, mdewing@anl.gov, Argonne National Laboratory
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** @file AsyncTaskQueue.h
+ * @brief Bounded queue of tasks executed in order by a background thread
+ */
+#ifndef QMCPLUSPLUS_ASYNC_TASK_QUEUE_H
+#define QMCPLUSPLUS_ASYNC_TASK_QUEUE_H
+
+#include <functional>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace qmcplusplus
+{
+
+/** run tasks, e.g. file writes, on a thread in the order of push
+ *
+ * push blocks while Capacity tasks are waiting so that a slow consumer
+ * throttles the producer instead of holding an unbounded amount of data.
+ * The destructor completes all the tasks pushed before it is called.
+ */
+class AsyncTaskQueue
+{
+public:
+  typedef std::function<void()> task_type;
+
+  /** constructor starts the thread
+   * @param capacity maximum number of waiting tasks
+   */
+  explicit AsyncTaskQueue(int capacity=16)
+    : Capacity(capacity>0? capacity:1), Busy(false), Done(false)
+  {
+    Worker=std::thread(&AsyncTaskQueue::run,this);
+  }
+
+  ///complete the tasks and join the thread
+  ~AsyncTaskQueue()
+  {
+    {
+      std::lock_guard<std::mutex> guard(Lock);
+      Done=true;
+    }
+    Pushed.notify_one();
+    Worker.join();
+  }
+
+  AsyncTaskQueue(const AsyncTaskQueue&) = delete;
+  AsyncTaskQueue& operator=(const AsyncTaskQueue&) = delete;
+
+  ///add a task, wait if the queue is full
+  inline void push(task_type task)
+  {
+    std::unique_lock<std::mutex> guard(Lock);
+    Popped.wait(guard,[this] { return Tasks.size()<static_cast<size_t>(Capacity); });
+    Tasks.push_back(std::move(task));
+    guard.unlock();
+    Pushed.notify_one();
+  }
+
+  ///wait until all the tasks pushed so far are completed
+  inline void flush()
+  {
+    std::unique_lock<std::mutex> guard(Lock);
+    Popped.wait(guard,[this] { return Tasks.empty() && !Busy; });
+  }
+
+private:
+  const int Capacity;
+  ///true while a task is running
+  bool Busy;
+  ///true when the thread has to stop once the queue is empty
+  bool Done;
+  std::deque<task_type> Tasks;
+  std::mutex Lock;
+  ///signaled when a task is added or Done is set
+  std::condition_variable Pushed;
+  ///signaled when a task is taken or completed
+  std::condition_variable Popped;
+  std::thread Worker;
+
+  inline void run()
+  {
+    std::unique_lock<std::mutex> guard(Lock);
+    while(true)
+    {
+      Pushed.wait(guard,[this] { return Done || !Tasks.empty(); });
+      if(Tasks.empty())
+        break;
+      task_type task(std::move(Tasks.front()));
+      Tasks.pop_front();
+      Busy=true;
+      guard.unlock();
+      Popped.notify_all();
+      task();
+      guard.lock();
+      Busy=false;
+      Popped.notify_all();
+    }
+  }
+};
+
+}
+#endif
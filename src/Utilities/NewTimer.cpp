@@ -105,12 +105,14 @@ void TimerManagerClass::collate_flat_profile(Communicate *comm, FlatProfileData
       p.nameList[timer.get_name()]=ind;
       p.timeList.push_back(timer.get_total());
       p.callList.push_back(timer.get_num_calls());
+      p.workList.push_back(timer.get_work_units());
     }
     else
     {
       int ind=(*it).second;
       p.timeList[ind]+=timer.get_total();
       p.callList[ind]+=timer.get_num_calls();
+      p.workList[ind]+=timer.get_work_units();
     }
   }
 
@@ -118,6 +120,7 @@ void TimerManagerClass::collate_flat_profile(Communicate *comm, FlatProfileData
   {
     comm->allreduce(p.timeList);
     comm->allreduce(p.callList);
+    comm->allreduce(p.workList);
   }
 }
 
@@ -125,11 +128,13 @@ struct ProfileData
 {
     double time;
     double calls;
+    double work;
 
     ProfileData &operator+=(const ProfileData &pd)
     {
         time += pd.time;
         calls += pd.calls;
+        work += pd.work;
         return *this;
     }
 };
@@ -194,6 +199,7 @@ void TimerManagerClass::collate_stack_profile(Communicate *comm, StackProfileDat
         get_stack_name_from_id(key, stack_name);
         pd.time = timer.get_total(key);
         pd.calls = timer.get_num_calls(key);
+        pd.work = timer.get_work_units(key);
 
         all_stacks[stack_name] += pd;
     }
@@ -210,6 +216,7 @@ void TimerManagerClass::collate_stack_profile(Communicate *comm, StackProfileDat
     p.timeList.push_back(si->second.time);
     p.timeExclList.push_back(si->second.time);
     p.callList.push_back(si->second.calls);
+    p.workList.push_back(si->second.work);
     idx++;
   }
 
@@ -381,6 +388,8 @@ TimerManagerClass::output_timing(Communicate *comm, Libxml2Document &doc, xmlNod
       doc.addChild(timer, "time_incl", p.timeList[i]);
       doc.addChild(timer, "time_excl", p.timeExclList[i]);
       doc.addChild(timer, "calls", p.callList[i]);
+      if (p.workList[i] > 0)
+        doc.addChild(timer, "work", p.workList[i]);
 
       int next_level = level;
       if (i+1 < p.names.size())
@@ -198,6 +198,7 @@ public:
     nameList_t nameList;
     timeList_t timeList;
     callList_t callList;
+    callList_t workList;
   };
 
   struct StackProfileData {
@@ -206,6 +207,7 @@ public:
     timeList_t timeList;
     timeList_t timeExclList;
     callList_t callList;
+    callList_t workList;
   };
 
   void collate_flat_profile(Communicate *comm, FlatProfileData &p);
@@ -228,6 +230,8 @@ protected:
   double start_time;
   double total_time;
   long num_calls;
+  ///work units, e.g. pairs or quadrature points, reported by add_work
+  long work_units;
   std::string name;
   bool active;
   timer_levels timer_level;
@@ -239,6 +243,7 @@ protected:
 
   std::map<StackKey, double> per_stack_total_time;
   std::map<StackKey, long> per_stack_num_calls;
+  std::map<StackKey, long> per_stack_work_units;
 #endif
 
 #ifdef USE_VTUNE_TASKS
@@ -248,6 +253,7 @@ public:
 #if not(ENABLE_TIMERS)
   inline void start() {}
   inline void stop() {}
+  inline void add_work(long n) {}
 #else
   void start()
   {
@@ -318,6 +324,26 @@ public:
           manager->current_timer()->set_parent(NULL);
           manager->pop_timer();
         }
+#endif
+      }
+    }
+  }
+
+  /** add n work units to the last call
+   *
+   * Call after stop, the work is assigned to the same stack.
+   */
+  void add_work(long n)
+  {
+    if (active)
+    {
+#ifdef USE_STACK_TIMERS
+      #pragma omp master
+#endif
+      {
+        work_units += n;
+#ifdef USE_STACK_TIMERS
+        per_stack_work_units[current_stack_key] += n;
 #endif
       }
     }
@@ -362,6 +388,18 @@ public:
   }
 #endif
 
+  inline long  get_work_units() const
+  {
+    return work_units;
+  }
+
+#ifdef USE_STACK_TIMERS
+  inline long  get_work_units(const StackKey &key)
+  {
+    return per_stack_work_units[key];
+  }
+#endif
+
   timer_id_t get_id() const
   {
     return timer_id;
@@ -381,10 +419,11 @@ public:
   {
     num_calls = 0;
     total_time=0.0;
+    work_units = 0;
   }
 
   NewTimer(const std::string& myname, timer_levels mytimer = timer_level_fine) :
-    total_time(0.0), num_calls(0), name(myname), active(true), timer_level(mytimer)
+    total_time(0.0), num_calls(0), work_units(0), name(myname), active(true), timer_level(mytimer)
     ,timer_id(0)
 #ifdef USE_STACK_TIMERS
   ,manager(NULL), parent(NULL)
@@ -0,0 +1,42 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2018 Jeongnim Kim and QMCPACK developers.
+//
+// File developed by: Mark Dewing, mdewing@anl.gov, Argonne National Laboratory
+//
+// File created by: Mark Dewing, mdewing@anl.gov, Argonne National Laboratory
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include "Utilities/AsyncTaskQueue.h"
+#include <vector>
+
+namespace qmcplusplus
+{
+
+TEST_CASE("AsyncTaskQueue", "[utilities]")
+{
+  std::vector<int> done;
+  {
+    // a queue smaller than the number of tasks makes push wait
+    AsyncTaskQueue queue(2);
+    for(int i=0; i<50; i++)
+      queue.push([&done,i] { done.push_back(i); });
+    queue.flush();
+    REQUIRE(done.size() == 50);
+    for(int i=0; i<50; i++)
+      REQUIRE(done[i] == i);
+
+    // the destructor completes the pending tasks
+    for(int i=50; i<60; i++)
+      queue.push([&done,i] { done.push_back(i); });
+  }
+  REQUIRE(done.size() == 60);
+  REQUIRE(done.back() == 59);
+}
+
+}
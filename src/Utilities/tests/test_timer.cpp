@@ -327,6 +327,50 @@ TEST_CASE("test_timer_nested_profile_collate", "[utilities]")
   doc.dump("tmp3.xml");
 }
 
+TEST_CASE("test_timer_work_units", "[utilities]")
+{
+  TimerManagerClass tm;
+  tm.set_timer_threshold(timer_level_fine);
+  NewTimer t1("timer1");
+  tm.addTimer(&t1);
+  NewTimer t2("timer2");
+  tm.addTimer(&t2);
+  NewTimer t2b("timer2");
+  tm.addTimer(&t2b);
+
+  fake_cpu_clock_increment = 1.1;
+  t1.start();
+    t2.start();
+    t2.stop();
+    t2.add_work(10);
+    t2b.start();
+    t2b.stop();
+    t2b.add_work(5);
+  t1.stop();
+  t2.start();
+  t2.stop();
+  t2.add_work(3);
+
+  TimerManagerClass::FlatProfileData p;
+  tm.collate_flat_profile(NULL, p);
+  TimerManagerClass::StackProfileData p2;
+  tm.collate_stack_profile(NULL, p2);
+#ifdef ENABLE_TIMERS
+  REQUIRE(t2.get_work_units() == 13);
+  REQUIRE(p.workList[p.nameList.at("timer1")] == 0);
+  REQUIRE(p.workList[p.nameList.at("timer2")] == 18);
+
+  REQUIRE(p2.names.size() == 3);
+  REQUIRE(p2.names[1] == "timer1/timer2");
+  REQUIRE(p2.workList[1] == 15);
+  REQUIRE(p2.names[2] == "timer2");
+  REQUIRE(p2.workList[2] == 3);
+#endif
+
+  t2.reset();
+  REQUIRE(t2.get_work_units() == 0);
+}
+
 #ifdef ENABLE_TIMERS
 TEST_CASE("test stack key")
 {
@@ -73,6 +73,11 @@ void QMCState::initialize(int argc, char **argv)
                   << "Use vacuum input tag as described in the manual." << std::endl;
       stopit=true;
     }
+    else if(c.find("--lr_cache")<c.size())
+    {
+      size_t pos=c.find('=');
+      lr_breakup_cache=(pos<c.size())? c.substr(pos+1):"lr_breakup.h5";
+    }
     else if(c.find("--noprint")<c.size())
     {//do not print Jastrow or PP
       io_node=false;
@@ -88,7 +93,7 @@ void QMCState::initialize(int argc, char **argv)
     std::cerr << std::endl << "QMCPACK version "<< QMCPACK_VERSION_MAJOR <<"." << QMCPACK_VERSION_MINOR << "." << QMCPACK_VERSION_PATCH
         << " built on " << __DATE__ << std::endl;
     print_git_info_if_present(std::cerr);
-    std::cerr << std::endl << "Usage: qmcpack input [--dryrun --save_wfs[=no] --gpu]" << std::endl << std::endl;
+    std::cerr << std::endl << "Usage: qmcpack input [--dryrun --save_wfs[=no] --lr_cache[=file] --gpu]" << std::endl << std::endl;
   }
   if(stopit)
   {
@@ -104,6 +109,8 @@ void QMCState::print_options(std::ostream& os)
     os << "  dryrun : qmc sections will be ignored." << std::endl;
   if(save_wfs)
     os << "  save_wfs=1 : save wavefunctions in hdf5. " << std::endl;
+  if(!lr_breakup_cache.empty())
+    os << "  lr_cache=" << lr_breakup_cache << " : cache the optimized breakups in hdf5. " << std::endl;
 }
 
 void QMCState::print_memory_change(const std::string& who, size_t before)
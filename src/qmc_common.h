@@ -49,6 +49,8 @@ struct QMCState
   int mpi_groups;
   ///size of memory allocated in byte per MPI
   size_t memory_allocated;
+  ///hdf5 file caching the optimized breakups, disabled if empty
+  std::string lr_breakup_cache;
 
   ///constructor
   QMCState();
@@ -22,6 +22,8 @@
 #include <iostream>
 #include <spline2/bspline_allocator.hpp>
 #include <spline2/MultiBsplineData.hpp>
+#include <spline2/MultiBsplineCompressed.hpp>
+#include <spline2/MultiBsplineSymmetry.hpp>
 #include <stdlib.h>
 
 namespace qmcplusplus
@@ -60,10 +62,14 @@ namespace qmcplusplus
       using real_type=typename bspline_traits<T,3>::real_type;
       ///actual einspline multi-bspline object
       spliner_type* spline_m;
+      ///compressed table, owns the coefficients when set
+      MultiBsplineCompressed<T>* spline_c;
+      ///symmetry of the reduced table, the table covers only the irreducible wedge when set
+      MultiBsplineSymmetry<T>* symmetry;
       ///use allocator
       einspline::Allocator myAllocator;
 
-      MultiBspline():spline_m(nullptr) {}
+      MultiBspline():spline_m(nullptr), spline_c(nullptr), symmetry(nullptr) {}
       MultiBspline(const MultiBspline& in)=delete;
       MultiBspline& operator=(const MultiBspline& in)=delete;
 
@@ -71,6 +77,8 @@ namespace qmcplusplus
       {
         if(spline_m!=nullptr)
           myAllocator.destroy(spline_m);
+        delete spline_c;
+        delete symmetry;
       }
 
       template<typename RV, typename IV>
@@ -112,9 +120,78 @@ namespace qmcplusplus
 
       size_t sizeInByte() const
       {
+        if(spline_c!=nullptr) return spline_c->sizeInByte();
         return (spline_m==nullptr)?0:spline_m->coefs_size*sizeof(T);
       }
 
+      /** replace the full precision coefficients by a compressed table
+       * @param compressed table created from spline_m
+       *
+       * spline_m keeps the grid and boundary conditions but its coefficients are released.
+       */
+      void adopt_compressed(MultiBsplineCompressed<T>* compressed)
+      {
+        delete spline_c;
+        spline_c=compressed;
+        einspline_free(spline_m->coefs);
+        spline_m->coefs=nullptr;
+      }
+
+      /** keep only the irreducible wedge of the table
+       * @param tol relative tolerance on the coefficients to accept a symmetry operation
+       * @return the order of the symmetry group used
+       *
+       * Each direction halved by the symmetry keeps num/2+1 grid cells so that
+       * any folded point is evaluated with the same coefficients as in the full table.
+       */
+      int reduce_symmetry(T tol)
+      {
+        MultiBsplineSymmetry<T>* sym=new MultiBsplineSymmetry<T>(spline_m,tol);
+        if(sym->order()==1)
+        {
+          delete sym;
+          return 1;
+        }
+
+        Ugrid grids[3]={spline_m->x_grid, spline_m->y_grid, spline_m->z_grid};
+        for(int d=0; d<3; d++)
+          if(sym->halved(d))
+          {
+            grids[d].num=grids[d].num/2+1;
+            grids[d].end=grids[d].start+grids[d].num*grids[d].delta;
+          }
+        spliner_type* reduced=myAllocator.allocateMultiBspline(grids[0],grids[1],grids[2],
+            spline_m->xBC,spline_m->yBC,spline_m->zBC,spline_m->num_splines);
+        // keep the grid spacing of the full table
+        reduced->x_grid=grids[0];
+        reduced->y_grid=grids[1];
+        reduced->z_grid=grids[2];
+
+        const int nx=grids[0].num+3, ny=grids[1].num+3, nz=grids[2].num+3;
+        for(int ix=0; ix<nx; ix++)
+          for(int iy=0; iy<ny; iy++)
+          {
+            const T* restrict in=spline_m->coefs+ix*spline_m->x_stride+iy*spline_m->y_stride;
+            T* restrict out=reduced->coefs+ix*reduced->x_stride+iy*reduced->y_stride;
+            std::copy(in,in+nz*spline_m->z_stride,out);
+          }
+
+        myAllocator.destroy(spline_m);
+        spline_m=reduced;
+        delete symmetry;
+        symmetry=sym;
+        return sym->order();
+      }
+
+      /** map a point in the unit of the table to the irreducible wedge
+       * @return the operations to be passed to symmetry->unfold_*, 0 if the table is not reduced
+       */
+      template<typename PT>
+      inline int fold(PT& u) const
+      {
+        return (symmetry==nullptr)?0:symmetry->fold(u);
+      }
+
       template<typename CT>
       inline void set(int i, CT& data)
       {
@@ -217,6 +294,17 @@ namespace qmcplusplus
       void evaluate_v_impl(T r, T* restrict vals) const;
       /// compute VGL.
       void evaluate_vgl_impl(T r, T* restrict vals, T* restrict grads, T* restrict lapl) const;
+
+      /** locate r and compute the prefactors of the 4 coefficient rows of its cell
+       * @param r radial coordinate
+       * @param a prefactors of the value
+       * @return the first coefficient row, the next rows are spline_m.x_stride apart
+       *
+       * Used by the callers contracting the splines on the fly.
+       */
+      const T* prefactors(T r, T* restrict a) const;
+      /// prefactors of the value, the first and the second derivatives
+      const T* prefactors(T r, T* restrict a, T* restrict da, T* restrict d2a) const;
     };
 
 }/** qmcplusplus namespace */
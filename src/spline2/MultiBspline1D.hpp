@@ -80,6 +80,34 @@ namespace qmcplusplus
       }
     }
 
+  template<typename T>
+    inline const T*
+    MultiBspline1D<T>::prefactors(T x, T* restrict a) const
+    {
+      x -= spline_m.x_grid.start;
+      T tx; int ix;
+      spline2::getSplineBound(x*spline_m.x_grid.delta_inv,tx,ix,spline_m.x_grid.num-2);
+      spline2::MultiBsplineData<T>::compute_prefactors(a, tx);
+      return spline_m.coefs + ix*spline_m.x_stride;
+    }
+
+  template<typename T>
+    inline const T*
+    MultiBspline1D<T>::prefactors(T x, T* restrict a, T* restrict da, T* restrict d2a) const
+    {
+      x -= spline_m.x_grid.start;
+      T tx; int ix;
+      spline2::getSplineBound(x*spline_m.x_grid.delta_inv,tx,ix,spline_m.x_grid.num-2);
+      spline2::MultiBsplineData<T>::compute_prefactors(a, da, d2a, tx);
+      const T dxInv = spline_m.x_grid.delta_inv;
+      for(int i=0; i<4; i++)
+      {
+        da[i]*=dxInv;
+        d2a[i]*=dxInv*dxInv;
+      }
+      return spline_m.coefs + ix*spline_m.x_stride;
+    }
+
 }/** qmcplusplus namespace */
 #endif
 
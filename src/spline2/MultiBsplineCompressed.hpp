@@ -0,0 +1,101 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2018 QMCPACK developers.
+//
+// File developed by: Ye Luo, yeluo@anl.gov, Argonne National Laboratory
+//
+// File created by: Ye Luo, yeluo@anl.gov, Argonne National Laboratory
+//////////////////////////////////////////////////////////////////////////////////////
+// -*- C++ -*-
+/**@file MultiBsplineCompressed.hpp
+ *
+ * define MultiBsplineCompressed, a multi-bspline table with 16-bit coefficients
+ * The evaluation functions are defined in MultiBsplineCompressedEval.hpp
+ */
+#ifndef QMCPLUSPLUS_MULTIEINSPLINE_COMPRESSED_HPP
+#define QMCPLUSPLUS_MULTIEINSPLINE_COMPRESSED_HPP
+#include "config.h"
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <simd/allocator.hpp>
+#include <spline2/bspline_traits.hpp>
+
+namespace qmcplusplus
+{
+  /** multi-bspline table storing the coefficients as scaled 16-bit integers
+   * @tparam T precision of the evaluation
+   *
+   * The coefficient of the n-th spline is coefs[.+n]*scales[n].
+   * The grid, strides and layout are identical to the full precision table
+   * so that the kernels only differ by the type of the coefficient loads.
+   * The per-spline scale is applied once to the accumulated results.
+   */
+  template<typename T>
+    struct MultiBsplineCompressed
+    {
+      using coef_type=int16_t;
+      using SplineType=typename bspline_traits<T,3>::SplineType;
+
+      Ugrid x_grid, y_grid, z_grid;
+      intptr_t x_stride, y_stride, z_stride;
+      int num_splines;
+      size_t coefs_size;
+      ///quantized coefficients
+      coef_type* restrict coefs;
+      ///scale factor of each spline
+      T* restrict scales;
+
+      aligned_vector<coef_type> coefs_data;
+      aligned_vector<T> scales_data;
+
+      /** construct the compressed table from a full precision table
+       * @param spline_m full precision table
+       */
+      explicit MultiBsplineCompressed(const SplineType* spline_m):
+        x_grid(spline_m->x_grid), y_grid(spline_m->y_grid), z_grid(spline_m->z_grid),
+        x_stride(spline_m->x_stride), y_stride(spline_m->y_stride), z_stride(spline_m->z_stride),
+        num_splines(spline_m->num_splines), coefs_size(spline_m->coefs_size)
+      {
+        coefs_data.resize(coefs_size);
+        scales_data.resize(z_stride);
+        coefs=coefs_data.data();
+        scales=scales_data.data();
+
+        // the largest magnitude of each spline sets its scale
+        const T* restrict in=spline_m->coefs;
+        std::fill(scales,scales+z_stride,T(0));
+        for(size_t i=0; i<coefs_size; i+=z_stride)
+          for(int n=0; n<z_stride; n++)
+            scales[n]=std::max(scales[n],std::abs(in[i+n]));
+
+        constexpr T qmax(32767);
+        aligned_vector<T> inv_scales(z_stride);
+        for(int n=0; n<z_stride; n++)
+        {
+          inv_scales[n]=(scales[n]>T(0))?qmax/scales[n]:T(0);
+          scales[n]/=qmax;
+        }
+
+        for(size_t i=0; i<coefs_size; i+=z_stride)
+          for(int n=0; n<z_stride; n++)
+            coefs[i+n]=static_cast<coef_type>(std::lround(in[i+n]*inv_scales[n]));
+      }
+
+      MultiBsplineCompressed(const MultiBsplineCompressed& in)=delete;
+      MultiBsplineCompressed& operator=(const MultiBsplineCompressed& in)=delete;
+
+      size_t sizeInByte() const
+      {
+        return coefs_size*sizeof(coef_type)+z_stride*sizeof(T);
+      }
+    };
+
+  template<typename T> struct bspline_type<MultiBsplineCompressed<T> >
+  {
+    typedef typename MultiBsplineCompressed<T>::coef_type value_type;
+  };
+}
+#endif
@@ -0,0 +1,342 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2018 QMCPACK developers.
+//
+// File developed by: Ye Luo, yeluo@anl.gov, Argonne National Laboratory
+//
+// File created by: Ye Luo, yeluo@anl.gov, Argonne National Laboratory
+//////////////////////////////////////////////////////////////////////////////////////
+// -*- C++ -*-
+/**@file MultiBsplineCompressedEval.hpp
+ *
+ * evaluate_v/vgl/vgh_impl for MultiBsplineCompressed.
+ * The 16-bit coefficients are expanded to T in register and
+ * the per-spline scales are applied to the accumulated results.
+ * Unlike the full precision table, the coefficient rows are only aligned to
+ * half of the SIMD alignment and are excluded from the aligned clauses.
+ */
+#ifndef SPLINE2_MULTIEINSPLINE_COMPRESSED_EVAL_HPP
+#define SPLINE2_MULTIEINSPLINE_COMPRESSED_EVAL_HPP
+
+#include <spline2/MultiBsplineCompressed.hpp>
+
+namespace spline2
+{
+
+  /** no scaling is needed for the full precision table */
+  template<typename SPLINET, typename T>
+    inline void apply_spline_scales(const SPLINET *restrict spline_m, T* restrict vals, int first, int last)
+    { }
+
+  /** scale the results accumulated with the quantized coefficients */
+  template<typename T>
+    inline void apply_spline_scales(const qmcplusplus::MultiBsplineCompressed<T> *restrict spline_m,
+                                    T* restrict vals, int first, int last)
+    {
+      const T* restrict scales=spline_m->scales+first;
+      const int num_splines=last-first;
+      #pragma omp simd aligned(vals)
+      for(int n=0; n<num_splines; n++)
+        vals[n]*=scales[n];
+    }
+
+  template<typename T>
+    inline void evaluate_v_impl(const qmcplusplus::MultiBsplineCompressed<T> *restrict spline_m,
+                                T x, T y, T z, T* restrict vals, int first, int last)
+    {
+      using coef_type=typename qmcplusplus::MultiBsplineCompressed<T>::coef_type;
+      x -= spline_m->x_grid.start;
+      y -= spline_m->y_grid.start;
+      z -= spline_m->z_grid.start;
+      T tx,ty,tz;
+      int ix,iy,iz;
+      getSplineBound(x*spline_m->x_grid.delta_inv,tx,ix,spline_m->x_grid.num-1);
+      getSplineBound(y*spline_m->y_grid.delta_inv,ty,iy,spline_m->y_grid.num-1);
+      getSplineBound(z*spline_m->z_grid.delta_inv,tz,iz,spline_m->z_grid.num-1);
+      T a[4], b[4], c[4];
+
+      MultiBsplineData<T>::compute_prefactors(a, tx);
+      MultiBsplineData<T>::compute_prefactors(b, ty);
+      MultiBsplineData<T>::compute_prefactors(c, tz);
+
+      const intptr_t xs = spline_m->x_stride;
+      const intptr_t ys = spline_m->y_stride;
+      const intptr_t zs = spline_m->z_stride;
+
+      constexpr T zero(0);
+      const int num_splines=last-first;
+      std::fill(vals,vals+num_splines,zero);
+
+      for (int i=0; i<4; i++)
+        for (int j=0; j<4; j++)
+        {
+          const T pre00 =  a[i]*b[j];
+          const coef_type* restrict coefs = spline_m->coefs + ((ix+i)*xs + (iy+j)*ys + iz*zs) + first;
+          const coef_type* restrict coefszs  = coefs+zs;
+          const coef_type* restrict coefs2zs = coefs+2*zs;
+          const coef_type* restrict coefs3zs = coefs+3*zs;
+          #pragma omp simd aligned(vals)
+          for(int n=0; n<num_splines; n++)
+            vals[n] += pre00*(c[0]*T(coefs[n]) + c[1]*T(coefszs[n]) + c[2]*T(coefs2zs[n]) + c[3]*T(coefs3zs[n]));
+        }
+
+      apply_spline_scales(spline_m,vals,first,last);
+    }
+
+  template<typename T>
+    inline void evaluate_vgl_impl(const qmcplusplus::MultiBsplineCompressed<T> *restrict spline_m, T x, T y, T z,
+        T* restrict vals, T* restrict grads, T* restrict lapl, size_t out_offset, int first, int last)
+    {
+      using coef_type=typename qmcplusplus::MultiBsplineCompressed<T>::coef_type;
+      x -= spline_m->x_grid.start;
+      y -= spline_m->y_grid.start;
+      z -= spline_m->z_grid.start;
+      T tx,ty,tz;
+      int ix,iy,iz;
+      getSplineBound(x*spline_m->x_grid.delta_inv,tx,ix,spline_m->x_grid.num-1);
+      getSplineBound(y*spline_m->y_grid.delta_inv,ty,iy,spline_m->y_grid.num-1);
+      getSplineBound(z*spline_m->z_grid.delta_inv,tz,iz,spline_m->z_grid.num-1);
+
+      T a[4],b[4],c[4],da[4],db[4],dc[4],d2a[4],d2b[4],d2c[4];
+
+      MultiBsplineData<T>::compute_prefactors(a, da, d2a, tx);
+      MultiBsplineData<T>::compute_prefactors(b, db, d2b, ty);
+      MultiBsplineData<T>::compute_prefactors(c, dc, d2c, tz);
+
+      const intptr_t xs = spline_m->x_stride;
+      const intptr_t ys = spline_m->y_stride;
+      const intptr_t zs = spline_m->z_stride;
+
+      const int num_splines=last-first;
+
+      T* restrict gx=grads;
+      T* restrict gy=grads+  out_offset;
+      T* restrict gz=grads+2*out_offset;
+      T* restrict lx=lapl;
+      T* restrict ly=lapl+  out_offset;
+      T* restrict lz=lapl+2*out_offset;
+
+      std::fill(vals,vals+num_splines,T());
+      std::fill(gx,gx+num_splines,T());
+      std::fill(gy,gy+num_splines,T());
+      std::fill(gz,gz+num_splines,T());
+      std::fill(lx,lx+num_splines,T());
+      std::fill(ly,ly+num_splines,T());
+      std::fill(lz,lz+num_splines,T());
+
+      for (int i=0; i<4; i++)
+        for (int j=0; j<4; j++)
+        {
+          const T pre20 = d2a[i]*  b[j];
+          const T pre10 =  da[i]*  b[j];
+          const T pre00 =   a[i]*  b[j];
+          const T pre01 =   a[i]* db[j];
+          const T pre02 =   a[i]*d2b[j];
+
+          const coef_type* restrict coefs = spline_m->coefs + ((ix+i)*xs + (iy+j)*ys + iz*zs) + first;
+          const coef_type* restrict coefszs  = coefs+zs;
+          const coef_type* restrict coefs2zs = coefs+2*zs;
+          const coef_type* restrict coefs3zs = coefs+3*zs;
+
+          #pragma omp simd aligned(gx,gy,gz,lx,ly,lz,vals)
+          for (int n=0; n<num_splines; n++)
+          {
+            const T coefsv = coefs[n];
+            const T coefsvzs = coefszs[n];
+            const T coefsv2zs = coefs2zs[n];
+            const T coefsv3zs = coefs3zs[n];
+
+            T sum0 =   c[0] * coefsv +   c[1] * coefsvzs +   c[2] * coefsv2zs +   c[3] * coefsv3zs;
+            T sum1 =  dc[0] * coefsv +  dc[1] * coefsvzs +  dc[2] * coefsv2zs +  dc[3] * coefsv3zs;
+            T sum2 = d2c[0] * coefsv + d2c[1] * coefsvzs + d2c[2] * coefsv2zs + d2c[3] * coefsv3zs;
+            gx[n] += pre10 * sum0;
+            gy[n] += pre01 * sum0;
+            gz[n] += pre00 * sum1;
+            lx[n] += pre20 * sum0;
+            ly[n] += pre02 * sum0;
+            lz[n] += pre00 * sum2;
+            vals[n] += pre00 * sum0;
+          }
+        }
+
+      const T dxInv = spline_m->x_grid.delta_inv;
+      const T dyInv = spline_m->y_grid.delta_inv;
+      const T dzInv = spline_m->z_grid.delta_inv;
+
+      const T dxInv2 = dxInv*dxInv;
+      const T dyInv2 = dyInv*dyInv;
+      const T dzInv2 = dzInv*dzInv;
+
+      const T* restrict scales=spline_m->scales+first;
+      #pragma omp simd aligned(gx,gy,gz,lx,vals)
+      for (int n=0; n<num_splines; n++)
+      {
+        const T s=scales[n];
+        vals[n] *= s;
+        gx[n] *= dxInv*s;
+        gy[n] *= dyInv*s;
+        gz[n] *= dzInv*s;
+        lx[n] = (lx[n]*dxInv2+ly[n]*dyInv2+lz[n]*dzInv2)*s;
+      }
+    }
+
+  template<typename T>
+    inline void evaluate_vgh_impl(const qmcplusplus::MultiBsplineCompressed<T> *restrict spline_m, T x, T y, T z,
+        T* restrict vals, T* restrict grads, T* restrict hess, size_t out_offset, int first, int last)
+    {
+      using coef_type=typename qmcplusplus::MultiBsplineCompressed<T>::coef_type;
+      int ix,iy,iz;
+      T tx,ty,tz;
+      T a[4],b[4],c[4],da[4],db[4],dc[4],d2a[4],d2b[4],d2c[4];
+
+      x -= spline_m->x_grid.start;
+      y -= spline_m->y_grid.start;
+      z -= spline_m->z_grid.start;
+      getSplineBound(x*spline_m->x_grid.delta_inv,tx,ix,spline_m->x_grid.num-1);
+      getSplineBound(y*spline_m->y_grid.delta_inv,ty,iy,spline_m->y_grid.num-1);
+      getSplineBound(z*spline_m->z_grid.delta_inv,tz,iz,spline_m->z_grid.num-1);
+
+      MultiBsplineData<T>::compute_prefactors(a, da, d2a, tx);
+      MultiBsplineData<T>::compute_prefactors(b, db, d2b, ty);
+      MultiBsplineData<T>::compute_prefactors(c, dc, d2c, tz);
+
+      const intptr_t xs = spline_m->x_stride;
+      const intptr_t ys = spline_m->y_stride;
+      const intptr_t zs = spline_m->z_stride;
+
+      const int num_splines=last-first;
+
+      T* restrict gx=grads;
+      T* restrict gy=grads  +out_offset;
+      T* restrict gz=grads+2*out_offset;
+
+      T* restrict hxx=hess;
+      T* restrict hxy=hess+  out_offset;
+      T* restrict hxz=hess+2*out_offset;
+      T* restrict hyy=hess+3*out_offset;
+      T* restrict hyz=hess+4*out_offset;
+      T* restrict hzz=hess+5*out_offset;
+
+      std::fill(vals,vals+num_splines,T());
+      std::fill(gx,gx+num_splines,T());
+      std::fill(gy,gy+num_splines,T());
+      std::fill(gz,gz+num_splines,T());
+      std::fill(hxx,hxx+num_splines,T());
+      std::fill(hxy,hxy+num_splines,T());
+      std::fill(hxz,hxz+num_splines,T());
+      std::fill(hyy,hyy+num_splines,T());
+      std::fill(hyz,hyz+num_splines,T());
+      std::fill(hzz,hzz+num_splines,T());
+
+      for (int i=0; i<4; i++)
+        for (int j=0; j<4; j++)
+        {
+          const coef_type* restrict coefs = spline_m->coefs + ((ix+i)*xs + (iy+j)*ys + iz*zs) + first;
+          const coef_type* restrict coefszs  = coefs+zs;
+          const coef_type* restrict coefs2zs = coefs+2*zs;
+          const coef_type* restrict coefs3zs = coefs+3*zs;
+
+          const T pre20 = d2a[i]*  b[j];
+          const T pre10 =  da[i]*  b[j];
+          const T pre00 =   a[i]*  b[j];
+          const T pre11 =  da[i]* db[j];
+          const T pre01 =   a[i]* db[j];
+          const T pre02 =   a[i]*d2b[j];
+
+          #pragma omp simd aligned(gx,gy,gz,hxx,hxy,hxz,hyy,hyz,hzz,vals)
+          for (int n=0; n<num_splines; n++)
+          {
+            const T coefsv = coefs[n];
+            const T coefsvzs = coefszs[n];
+            const T coefsv2zs = coefs2zs[n];
+            const T coefsv3zs = coefs3zs[n];
+
+            T sum0 =   c[0] * coefsv +   c[1] * coefsvzs +   c[2] * coefsv2zs +   c[3] * coefsv3zs;
+            T sum1 =  dc[0] * coefsv +  dc[1] * coefsvzs +  dc[2] * coefsv2zs +  dc[3] * coefsv3zs;
+            T sum2 = d2c[0] * coefsv + d2c[1] * coefsvzs + d2c[2] * coefsv2zs + d2c[3] * coefsv3zs;
+
+            hxx[n] += pre20 * sum0;
+            hxy[n] += pre11 * sum0;
+            hxz[n] += pre10 * sum1;
+            hyy[n] += pre02 * sum0;
+            hyz[n] += pre01 * sum1;
+            hzz[n] += pre00 * sum2;
+            gx[n] += pre10 * sum0;
+            gy[n] += pre01 * sum0;
+            gz[n] += pre00 * sum1;
+            vals[n]+= pre00 * sum0;
+          }
+        }
+
+      const T dxInv = spline_m->x_grid.delta_inv;
+      const T dyInv = spline_m->y_grid.delta_inv;
+      const T dzInv = spline_m->z_grid.delta_inv;
+      const T dxx=dxInv*dxInv;
+      const T dyy=dyInv*dyInv;
+      const T dzz=dzInv*dzInv;
+      const T dxy=dxInv*dyInv;
+      const T dxz=dxInv*dzInv;
+      const T dyz=dyInv*dzInv;
+
+      const T* restrict scales=spline_m->scales+first;
+      #pragma omp simd aligned(gx,gy,gz,hxx,hxy,hxz,hyy,hyz,hzz,vals)
+      for (int n=0; n<num_splines; n++)
+      {
+        const T s=scales[n];
+        vals[n]*=s;
+        gx[n]*=dxInv*s;
+        gy[n]*=dyInv*s;
+        gz[n]*=dzInv*s;
+        hxx[n]*=dxx*s;
+        hyy[n]*=dyy*s;
+        hzz[n]*=dzz*s;
+        hxy[n]*=dxy*s;
+        hxz[n]*=dxz*s;
+        hyz[n]*=dyz*s;
+      }
+    }
+
+  /** estimate the error introduced by the compression
+   * @param spline_m full precision table
+   * @param spline_c compressed table
+   * @param npoints number of sampling points
+   * @return the largest absolute error of the values divided by the largest absolute value
+   *
+   * The sampling points are quasi-random and deterministic so that
+   * every MPI rank makes the same decision.
+   */
+  template<typename T>
+    T compression_error(const typename qmcplusplus::bspline_traits<T,3>::SplineType *restrict spline_m,
+                        const qmcplusplus::MultiBsplineCompressed<T> *restrict spline_c, int npoints=64)
+    {
+      const int n=spline_m->num_splines;
+      qmcplusplus::aligned_vector<T> v_full(n), v_comp(n);
+      // additive recurrence with the generalized golden ratio in 3D
+      const double alpha[3]={0.8191725133961645, 0.6710436067037893, 0.5497004779019703};
+      T max_val(0), max_err(0);
+      for(int ip=0; ip<npoints; ip++)
+      {
+        T u[3];
+        for(int d=0; d<3; d++)
+        {
+          double ipart;
+          u[d]=static_cast<T>(std::modf(0.5+alpha[d]*(ip+1),&ipart));
+        }
+        const T x=spline_m->x_grid.start+u[0]*(spline_m->x_grid.end-spline_m->x_grid.start);
+        const T y=spline_m->y_grid.start+u[1]*(spline_m->y_grid.end-spline_m->y_grid.start);
+        const T z=spline_m->z_grid.start+u[2]*(spline_m->z_grid.end-spline_m->z_grid.start);
+        evaluate_v_impl(spline_m,x,y,z,v_full.data(),0,n);
+        evaluate_v_impl(spline_c,x,y,z,v_comp.data(),0,n);
+        for(int i=0; i<n; i++)
+        {
+          max_val=std::max(max_val,std::abs(v_full[i]));
+          max_err=std::max(max_err,std::abs(v_full[i]-v_comp[i]));
+        }
+      }
+      return max_val>T(0)?max_err/max_val:T(0);
+    }
+
+}
+#endif
@@ -43,6 +43,12 @@
 #include <spline2/MultiBsplineVGLH.hpp>
 #endif
 
+///include evaluate_v/vgl/vgh_impl for the compressed table
+#include <spline2/MultiBsplineCompressedEval.hpp>
+
+///include evaluate_v_multi_pos_impl
+#include <spline2/MultiBsplineValueMultiPos.hpp>
+
 namespace spline2
 {
 
@@ -59,6 +65,18 @@ namespace spline2
       evaluate_v_impl(spline,r[0],r[1],r[2],psi.data()+first,first,last);
     }
 
+  /** evaluate values of a batch of positions in the range [first,last)
+   * @param r_list positions, r_list[ip] is the ip-th position
+   * @param multi_psi output matrix, the row multi_psi[ip] holds the values of r_list[ip]
+   *
+   * the row size of multi_psi must be padded to keep every row aligned.
+   */
+  template<typename SPLINET, typename PTV, typename VM>
+    __forceinline void evaluate3d_multi_pos(const SPLINET &spline, const PTV& r_list, VM& multi_psi, int first, int last)
+    {
+      evaluate_v_multi_pos_impl(spline,r_list.data(),r_list.size(),multi_psi.data()+first,multi_psi.cols(),first,last);
+    }
+
   /// evaluate values, gradients, laplacians optionally in the range [first,last)
   template<typename SPLINET, typename PT, typename VT, typename GT, typename LT>
     __forceinline void evaluate3d_vgl(const SPLINET &spline, const PT& r, VT& psi, GT& grad, LT& lap)
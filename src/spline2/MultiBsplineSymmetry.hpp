@@ -0,0 +1,261 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2018 QMCPACK developers.
+//
+// File developed by: Ye Luo, yeluo@anl.gov, Argonne National Laboratory
+//
+// File created by: Ye Luo, yeluo@anl.gov, Argonne National Laboratory
+//////////////////////////////////////////////////////////////////////////////////////
+// -*- C++ -*-
+/**@file MultiBsplineSymmetry.hpp
+ *
+ * define MultiBsplineSymmetry, the point symmetry of a periodic multi-bspline table
+ *
+ * The operations considered are the sign flips of the reduced coordinates,
+ * u_d -> -u_d for a subset of the directions. They include the inversion,
+ * the mirror planes and the two-fold axes along the lattice vectors.
+ * An operation is accepted only if every spline is even or odd under it,
+ * so the orbitals mixed by an operation, e.g. degenerate p-like bands
+ * under a rotation, never reduce the table.
+ */
+#ifndef QMCPLUSPLUS_MULTIEINSPLINE_SYMMETRY_HPP
+#define QMCPLUSPLUS_MULTIEINSPLINE_SYMMETRY_HPP
+#include "config.h"
+#include <cmath>
+#include <algorithm>
+#include <simd/allocator.hpp>
+#include <spline2/bspline_traits.hpp>
+
+namespace qmcplusplus
+{
+  /** sign flips of the reduced coordinates which leave a table invariant
+   * @tparam T precision of the table
+   *
+   * The group is stored by its generators g_k with the direction dim_k halved by g_k.
+   * A generator never flips the direction halved by an earlier one.
+   * Folding a point u in [0,1)^3 applies g_k if u[dim_k]>1/2, in order,
+   * and the result lies in the irreducible wedge of the unit cell.
+   * With psi_n(u)=sign_k[n]*psi_n(g_k u), the values, gradients and hessians
+   * evaluated at the folded point are mapped back by unfold_*.
+   */
+  template<typename T>
+    struct MultiBsplineSymmetry
+    {
+      using SplineType=typename bspline_traits<T,3>::SplineType;
+
+      ///number of generators
+      int num_gens;
+      ///directions flipped by each generator, bit d for u_d
+      int flip_mask[3];
+      ///direction halved by each generator
+      int dim[3];
+      ///sign of each spline under each generator
+      aligned_vector<T> signs[3];
+
+      /** find the symmetry of a table
+       * @param spline_m full table in the reduced coordinates
+       * @param tol relative tolerance on the coefficients
+       */
+      MultiBsplineSymmetry(const SplineType* spline_m, T tol): num_gens(0)
+      {
+        const Ugrid* grids[3]={&spline_m->x_grid, &spline_m->y_grid, &spline_m->z_grid};
+        const int lcodes[3]={spline_m->xBC.lCode, spline_m->yBC.lCode, spline_m->zBC.lCode};
+        int periodic=0;
+        for(int d=0; d<3; d++)
+          if(lcodes[d]==PERIODIC && grids[d]->start==0.0 && grids[d]->end==1.0)
+            periodic|=1<<d;
+
+        // verify the operations, mirrors first, and keep their signs
+        const int candidates[7]={1,2,4,3,5,6,7};
+        bool found[8]={false};
+        aligned_vector<T> op_signs[8];
+        for(int ic=0; ic<7; ic++)
+        {
+          const int mask=candidates[ic];
+          if((mask&periodic)!=mask) continue;
+          op_signs[mask].resize(spline_m->z_stride);
+          found[mask]=find_signs(spline_m,mask,tol,op_signs[mask].data());
+        }
+
+        // pick the generators, each preserving the directions already halved
+        int used=0;
+        for(int ic=0; ic<7 && num_gens<3; ic++)
+        {
+          const int mask=candidates[ic];
+          if(!found[mask] || (mask&used)) continue;
+          int d=0;
+          while(!(mask&(1<<d))) d++;
+          flip_mask[num_gens]=mask;
+          dim[num_gens]=d;
+          signs[num_gens]=op_signs[mask];
+          used|=1<<d;
+          num_gens++;
+        }
+      }
+
+      /// order of the group used to reduce the table
+      inline int order() const
+      {
+        return 1<<num_gens;
+      }
+
+      /// return true if the direction d is halved
+      inline bool halved(int d) const
+      {
+        for(int k=0; k<num_gens; k++)
+          if(dim[k]==d) return true;
+        return false;
+      }
+
+      /** map a point in [0,1)^3 to the irreducible wedge
+       * @return the generators applied, bit k for g_k
+       */
+      template<typename PT>
+        inline int fold(PT& u) const
+        {
+          int applied=0;
+          for(int k=0; k<num_gens; k++)
+            if(u[dim[k]]>T(0.5))
+            {
+              for(int d=0; d<3; d++)
+                if(flip_mask[k]&(1<<d)) u[d]=(u[d]>T(0))?T(1)-u[d]:T(0);
+              applied|=1<<k;
+            }
+          return applied;
+        }
+
+      /// map the values in [first,last) back to the original point
+      inline void unfold_v(int applied, T* restrict vals, int first, int last) const
+      {
+        for(int k=0; k<num_gens; k++)
+          if(applied&(1<<k))
+          {
+            const T* restrict s=signs[k].data();
+            #pragma omp simd
+            for(int n=first; n<last; n++)
+              vals[n]*=s[n];
+          }
+      }
+
+      /** map the values, gradients and hessians in [first,last) back to the original point
+       * @param out_offset stride between the components of grads and hess
+       */
+      inline void unfold_vgh(int applied, T* restrict vals, T* restrict grads, T* restrict hess,
+                             size_t out_offset, int first, int last) const
+      {
+        // hessian components xx, xy, xz, yy, yz, zz
+        const int hi[6]={0,0,0,1,1,2};
+        const int hj[6]={0,1,2,1,2,2};
+        for(int k=0; k<num_gens; k++)
+          if(applied&(1<<k))
+          {
+            const T* restrict s=signs[k].data();
+            T f[3];
+            for(int d=0; d<3; d++)
+              f[d]=(flip_mask[k]&(1<<d))?T(-1):T(1);
+            #pragma omp simd
+            for(int n=first; n<last; n++)
+              vals[n]*=s[n];
+            for(int d=0; d<3; d++)
+            {
+              T* restrict g=grads+d*out_offset;
+              const T fd=f[d];
+              #pragma omp simd
+              for(int n=first; n<last; n++)
+                g[n]*=fd*s[n];
+            }
+            for(int c=0; c<6; c++)
+            {
+              T* restrict h=hess+c*out_offset;
+              const T fc=f[hi[c]]*f[hj[c]];
+              #pragma omp simd
+              for(int n=first; n<last; n++)
+                h[n]*=fc*s[n];
+            }
+          }
+      }
+
+      template<typename VV>
+        inline void unfold_v(int applied, VV& psi, int first, int last) const
+        {
+          unfold_v(applied,psi.data(),first,last);
+        }
+
+      template<typename VV, typename GV, typename HV>
+        inline void unfold_vgh(int applied, VV& psi, GV& grad, HV& hess, int first, int last) const
+        {
+          unfold_vgh(applied,psi.data(),grad.data(),hess.data(),psi.size(),first,last);
+        }
+
+      private:
+
+      /** index of the coefficient at -u along a periodic direction
+       * @param k stored index, the basis function centered at grid point k-1
+       * @param n number of grid points
+       */
+      static inline int image(int k, int n)
+      {
+        const int m=(k-1+n)%n;
+        return (n-m)%n+1;
+      }
+
+      /** check that every spline is even or odd under the flips in mask
+       * @param sign output, the sign of each spline
+       * @return true if all the splines are symmetric within tol
+       */
+      static bool find_signs(const SplineType* spline_m, int mask, T tol, T* restrict sign)
+      {
+        const int num[3]={spline_m->x_grid.num, spline_m->y_grid.num, spline_m->z_grid.num};
+        const intptr_t xs=spline_m->x_stride;
+        const intptr_t ys=spline_m->y_stride;
+        const int zs=spline_m->z_stride;
+        const int ns=spline_m->num_splines;
+        const int nx=num[0]+3, ny=num[1]+3, nz=num[2]+3;
+        const T* restrict coefs=spline_m->coefs;
+
+        // the largest coefficient of each spline sets its sign
+        aligned_vector<T> maxabs(zs,T(0));
+        std::vector<size_t> maxloc(zs,0);
+        for(size_t i=0; i<spline_m->coefs_size; i+=zs)
+          for(int n=0; n<ns; n++)
+            if(std::abs(coefs[i+n])>maxabs[n])
+            {
+              maxabs[n]=std::abs(coefs[i+n]);
+              maxloc[n]=i;
+            }
+
+        auto image_offset=[&](size_t i)
+        {
+          int k[3]={int(i/xs), int((i%xs)/ys), int((i%ys)/zs)};
+          for(int d=0; d<3; d++)
+            if(mask&(1<<d)) k[d]=image(k[d],num[d]);
+          return k[0]*xs+k[1]*ys+k[2]*zs;
+        };
+
+        std::fill(sign,sign+zs,T(1));
+        for(int n=0; n<ns; n++)
+        {
+          if(maxabs[n]==T(0)) continue;
+          const T c=coefs[maxloc[n]+n];
+          const T c_image=coefs[image_offset(maxloc[n])+n];
+          sign[n]=(c*c_image>T(0))?T(1):T(-1);
+        }
+
+        for(int ix=0; ix<nx; ix++)
+          for(int iy=0; iy<ny; iy++)
+            for(int iz=0; iz<nz; iz++)
+            {
+              const size_t i=ix*xs+iy*ys+iz*zs;
+              const T* restrict c=coefs+i;
+              const T* restrict c_image=coefs+image_offset(i);
+              for(int n=0; n<ns; n++)
+                if(std::abs(c[n]-sign[n]*c_image[n])>tol*maxabs[n])
+                  return false;
+            }
+        return true;
+      }
+    };
+}
+#endif
@@ -0,0 +1,148 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2018 QMCPACK developers.
+//
+// File developed by: Ye Luo, yeluo@anl.gov, Argonne National Laboratory
+//
+// File created by: Ye Luo, yeluo@anl.gov, Argonne National Laboratory
+//////////////////////////////////////////////////////////////////////////////////////
+// -*- C++ -*-
+/**@file MultiBsplineValueMultiPos.hpp
+ *
+ * evaluate_v_multi_pos_impl computes the values of all the splines at a batch of positions.
+ * Positions falling in the same grid cell share the coefficient loads:
+ * the coefficients are streamed in blocks of MultiPosSplineBlock splines
+ * and every position of the cell consumes a block while it is still in L1.
+ * The streams of the next cell are prefetched while the current cell is processed.
+ * Typical use cases are the quadrature points of NLPP and
+ * the same electron across many walkers.
+ */
+#ifndef SPLINE2_MULTIEINSPLINE_VALUE_MULTIPOS_HPP
+#define SPLINE2_MULTIEINSPLINE_VALUE_MULTIPOS_HPP
+
+namespace spline2
+{
+
+  /// maximal number of positions grouped together
+  constexpr int MultiPosBatchSize=16;
+  /// number of splines per block, multiple of any SIMD alignment
+  constexpr int MultiPosSplineBlock=256;
+
+  /** issue software prefetches to the 16 coefficient streams of a grid cell
+   * @param coefs starting address of the cell, (ix,iy,iz)
+   * @param xs stride in x
+   * @param ys stride in y
+   */
+  template<typename T>
+    inline void prefetch_cell(const T* restrict coefs, intptr_t xs, intptr_t ys)
+    {
+#if defined(__GNUC__)
+      for (int i=0; i<4; i++)
+        for (int j=0; j<4; j++)
+          __builtin_prefetch(coefs+i*xs+j*ys,0,1);
+#endif
+    }
+
+  /** evaluate values at npos positions
+   * @param spline_m multi-bspline, full precision or compressed
+   * @param pos positions in the unit of the spline grid
+   * @param npos number of positions
+   * @param vals output, the values of position ip start at vals+ip*vals_stride
+   * @param vals_stride leading dimension of vals
+   * @param first index of the first spline
+   * @param last index of the last spline (exclusive)
+   */
+  template<typename SPLINET, typename T, typename PT>
+    inline void evaluate_v_multi_pos_impl(const SPLINET *restrict spline_m,
+                                          const PT* restrict pos, int npos,
+                                          T* restrict vals, size_t vals_stride, int first, int last)
+    {
+      using coef_type=typename qmcplusplus::bspline_type<SPLINET>::value_type;
+      const intptr_t xs = spline_m->x_stride;
+      const intptr_t ys = spline_m->y_stride;
+      const intptr_t zs = spline_m->z_stride;
+
+      constexpr T zero(0);
+      const int num_splines=last-first;
+
+      T a[MultiPosBatchSize][4], b[MultiPosBatchSize][4], c[MultiPosBatchSize][4];
+      intptr_t cell[MultiPosBatchSize];
+      int members[MultiPosBatchSize];
+      int group_start[MultiPosBatchSize+1];
+      bool grouped[MultiPosBatchSize];
+
+      for(int ip_first=0; ip_first<npos; ip_first+=MultiPosBatchSize)
+      {
+        const int nb=std::min(MultiPosBatchSize,npos-ip_first);
+
+        for(int ip=0; ip<nb; ip++)
+        {
+          const PT& r=pos[ip_first+ip];
+          T tx,ty,tz;
+          int ix,iy,iz;
+          getSplineBound((r[0]-spline_m->x_grid.start)*spline_m->x_grid.delta_inv,tx,ix,spline_m->x_grid.num-1);
+          getSplineBound((r[1]-spline_m->y_grid.start)*spline_m->y_grid.delta_inv,ty,iy,spline_m->y_grid.num-1);
+          getSplineBound((r[2]-spline_m->z_grid.start)*spline_m->z_grid.delta_inv,tz,iz,spline_m->z_grid.num-1);
+          MultiBsplineData<T>::compute_prefactors(a[ip], tx);
+          MultiBsplineData<T>::compute_prefactors(b[ip], ty);
+          MultiBsplineData<T>::compute_prefactors(c[ip], tz);
+          cell[ip]=ix*xs+iy*ys+iz*zs;
+          grouped[ip]=false;
+          T* restrict v=vals+(ip_first+ip)*vals_stride;
+          std::fill(v,v+num_splines,zero);
+        }
+
+        // group the positions sharing the same cell
+        int ngroups=0, nm=0;
+        for(int ip=0; ip<nb; ip++)
+        {
+          if(grouped[ip]) continue;
+          group_start[ngroups++]=nm;
+          for(int jp=ip; jp<nb; jp++)
+            if(!grouped[jp] && cell[jp]==cell[ip])
+            {
+              members[nm++]=jp;
+              grouped[jp]=true;
+            }
+        }
+        group_start[ngroups]=nm;
+
+        for(int ig=0; ig<ngroups; ig++)
+        {
+          const coef_type* restrict cell_coefs=spline_m->coefs+cell[members[group_start[ig]]]+first;
+          if(ig+1<ngroups)
+            prefetch_cell(spline_m->coefs+cell[members[group_start[ig+1]]]+first,xs,ys);
+
+          for (int i=0; i<4; i++)
+            for (int j=0; j<4; j++)
+            {
+              const coef_type* restrict coefs = cell_coefs + i*xs + j*ys;
+              const coef_type* restrict coefszs  = coefs+zs;
+              const coef_type* restrict coefs2zs = coefs+2*zs;
+              const coef_type* restrict coefs3zs = coefs+3*zs;
+              for(int n_first=0; n_first<num_splines; n_first+=MultiPosSplineBlock)
+              {
+                const int n_last=std::min(n_first+MultiPosSplineBlock,num_splines);
+                for(int im=group_start[ig]; im<group_start[ig+1]; im++)
+                {
+                  const int ip=members[im];
+                  const T pre00 = a[ip][i]*b[ip][j];
+                  const T c0=c[ip][0], c1=c[ip][1], c2=c[ip][2], c3=c[ip][3];
+                  T* restrict v=vals+(ip_first+ip)*vals_stride;
+                  #pragma omp simd aligned(v)
+                  for(int n=n_first; n<n_last; n++)
+                    v[n] += pre00*(c0*T(coefs[n]) + c1*T(coefszs[n]) + c2*T(coefs2zs[n]) + c3*T(coefs3zs[n]));
+                }
+              }
+            }
+        }
+
+        for(int ip=0; ip<nb; ip++)
+          apply_spline_scales(spline_m,vals+(ip_first+ip)*vals_stride,first,last);
+      }
+    }
+
+}
+#endif
@@ -39,7 +39,7 @@ namespace qmcplusplus { namespace einspline {
     template<typename SplineType>
     void destroy(SplineType* spline)
     {
-      einspline_free(spline->coefs);
+      if(spline->coefs!=nullptr) einspline_free(spline->coefs);
       free(spline);
     }
 
@@ -14,6 +14,7 @@
 #include "catch.hpp"
 
 #include <OhmmsSoA/Container.h>
+#include <OhmmsPETE/OhmmsMatrix.h>
 #include "spline2/MultiBspline.hpp"
 #include "spline2/MultiBsplineEval.hpp"
 
@@ -239,7 +240,39 @@ void test_splines()
   // Laplacian
   REQUIRE(lap[0][0] == Approx(    147.1127789));
 
+  // multiple positions, the first two in the same cell
+  std::vector<TinyVector<T,3> > pos_list = { {0.1, 0.2, 0.3}, {0.15, 0.25, 0.35}, {0.0, 0.0, 0.0}, {0.7, 0.5, 0.9} };
+  Matrix<T,aligned_allocator<T> > multi_v(pos_list.size(), npad);
+  spline2::evaluate3d_multi_pos(bs.spline_m, pos_list, multi_v, 0, npad);
+  for (int ip = 0; ip < pos_list.size(); ip++)
+  {
+    spline2::evaluate3d(bs.spline_m, pos_list[ip], v);
+    REQUIRE(multi_v[ip][0] == Approx(v[0]));
+  }
+  REQUIRE(multi_v[0][0] == Approx(  -0.9476393279));
+
+  // 16-bit compressed table
+  MultiBsplineCompressed<T> bs_c(bs.spline_m);
+  REQUIRE(spline2::compression_error(bs.spline_m, &bs_c) < 1.0e-4);
+
+  spline2::evaluate3d(&bs_c, pos, v);
+  REQUIRE(v[0] == Approx(  -0.9476393279).epsilon(1.0e-3));
+
+  spline2::evaluate3d_vgl(&bs_c, pos, v, dv, lap);
+  REQUIRE(v[0] == Approx(  -0.9476393279).epsilon(1.0e-3));
+  REQUIRE(dv[0][0] == Approx(    5.111042137).epsilon(1.0e-3));
+  REQUIRE(lap[0][0] == Approx(    147.1127789).epsilon(1.0e-3));
 
+  spline2::evaluate3d_vgh(&bs_c, pos, v, dv, hess);
+  REQUIRE(dv[0][1] == Approx(    5.989106342).epsilon(1.0e-3));
+  REQUIRE(hess[0][3] == Approx(    133.9204891).epsilon(1.0e-3));
+
+  Matrix<T,aligned_allocator<T> > multi_v_c(pos_list.size(), npad);
+  spline2::evaluate3d_multi_pos(&bs_c, pos_list, multi_v_c, 0, npad);
+  for (int ip = 0; ip < pos_list.size(); ip++)
+    REQUIRE(multi_v_c[ip][0] == Approx(multi_v[ip][0]).epsilon(1.0e-3));
+
+  REQUIRE(bs_c.sizeInByte() < bs.sizeInByte());
 }
 
 TEST_CASE("MultiBspline periodic double","[spline2]")
@@ -251,4 +284,97 @@ TEST_CASE("MultiBspline periodic float","[spline2]")
 {
   test_splines<float>();
 }
+template<typename T>
+void test_symmetry_reduction()
+{
+  const int N = 8;
+  const int num_splines = 2;
+  const int npad = getAlignedSize<T>(num_splines);
+  BCtype_d bc[3];
+  Ugrid grid[3];
+  for (int d = 0; d < 3; d++)
+  {
+    grid[d].start = 0.0;
+    grid[d].end = 1.0;
+    grid[d].num = N;
+    bc[d].lCode = PERIODIC;
+    bc[d].rCode = PERIODIC;
+    bc[d].lVal = 0.0;
+    bc[d].rVal = 0.0;
+  }
+
+  // spline 0 is even or odd under all the sign flips of (x,y,z)
+  // spline 1 is only symmetric under z -> -z, (x,y) -> -(x,y) and the inversion
+  const double tpi = 2*M_PI;
+  std::vector<T> data0(N*N*N), data1(N*N*N);
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++)
+      for (int k = 0; k < N; k++)
+      {
+        double x = double(i)/N;
+        double y = double(j)/N;
+        double z = double(k)/N;
+        data0[i*N*N+j*N+k] = std::cos(tpi*x)*std::sin(tpi*y)*std::cos(2*tpi*z);
+        data1[i*N*N+j*N+k] = std::sin(tpi*(x+y))*std::cos(tpi*z);
+      }
+
+  MultiBspline<T> bs_full, bs;
+  bs_full.create(grid, bc, npad);
+  bs.create(grid, bc, npad);
+  bs_full.flush_zero();
+  bs.flush_zero();
+  bs_full.set(0, data0);
+  bs_full.set(1, data1);
+  bs.set(0, data0);
+  bs.set(1, data1);
+
+  TinyVector<T,3> u = {0.7, 0.7, 0.7};
+  REQUIRE(bs.fold(u) == 0);
+  REQUIRE(bs.reduce_symmetry(1.0e-5) == 4);
+  // two directions keep 8/2+1 of the 8 grid cells
+  REQUIRE(bs.sizeInByte() < bs_full.sizeInByte()*3/5);
+
+  std::vector<TinyVector<T,3> > pos_list = { {0.1, 0.7, 0.3}, {0.8, 0.6, 0.9}, {0.55, 0.2, 0.95}, {0.3, 0.3, 0.6}, {0.5, 0.0, 0.75} };
+  aligned_vector<T> v(npad), v_full(npad);
+  VectorSoaContainer<T,3> dv(npad), dv_full(npad);
+  VectorSoaContainer<T,6> hess(npad), hess_full(npad);
+  for (int ip = 0; ip < pos_list.size(); ip++)
+  {
+    TinyVector<T,3> ru = pos_list[ip];
+    int ops = bs.fold(ru);
+    for (int d = 0; d < 3; d++)
+    {
+      REQUIRE(ru[d] >= 0);
+      REQUIRE(ru[d] < 1);
+    }
+
+    spline2::evaluate3d(bs.spline_m, ru, v);
+    bs.symmetry->unfold_v(ops, v, 0, npad);
+    spline2::evaluate3d(bs_full.spline_m, pos_list[ip], v_full);
+    for (int n = 0; n < num_splines; n++)
+      REQUIRE(v[n] == Approx(v_full[n]).epsilon(1.0e-4).margin(1.0e-4));
+
+    spline2::evaluate3d_vgh(bs.spline_m, ru, v, dv, hess);
+    bs.symmetry->unfold_vgh(ops, v, dv, hess, 0, npad);
+    spline2::evaluate3d_vgh(bs_full.spline_m, pos_list[ip], v_full, dv_full, hess_full);
+    for (int n = 0; n < num_splines; n++)
+    {
+      REQUIRE(v[n] == Approx(v_full[n]).epsilon(1.0e-4).margin(1.0e-4));
+      for (int d = 0; d < 3; d++)
+        REQUIRE(dv[n][d] == Approx(dv_full[n][d]).epsilon(1.0e-4).margin(1.0e-3));
+      for (int c = 0; c < 6; c++)
+        REQUIRE(hess[n][c] == Approx(hess_full[n][c]).epsilon(1.0e-4).margin(1.0e-2));
+    }
+  }
+}
+
+TEST_CASE("MultiBspline symmetry reduction double","[spline2]")
+{
+  test_symmetry_reduction<double>();
+}
+
+TEST_CASE("MultiBspline symmetry reduction float","[spline2]")
+{
+  test_symmetry_reduction<float>();
+}
 }